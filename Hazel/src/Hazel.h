@@ -7,6 +7,7 @@
 #include "Hazel/Core/Application.h"
 #include "Hazel/Core/Layer.h"
 #include "Hazel/Core/Log.h"
+#include "Hazel/Core/JobSystem.h"
 
 #include "Hazel/Core/Timestep.h"
 
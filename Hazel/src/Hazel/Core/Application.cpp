@@ -1,24 +1,70 @@
 #include "hzpch.h"
 #include "Application.h"
 
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/Input.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Debug/AllocationCounter.h"
+#include "Hazel/Debug/FrameMetrics.h"
+#include "Hazel/Debug/InputRecorder.h"
+#include "Hazel/Debug/MemoryTracker.h"
 #include "Hazel/Renderer/Renderer.h"
+#include "Hazel/Renderer/Renderer2D.h"
+#include "Hazel/Utils/PlatformUtils.h"
 
-#include <GLFW/glfw3.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 namespace Hazel {
 
 	Application* Application::s_Instance = nullptr;
 
-	Application::Application(const std::string& name)
+	Application::Application(const ApplicationSpecification& specification)
+		: m_Specification(specification)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		HZ_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
 
-		m_Window = Window::Create(WindowProps(name));
-		m_Window->SetEventCallback(HZ_BIND_EVENT_FN(Application::OnEvent));
+		const ApplicationCommandLineArgs& args = m_Specification.CommandLineArgs;
+		for (int i = 1; i < args.Count; i++)
+		{
+			if (strcmp(args[i], "--headless") == 0)
+				m_Specification.Headless = true;
+			else if (strcmp(args[i], "--render-thread") == 0)
+				m_Specification.ThreadPolicy = RenderThreadPolicy::MultiThreaded;
+			else if (strcmp(args[i], "--frames") == 0 && i + 1 < args.Count)
+				m_Specification.FrameCount = (uint32_t)std::max(atoi(args[++i]), 0);
+			else if (strcmp(args[i], "--timestep") == 0 && i + 1 < args.Count)
+				m_Specification.FixedTimestep = (float)atof(args[++i]) / 1000.0f;
+			else if (strcmp(args[i], "--fixed-step") == 0 && i + 1 < args.Count)
+				m_Specification.FixedUpdateStep = (float)std::max(atof(args[++i]), 0.0) / 1000.0f;
+			else if (strcmp(args[i], "--max-fixed-updates") == 0 && i + 1 < args.Count)
+				m_Specification.MaxFixedUpdates = (uint32_t)std::max(atoi(args[++i]), 1);
+		}
+
+		JobSystem::Init();
+
+		if (m_Specification.Headless)
+		{
+			// Without a render thread the renderer executes its commands as they are submitted,
+			// on the null backend that is next to nothing
+			RendererAPI::SetAPI(RendererAPI::API::None);
+			Renderer::Init();
+
+			if (m_Specification.FrameCount)
+				HZ_CORE_INFO("Running headless for {0} frames", m_Specification.FrameCount);
+			else
+				HZ_CORE_INFO("Running headless");
+			return;
+		}
+
+		m_Window = Window::Create(WindowProps(m_Specification.Name));
+		m_Window->SetEventQueue(&m_EventQueue);
 
+		RenderThread::Init(m_Window->GetGraphicsContext(), m_Specification.ThreadPolicy);
 		Renderer::Init();
 
 		m_ImGuiLayer = new ImGuiLayer();
@@ -30,6 +76,8 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		Renderer::Shutdown();
+		RenderThread::Shutdown();
+		JobSystem::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -57,30 +105,70 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
+		if (InputRecorder::OnEvent(e))
+			return;
+		// Before the layers, a layer handling the event doesn't hide it from Input
+		Input::OnEvent(e);
+
 		EventDispatcher dispatcher(e);
 		dispatcher.Dispatch<WindowCloseEvent>(HZ_BIND_EVENT_FN(Application::OnWindowClosed));
 		dispatcher.Dispatch<WindowResizeEvent>(HZ_BIND_EVENT_FN(Application::OnWindowResize));
 
-		for (auto it = m_LayerStack.end(); it != m_LayerStack.begin(); )
-		{
-			if (e.Handled)
-				break;
-			(*--it)->OnEvent(e);
-		}
+		m_LayerStack.Dispatch(e);
 	}
 
 	void Application::Run()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		m_LastFrameTime = (float)glfwGetTime();
+		// Everything recorded during startup goes out as frame 0, so its frame memory
+		// is consumed before the first buffer gets reused
+		if (RenderThread::IsInitialized())
+			RenderThread::NextFrame();
+
+		uint32_t frame = 0;
+		m_LastFrameTime = Time::GetTimeNanoseconds();
 		while (m_Running)
 		{
+			HZ_PROFILE_MARK_FRAME();
 			HZ_PROFILE_SCOPE("Run Loop");
 
-			float time = (float)glfwGetTime(); // should be in platform - Platform::GetTime()
-			Timestep timestep = time - m_LastFrameTime;
+			FrameAllocator::NextFrame();
+			AllocationCounter::NextFrame();
+			MemoryTracker::NextFrame();
+
+			uint64_t time = Time::GetTimeNanoseconds();
+			Timestep timestep = (float)((double)(time - m_LastFrameTime) * 1e-9);
 			m_LastFrameTime = time;
+			if (m_Specification.Headless && m_Specification.FixedTimestep > 0.0f)
+				timestep = m_Specification.FixedTimestep;
+			timestep = InputRecorder::NextFrame(timestep);
+			Input::NextFrame();
+
+			// Layers usually reset these themselves, this covers the ones that don't
+			Renderer2D::ResetStats();
+
+			auto updateStart = std::chrono::steady_clock::now();
+
+			// The simulation keeps going while minimized, it is only the rendering that stops
+			if (m_Specification.FixedUpdateStep > 0.0f)
+			{
+				HZ_PROFILE_SCOPE("Layers OnFixedUpdate");
+
+				const double step = m_Specification.FixedUpdateStep;
+				m_FixedUpdateAccumulator += timestep;
+				for (uint32_t i = 0; i < m_Specification.MaxFixedUpdates && m_FixedUpdateAccumulator >= step; i++)
+				{
+					for (Layer* layer : m_LayerStack)
+						layer->OnFixedUpdate(m_Specification.FixedUpdateStep);
+					m_FixedUpdateAccumulator -= step;
+				}
+
+				// Too far behind to catch up, what's left over is dropped
+				if (m_FixedUpdateAccumulator >= step)
+					m_FixedUpdateAccumulator = std::fmod(m_FixedUpdateAccumulator, step);
+				m_FixedUpdateAlpha = (float)(m_FixedUpdateAccumulator / step);
+			}
 
 			// Will stop application from running if minimized
 			// Should just stop rendering
@@ -91,16 +179,51 @@ namespace Hazel {
 				for (Layer* layer : m_LayerStack)
 					layer->OnUpdate(timestep);
 			}
+			double updateTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+			if (!m_Specification.Headless)
 			{
-				HZ_PROFILE_SCOPE("Layers OnImGuiRender");
+				{
+					HZ_PROFILE_SCOPE("Layers OnImGuiRender");
 
-				m_ImGuiLayer->Begin();
-				for (Layer* layer : m_LayerStack)
-					layer->OnImGuiRender();
-				m_ImGuiLayer->End();
+					m_ImGuiLayer->Begin();
+					for (Layer* layer : m_LayerStack)
+						layer->OnImGuiRender();
+					m_ImGuiLayer->End();
+				}
+
+				m_Window->OnUpdate();
 			}
 
-			m_Window->OnUpdate();
+			// Everything the window received while polling, in one pass
+			m_EventQueue.Dispatch(HZ_BIND_EVENT_FN(Application::OnEvent));
+
+			// A replay's events arrive where the window's would have
+			InputRecorder::DispatchEvents(HZ_BIND_EVENT_FN(Application::OnEvent));
+			if (InputRecorder::IsReplayFinished())
+				m_Running = false;
+
+			if (FrameMetrics::IsSessionActive())
+			{
+				auto renderer2DStats = Renderer2D::GetStats();
+
+				FrameMetricsSample sample;
+				sample[(size_t)FrameMetric::FrameTime] = timestep.GetMilliseconds();
+				sample[(size_t)FrameMetric::UpdateTime] = updateTime;
+				// With a render thread this is the previous frame, the one it executed while we recorded this one
+				sample[(size_t)FrameMetric::RenderTime] = RenderThread::GetStats().RenderThreadBusyTime;
+				sample[(size_t)FrameMetric::DrawCalls] = renderer2DStats.DrawCalls;
+				sample[(size_t)FrameMetric::QuadCount] = renderer2DStats.QuadCount;
+				sample[(size_t)FrameMetric::UploadedBytes] = (double)renderer2DStats.UploadedBytes;
+				sample[(size_t)FrameMetric::Allocations] = AllocationCounter::GetFrameAllocations();
+				FrameMetrics::RecordFrame(sample);
+			}
+
+			// The render thread executes this frame while we record the next one
+			if (RenderThread::IsInitialized())
+				RenderThread::NextFrame();
+
+			if (++frame == m_Specification.FrameCount)
+				m_Running = false;
 		}
 	}
 
@@ -6,17 +6,58 @@
 #include "Hazel/Core/LayerStack.h"
 #include "Hazel/Events/Event.h"
 #include "Hazel/Events/ApplicationEvent.h"
+#include "Hazel/Events/EventQueue.h"
 
 #include "Hazel/Core/Timestep.h"
 
+#include "Hazel/Renderer/RenderThread.h"
+
 #include "Hazel/ImGui/ImGuiLayer.h"
 
 namespace Hazel {
 
+	struct ApplicationCommandLineArgs
+	{
+		int Count = 0;
+		char** Args = nullptr;
+
+		const char* operator[](int index) const
+		{
+			HZ_CORE_ASSERT(index < Count, "Command line argument out of range!");
+			return Args[index];
+		}
+	};
+
+	struct ApplicationSpecification
+	{
+		std::string Name = "Hazel App";
+		// Single-threaded until ImGui's platform windows can render on the render thread, multi-viewports
+		// are turned off without it. Also --render-thread.
+		RenderThreadPolicy ThreadPolicy = RenderThreadPolicy::SingleThreaded;
+		ApplicationCommandLineArgs CommandLineArgs;
+
+		// No window, no ImGui and no GPU, the renderer runs on RendererAPI::None. For simulation
+		// servers and benchmark machines. Also selected with --headless.
+		bool Headless = false;
+		// Headless: stops after this many frames, 0 runs until Close(). Also --frames <count>.
+		uint32_t FrameCount = 0;
+		// Headless: seconds every frame steps, 0 runs as fast as it can with the measured time.
+		// Also --timestep <milliseconds>.
+		float FixedTimestep = 0.0f;
+
+		// Seconds of simulation per fixed update: layers get OnFixedUpdate as many times as the
+		// elapsed time fits, before OnUpdate. 0 turns fixed updates off. Also --fixed-step <milliseconds>.
+		float FixedUpdateStep = 1.0f / 60.0f;
+		// The most fixed updates a frame catches up with. A frame that fell further behind drops
+		// the rest, the simulation slows down instead of every frame falling further behind.
+		// Also --max-fixed-updates <count>.
+		uint32_t MaxFixedUpdates = 8;
+	};
+
 	class Application
 	{
 	public:
-		Application(const std::string& name = "Hazel App");
+		Application(const ApplicationSpecification& specification);
 		virtual ~Application();
 
 		void Run();
@@ -26,28 +67,44 @@ namespace Hazel {
 		void PushLayer(Layer* layer);
 		void PushOverlay(Layer* overlay);
 
+		// Not when headless
 		inline Window& GetWindow() const { return *m_Window; }
+		bool IsHeadless() const { return m_Specification.Headless; }
 
 		void Close();
 
+		// Null when headless
 		ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; }
 
+		// Dispatched once a frame, after the window polled its events
+		EventQueue& GetEventQueue() { return m_EventQueue; }
+
+		const ApplicationSpecification& GetSpecification() const { return m_Specification; }
+
+		// How far this frame is from the last fixed update towards the next one, in [0, 1).
+		// Rendering blends the last two fixed updates by it. 1 without fixed updates.
+		float GetFixedUpdateAlpha() const { return m_FixedUpdateAlpha; }
+
 		inline static Application& Get() { return *s_Instance; }
 	private:
 		bool OnWindowClosed(WindowCloseEvent& e);
 		bool OnWindowResize(WindowResizeEvent& e);
 	private:
+		ApplicationSpecification m_Specification;
 		Scope<Window> m_Window;
-		ImGuiLayer* m_ImGuiLayer;
+		EventQueue m_EventQueue;
+		ImGuiLayer* m_ImGuiLayer = nullptr;
 		bool m_Running = true;
 		bool m_Minimized = false;
 		LayerStack m_LayerStack;
-		float m_LastFrameTime = 0;
+		uint64_t m_LastFrameTime = 0; // Nanoseconds
+		double m_FixedUpdateAccumulator = 0.0;
+		float m_FixedUpdateAlpha = 1.0f;
 	private:
 		static Application* s_Instance;
 	};
 
 	// To be defined in CLIENT
-	Application* CreateApplication();
+	Application* CreateApplication(ApplicationCommandLineArgs args);
 
 }
\ No newline at end of file
@@ -35,15 +35,9 @@ namespace Hazel {
 		return std::make_unique<T>(std::forward<Args>(args)...);
 	}
 
-	template<typename T>
-	using Ref = std::shared_ptr<T>;
-	template<typename T, typename ... Args>
-	constexpr Ref<T> CreateRef(Args&& ... args)
-	{
-		return std::make_shared<T>(std::forward<Args>(args)...);
-	}
-
 }
 
+#include "Hazel/Core/Ref.h"
+
 #include "Hazel/Core/Log.h"
 #include "Hazel/Core/Assert.h"
\ No newline at end of file
@@ -1,24 +1,66 @@
 #pragma once
 
+#include "Hazel/Debug/FrameMetrics.h"
+#include "Hazel/Debug/InputRecorder.h"
+
+#include <cstdlib>
+#include <cstring>
+
 #ifdef HZ_PLATFORM_WINDOWS
 
-extern Hazel::Application* Hazel::CreateApplication();
+extern Hazel::Application* Hazel::CreateApplication(Hazel::ApplicationCommandLineArgs args);
 
 int main(int argc, char** argv)
 {
 	Hazel::Log::Init();
 
+	// Automated performance runs pass --frame-metrics <file prefix>, and to make the frames
+	// repeatable --record-input <file> once, then --replay-input <file> with an optional
+	// --replay-timestep <milliseconds>. Application itself reads --headless, --frames <count>
+	// and --timestep <milliseconds>.
+	const char* frameMetricsPrefix = nullptr;
+	const char* recordInputPath = nullptr;
+	const char* replayInputPath = nullptr;
+	float replayTimestep = 0.0f;
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "--frame-metrics") == 0)
+			frameMetricsPrefix = argv[i + 1];
+		else if (strcmp(argv[i], "--record-input") == 0)
+			recordInputPath = argv[i + 1];
+		else if (strcmp(argv[i], "--replay-input") == 0)
+			replayInputPath = argv[i + 1];
+		else if (strcmp(argv[i], "--replay-timestep") == 0)
+			replayTimestep = (float)atof(argv[i + 1]) / 1000.0f;
+	}
+
 	HZ_PROFILE_BEGIN_SESSION("Startup", "HazelProfile-Startup.json");
-	auto app = Hazel::CreateApplication();
+	auto app = Hazel::CreateApplication({ argc, argv });
 	HZ_PROFILE_END_SESSION();
 
+#if HZ_PROFILE_FLIGHT_RECORDER
+	HZ_PROFILE_BEGIN_FLIGHT_RECORDER("Runtime", Hazel::FlightRecorderSpecification());
+#else
 	HZ_PROFILE_BEGIN_SESSION("Runtime", "HazelProfile-Runtime.json");
+#endif
+	if (frameMetricsPrefix)
+		Hazel::FrameMetrics::BeginSession("Runtime");
+	if (replayInputPath)
+		Hazel::InputRecorder::BeginReplay(replayInputPath, replayTimestep);
+	else if (recordInputPath)
+		Hazel::InputRecorder::BeginRecording(recordInputPath);
 	app->Run();
+	Hazel::InputRecorder::EndReplay();
+	Hazel::InputRecorder::EndRecording();
+	if (frameMetricsPrefix)
+		Hazel::FrameMetrics::EndSession(frameMetricsPrefix);
 	HZ_PROFILE_END_SESSION();
 
 	HZ_PROFILE_BEGIN_SESSION("Shutdown", "HazelProfile-Shutdown.json");
 	delete app;
 	HZ_PROFILE_END_SESSION();
+
+	Hazel::Log::Shutdown();
 }
 
 #endif
\ No newline at end of file
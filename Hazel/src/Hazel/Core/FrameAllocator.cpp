@@ -0,0 +1,116 @@
+#include "hzpch.h"
+#include "FrameAllocator.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace Hazel {
+
+	struct FrameArena
+	{
+		uint8_t* Data = nullptr;
+		std::atomic<size_t> Offset{ 0 };
+		std::atomic<uint32_t> AllocationCount{ 0 };
+		std::atomic<size_t> OverflowBytes{ 0 };
+
+		std::mutex OverflowMutex;
+		std::vector<std::pair<void*, size_t>> Overflow; // Pointer and alignment
+
+		FrameArena()
+		{
+			HZ_MEMORY_SCOPE("FrameAllocator");
+			Data = (uint8_t*)::operator new(FrameAllocator::Capacity, std::align_val_t(alignof(std::max_align_t)));
+		}
+
+		void Reset()
+		{
+			{
+				std::lock_guard<std::mutex> lock(OverflowMutex);
+				for (auto [memory, alignment] : Overflow)
+					::operator delete(memory, std::align_val_t(alignment));
+				Overflow.clear();
+			}
+
+			Offset.store(0, std::memory_order_relaxed);
+			AllocationCount.store(0, std::memory_order_relaxed);
+			OverflowBytes.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	struct FrameAllocatorData
+	{
+		std::array<FrameArena, 2> Arenas;
+		std::atomic<uint32_t> CurrentArena{ 0 };
+
+		FrameAllocator::Statistics Stats;
+	};
+
+	// Intentionally never destroyed, profile scopes still allocate during static destruction
+	static FrameAllocatorData& GetData()
+	{
+		static FrameAllocatorData* data = new FrameAllocatorData();
+		return *data;
+	}
+
+	void FrameAllocator::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		FrameAllocatorData& data = GetData();
+		FrameArena& finished = data.Arenas[data.CurrentArena.load(std::memory_order_relaxed)];
+		data.Stats.UsedBytes = std::min(finished.Offset.load(std::memory_order_relaxed), Capacity);
+		data.Stats.OverflowBytes = finished.OverflowBytes.load(std::memory_order_relaxed);
+		data.Stats.AllocationCount = finished.AllocationCount.load(std::memory_order_relaxed);
+
+		// The other arena was last used two frames ago, nothing refers to it anymore
+		uint32_t next = (data.CurrentArena.load(std::memory_order_relaxed) + 1) % 2;
+		data.Arenas[next].Reset();
+		data.CurrentArena.store(next, std::memory_order_release);
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		FrameAllocatorData& data = GetData();
+		FrameArena& arena = data.Arenas[data.CurrentArena.load(std::memory_order_acquire)];
+		arena.AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		size_t offset = arena.Offset.load(std::memory_order_relaxed);
+		while (true)
+		{
+			uintptr_t address = (uintptr_t)(arena.Data + offset);
+			address = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+			size_t end = (size_t)(address - (uintptr_t)arena.Data) + size;
+			if (end > Capacity)
+				break;
+
+			// Only bump on success, so one oversized request doesn't spill the rest of the frame
+			if (arena.Offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+				return (void*)address;
+		}
+
+		// Out of space for this frame
+		HZ_MEMORY_SCOPE("FrameAllocator");
+		alignment = std::max(alignment, alignof(std::max_align_t));
+		void* memory = ::operator new(size, std::align_val_t(alignment));
+		arena.OverflowBytes.fetch_add(size, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(arena.OverflowMutex);
+		arena.Overflow.emplace_back(memory, alignment);
+		return memory;
+	}
+
+	const char* FrameAllocator::CopyString(std::string_view str)
+	{
+		char* copy = (char*)Allocate(str.size() + 1, 1);
+		memcpy(copy, str.data(), str.size());
+		copy[str.size()] = '\0';
+		return copy;
+	}
+
+	FrameAllocator::Statistics FrameAllocator::GetStats()
+	{
+		return GetData().Stats;
+	}
+
+}
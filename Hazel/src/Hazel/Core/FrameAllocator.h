@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Hazel {
+
+	// Double-buffered bump arena for data that only lives for the current frame.
+	// Allocations are never freed individually; Application resets the buffer at the
+	// top of every frame and alternates between two of them, so memory allocated in
+	// frame N stays valid until frame N + 2 begins (long enough for the render thread
+	// to consume what frame N recorded). Allocate may be called from any thread.
+	// Requests that don't fit fall back to the heap and are released on reset.
+	class FrameAllocator
+	{
+	public:
+		static constexpr size_t Capacity = 4 * 1024 * 1024; // Per buffer
+
+		// Switches to the other buffer and resets it
+		static void NextFrame();
+
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// No destructor is ever called, so only trivially destructible types
+		template<typename T, typename... Args>
+		static T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Frame allocations are never destroyed!");
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		// Null-terminated copy of str
+		static const char* CopyString(std::string_view str);
+
+		struct Statistics
+		{
+			size_t UsedBytes = 0;     // Bump allocated during the last frame
+			size_t OverflowBytes = 0; // Didn't fit and went to the heap instead
+			uint32_t AllocationCount = 0;
+		};
+		static Statistics GetStats();
+	};
+
+	// Lets STL containers use the frame allocator: FrameVector<int>, FrameString, ...
+	template<typename T>
+	class FrameAllocatorAdaptor
+	{
+	public:
+		using value_type = T;
+
+		FrameAllocatorAdaptor() noexcept = default;
+		template<typename U>
+		FrameAllocatorAdaptor(const FrameAllocatorAdaptor<U>&) noexcept {}
+
+		T* allocate(size_t count) { return (T*)FrameAllocator::Allocate(count * sizeof(T), alignof(T)); }
+		void deallocate(T*, size_t) noexcept {}
+
+		template<typename U>
+		bool operator==(const FrameAllocatorAdaptor<U>&) const noexcept { return true; }
+		template<typename U>
+		bool operator!=(const FrameAllocatorAdaptor<U>&) const noexcept { return false; }
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocatorAdaptor<T>>;
+
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocatorAdaptor<char>>;
+
+}
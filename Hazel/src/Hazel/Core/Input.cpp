@@ -0,0 +1,175 @@
+#include "hzpch.h"
+#include "Input.h"
+
+#include "Hazel/Events/KeyEvent.h"
+#include "Hazel/Events/MouseEvent.h"
+
+#include <atomic>
+#include <bitset>
+
+namespace Hazel {
+
+	static constexpr size_t KeyCount = (size_t)Key::Menu + 1;
+	static constexpr size_t MouseButtonCount = (size_t)Mouse::ButtonLast + 1;
+
+	struct InputState
+	{
+		std::bitset<KeyCount> Keys;
+		std::bitset<KeyCount> KeysPressed;
+		std::bitset<KeyCount> KeysReleased;
+
+		std::bitset<MouseButtonCount> MouseButtons;
+		std::bitset<MouseButtonCount> MouseButtonsPressed;
+		std::bitset<MouseButtonCount> MouseButtonsReleased;
+
+		float MouseX = 0.0f, MouseY = 0.0f;
+		float MouseDeltaX = 0.0f, MouseDeltaY = 0.0f;
+	};
+
+	struct InputData
+	{
+		// Up to the last event, main thread only. Its edges collect until the next frame.
+		InputState Live;
+
+		// Published in turns, the other one is written while workers may still read this frame's
+		InputState Frames[2];
+		std::atomic<uint32_t> FrameIndex{ 0 };
+	};
+
+	static InputData s_Data;
+
+	// Set on the thread that dispatches the events, it may read Live
+	static thread_local bool s_IsEventThread = false;
+
+	static const InputState& GetFrameState()
+	{
+		return s_Data.Frames[s_Data.FrameIndex.load(std::memory_order_acquire)];
+	}
+
+	static const InputState& GetLevelState()
+	{
+		return s_IsEventThread ? s_Data.Live : GetFrameState();
+	}
+
+	template<size_t N>
+	static void SetButton(std::bitset<N>& down, std::bitset<N>& pressed, std::bitset<N>& released, size_t code, bool isDown)
+	{
+		// Unknown keys and buttons beyond the last one are not tracked
+		if (code >= N || down[code] == isDown)
+			return;
+
+		down[code] = isDown;
+		if (isDown)
+			pressed[code] = true;
+		else
+			released[code] = true;
+	}
+
+	bool Input::IsKeyPressed(KeyCode key)
+	{
+		return key < KeyCount && GetLevelState().Keys[key];
+	}
+
+	bool Input::WasKeyPressed(KeyCode key)
+	{
+		return key < KeyCount && GetFrameState().KeysPressed[key];
+	}
+
+	bool Input::WasKeyReleased(KeyCode key)
+	{
+		return key < KeyCount && GetFrameState().KeysReleased[key];
+	}
+
+	bool Input::IsMouseButtonPressed(MouseCode button)
+	{
+		return button < MouseButtonCount && GetLevelState().MouseButtons[button];
+	}
+
+	bool Input::WasMouseButtonPressed(MouseCode button)
+	{
+		return button < MouseButtonCount && GetFrameState().MouseButtonsPressed[button];
+	}
+
+	bool Input::WasMouseButtonReleased(MouseCode button)
+	{
+		return button < MouseButtonCount && GetFrameState().MouseButtonsReleased[button];
+	}
+
+	std::pair<float, float> Input::GetMousePosition()
+	{
+		const InputState& state = GetLevelState();
+		return { state.MouseX, state.MouseY };
+	}
+
+	std::pair<float, float> Input::GetMouseDelta()
+	{
+		const InputState& state = GetFrameState();
+		return { state.MouseDeltaX, state.MouseDeltaY };
+	}
+
+	float Input::GetMouseX()
+	{
+		auto [x, y] = GetMousePosition();
+		return x;
+	}
+
+	float Input::GetMouseY()
+	{
+		auto [x, y] = GetMousePosition();
+		return y;
+	}
+
+	void Input::OnEvent(Event& e)
+	{
+		s_IsEventThread = true;
+
+		InputState& live = s_Data.Live;
+		switch (e.GetEventType())
+		{
+			case EventType::KeyPressed:
+				SetButton(live.Keys, live.KeysPressed, live.KeysReleased, static_cast<KeyEvent&>(e).GetKeyCode(), true);
+				break;
+			case EventType::KeyReleased:
+				SetButton(live.Keys, live.KeysPressed, live.KeysReleased, static_cast<KeyEvent&>(e).GetKeyCode(), false);
+				break;
+			case EventType::MouseButtonPressed:
+				SetButton(live.MouseButtons, live.MouseButtonsPressed, live.MouseButtonsReleased, static_cast<MouseButtonEvent&>(e).GetMouseButton(), true);
+				break;
+			case EventType::MouseButtonReleased:
+				SetButton(live.MouseButtons, live.MouseButtonsPressed, live.MouseButtonsReleased, static_cast<MouseButtonEvent&>(e).GetMouseButton(), false);
+				break;
+			case EventType::MouseMoved:
+			{
+				auto& event = static_cast<MouseMovedEvent&>(e);
+				live.MouseX = event.GetX();
+				live.MouseY = event.GetY();
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	void Input::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		s_IsEventThread = true;
+
+		uint32_t index = s_Data.FrameIndex.load(std::memory_order_relaxed);
+		const InputState& previous = s_Data.Frames[index];
+		InputState& next = s_Data.Frames[index ^ 1];
+
+		InputState& live = s_Data.Live;
+		next = live;
+		next.MouseDeltaX = live.MouseX - previous.MouseX;
+		next.MouseDeltaY = live.MouseY - previous.MouseY;
+		s_Data.FrameIndex.store(index ^ 1, std::memory_order_release);
+
+		live.KeysPressed.reset();
+		live.KeysReleased.reset();
+		live.MouseButtonsPressed.reset();
+		live.MouseButtonsReleased.reset();
+	}
+
+}
@@ -3,18 +3,39 @@
 #include "Hazel/Core/Core.h"
 #include "Hazel/Core/MouseCodes.h"
 #include "Hazel/Core/KeyCodes.h"
+#include "Hazel/Events/Event.h"
 
 namespace Hazel {
 
+	// Answers from Hazel's own copy of the input state instead of asking the platform. The state
+	// follows the input events Application receives and is published once a frame, before the
+	// layers update, so every query in a frame gets the same answer and costs a bit test.
+	//
+	// The main thread, which dispatches the events, sees a key or button change as soon as its
+	// event went out, like the platform's state would. Other threads, such as job workers, read
+	// the frame's snapshot; it stays valid until the frame after next is published. Presses,
+	// releases and the mouse delta always describe the frame: what happened since the previous one.
 	class Input
 	{
 	public:
 		static bool IsKeyPressed(KeyCode key);
+		// Went down or up since the previous frame, also when it did both in between
+		static bool WasKeyPressed(KeyCode key);
+		static bool WasKeyReleased(KeyCode key);
 
 		static bool IsMouseButtonPressed(MouseCode button);
+		static bool WasMouseButtonPressed(MouseCode button);
+		static bool WasMouseButtonReleased(MouseCode button);
+
 		static std::pair<float, float> GetMousePosition();
+		static std::pair<float, float> GetMouseDelta();
 		static float GetMouseX();
 		static float GetMouseY();
+
+		// Called by Application on the main thread: input events update the state, NextFrame
+		// publishes it at the start of a frame
+		static void OnEvent(Event& e);
+		static void NextFrame();
 	};
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,369 @@
+#include "hzpch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	struct Job
+	{
+		JobSystem::JobFunction Function;
+		JobCounter* Counter = nullptr;
+		const JobCounter* Dependency = nullptr;
+
+		// Set by the spawning thread when it takes the slot, cleared by whichever thread ran the job
+		std::atomic<bool> InUse{ false };
+
+		bool IsReady() const { return !Dependency || Dependency->IsDone(); }
+	};
+
+	// Chase-Lev work-stealing deque. Only the owning thread may Push/Pop (LIFO end),
+	// any thread may Steal (FIFO end).
+	class WorkStealingQueue
+	{
+	public:
+		static const int64_t Capacity = 4096;
+
+		// Owner only: stealing can only make room, so a Push after this returned false succeeds
+		bool IsFull() const
+		{
+			return m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_acquire) >= Capacity;
+		}
+
+		bool Push(Job* job)
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			if (bottom - top >= Capacity)
+				return false;
+
+			m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		Job* Pop()
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last job, race against stealers
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					job = nullptr;
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return job;
+		}
+
+		Job* Steal()
+		{
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+			return job;
+		}
+	private:
+		alignas(64) std::atomic<int64_t> m_Top{ 0 };
+		alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+		std::array<std::atomic<Job*>, Capacity> m_Jobs;
+	};
+
+	// Per-thread state: the deque plus a pool of job slots. Only the owning thread takes
+	// slots; a slot comes back once its job has run, on whichever thread ran it.
+	struct JobQueue
+	{
+		WorkStealingQueue Queue;
+		std::array<Job, WorkStealingQueue::Capacity> JobPool;
+		uint32_t NextJob = 0;
+
+		// Null when every slot has a job queued or running
+		Job* AllocateJob()
+		{
+			for (uint32_t i = 0; i < WorkStealingQueue::Capacity; i++)
+			{
+				Job* job = &JobPool[NextJob];
+				NextJob = (NextJob + 1) & (WorkStealingQueue::Capacity - 1);
+				if (!job->InUse.load(std::memory_order_acquire))
+				{
+					job->InUse.store(true, std::memory_order_relaxed);
+					return job;
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	struct JobSystemData
+	{
+		// Index 0 belongs to the main thread, workers use 1..WorkerCount
+		std::vector<Scope<JobQueue>> Queues;
+		std::vector<std::thread> Workers;
+
+		std::atomic<bool> Running{ false };
+		std::atomic<uint32_t> PendingJobs{ 0 }; // Queued and not yet picked up by any thread
+		std::atomic<uint32_t> SleepingWorkers{ 0 };
+
+		std::mutex WakeMutex;
+		std::condition_variable WakeCondition;
+	};
+
+	static JobSystemData s_Data;
+
+	static const uint32_t InvalidThreadIndex = ~0u;
+	static thread_local uint32_t s_ThreadIndex = InvalidThreadIndex;
+	static thread_local uint32_t s_StealSeed = 0;
+
+	static Job* FindJob()
+	{
+		auto& own = s_Data.Queues[s_ThreadIndex]->Queue;
+
+		Job* job = own.Pop();
+		if (job && !job->IsReady())
+		{
+			// Dependencies are always spawned before their dependents, so take the
+			// oldest job instead of popping the same blocked job again.
+			own.Push(job);
+			job = own.Steal();
+			if (job && !job->IsReady())
+			{
+				own.Push(job);
+				job = nullptr;
+			}
+		}
+
+		if (job)
+			return job;
+
+		// Try to steal from the other threads, starting at a rotating victim
+		uint32_t queueCount = (uint32_t)s_Data.Queues.size();
+		uint32_t start = s_StealSeed++;
+		for (uint32_t i = 0; i < queueCount; i++)
+		{
+			uint32_t victim = (start + i) % queueCount;
+			if (victim == s_ThreadIndex)
+				continue;
+
+			job = s_Data.Queues[victim]->Queue.Steal();
+			if (!job)
+				continue;
+
+			if (job->IsReady())
+				return job;
+
+			// Not ready yet, keep it around in our own deque
+			if (own.Push(job))
+				continue;
+
+			// No room to park it, so hold on to it until it can run
+			while (!job->IsReady())
+				std::this_thread::yield();
+			return job;
+		}
+
+		return nullptr;
+	}
+
+	static Job* GetJob()
+	{
+		Job* job = FindJob();
+		if (job)
+			s_Data.PendingJobs.fetch_sub(1);
+		return job;
+	}
+
+	static void RunJob(Job* job)
+	{
+		job->Function();
+
+		// Hand the slot back before signalling, a waiter may spawn into it right away
+		JobCounter* counter = job->Counter;
+		job->Function = nullptr;
+		job->InUse.store(false, std::memory_order_release);
+
+		if (counter)
+			counter->Value.fetch_sub(1, std::memory_order_release);
+	}
+
+	static void WorkerThread(uint32_t threadIndex)
+	{
+		s_ThreadIndex = threadIndex;
+		s_StealSeed = threadIndex;
+
+		while (s_Data.Running.load(std::memory_order_acquire))
+		{
+			if (Job* job = GetJob())
+			{
+				RunJob(job);
+				continue;
+			}
+
+			// Queued jobs that are blocked on a dependency keep us awake, but don't hog the core
+			if (s_Data.PendingJobs.load() > 0)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(s_Data.WakeMutex);
+			s_Data.SleepingWorkers++;
+			s_Data.WakeCondition.wait(lock, []()
+			{
+				return s_Data.PendingJobs.load() > 0 || !s_Data.Running.load();
+			});
+			s_Data.SleepingWorkers--;
+		}
+	}
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(!IsInitialized(), "JobSystem already initialized!");
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		s_ThreadIndex = 0;
+		s_Data.Queues.reserve(workerCount + 1);
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+			s_Data.Queues.emplace_back(CreateScope<JobQueue>());
+
+		s_Data.Running = true;
+		s_Data.Workers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data.Workers.emplace_back(WorkerThread, i + 1);
+
+		HZ_CORE_INFO("JobSystem initialized with {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!IsInitialized())
+			return;
+
+		// Drain whatever is still queued before stopping the workers
+		while (s_Data.PendingJobs.load() > 0)
+		{
+			if (Job* job = GetJob())
+				RunJob(job);
+			else
+				std::this_thread::yield();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data.WakeMutex);
+			s_Data.Running = false;
+		}
+		s_Data.WakeCondition.notify_all();
+
+		for (auto& worker : s_Data.Workers)
+			worker.join();
+
+		s_Data.Workers.clear();
+		s_Data.Queues.clear();
+		s_ThreadIndex = InvalidThreadIndex;
+	}
+
+	void JobSystem::Execute(const JobFunction& function, JobCounter* counter, const JobCounter* dependency)
+	{
+		if (!IsInitialized() || s_ThreadIndex == InvalidThreadIndex)
+		{
+			// No job system (or a foreign thread): run synchronously
+			HZ_CORE_ASSERT(!dependency || dependency->IsDone(), "Cannot wait on a dependency outside of the JobSystem!");
+			function();
+			return;
+		}
+
+		auto& queue = *s_Data.Queues[s_ThreadIndex];
+		Job* job = queue.Queue.IsFull() ? nullptr : queue.AllocateJob();
+		if (!job)
+		{
+			// No room to queue it, run it right here instead
+			if (dependency)
+				Wait(*dependency);
+			function();
+			return;
+		}
+
+		if (counter)
+			counter->Value.fetch_add(1, std::memory_order_relaxed);
+
+		job->Function = function;
+		job->Counter = counter;
+		job->Dependency = dependency;
+
+		s_Data.PendingJobs.fetch_add(1);
+		[[maybe_unused]] bool pushed = queue.Queue.Push(job);
+		HZ_CORE_ASSERT(pushed, "Job deque filled up between the check and the push!");
+
+		if (s_Data.SleepingWorkers.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(s_Data.WakeMutex);
+			s_Data.WakeCondition.notify_one();
+		}
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		HZ_CORE_ASSERT(counter.IsDone() || s_ThreadIndex != InvalidThreadIndex, "Wait called from a thread outside of the JobSystem!");
+
+		while (!counter.IsDone())
+		{
+			if (Job* job = GetJob())
+				RunJob(job);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::RunPendingJob()
+	{
+		if (!IsInitialized() || s_ThreadIndex == InvalidThreadIndex)
+			return false;
+
+		Job* job = GetJob();
+		if (!job)
+			return false;
+
+		RunJob(job);
+		return true;
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_Data.Workers.size();
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return s_Data.Running.load(std::memory_order_relaxed);
+	}
+
+}
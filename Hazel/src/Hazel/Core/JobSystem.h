@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+
+#include <atomic>
+#include <functional>
+
+namespace Hazel {
+
+	// Counts outstanding jobs. Pass the same counter to several Execute calls
+	// and Wait on it, or use it as the dependency of a later job.
+	struct JobCounter
+	{
+		std::atomic<uint32_t> Value{ 0 };
+
+		bool IsDone() const { return Value.load(std::memory_order_acquire) == 0; }
+	};
+
+	class JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+
+		// workerCount == 0 sizes the pool from the hardware concurrency (minus the main thread)
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		// Jobs may only be spawned from the main thread or from inside another job.
+		// A job with a dependency is not started before the dependency counter reaches zero.
+		static void Execute(const JobFunction& job, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+
+		// Runs pending jobs on the calling thread until the counter reaches zero
+		static void Wait(const JobCounter& counter);
+
+		// Runs at most one queued job on the calling thread, returns false if there was none
+		static bool RunPendingJob();
+
+		// Calls func(index) for every index in [0, count), split into jobs of batchSize indices.
+		// Blocks until every batch has finished.
+		template<typename F>
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const F& func)
+		{
+			if (count == 0)
+				return;
+
+			if (batchSize == 0)
+				batchSize = 1;
+
+			JobCounter counter;
+			for (uint32_t start = 0; start < count; start += batchSize)
+			{
+				uint32_t end = std::min(start + batchSize, count);
+				Execute([&func, start, end]()
+				{
+					for (uint32_t i = start; i < end; i++)
+						func(i);
+				}, &counter);
+			}
+			Wait(counter);
+		}
+
+		static uint32_t GetWorkerCount();
+		static bool IsInitialized();
+	};
+
+}
@@ -4,23 +4,58 @@
 #include "Hazel/Core/Timestep.h"
 #include "Hazel/Events/Event.h"
 
+#include <functional>
+#include <vector>
+
 namespace Hazel {
 
 	class Layer
 	{
+	public:
+		using EventHandlerFn = std::function<bool(Event&)>;
+
+		struct EventSubscription
+		{
+			EventType Type = EventType::None; // None subscribes to the category instead
+			int Category = 0;
+			EventHandlerFn Handler;
+		};
 	public:
 		Layer(const std::string& name = "Layer");
 		virtual ~Layer();
 		
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
+		// Zero or more times a frame before OnUpdate, always with the same timestep, see
+		// ApplicationSpecification::FixedUpdateStep
+		virtual void OnFixedUpdate(Timestep ts) {}
 		virtual void OnUpdate(Timestep ts) {}
 		virtual void OnImGuiRender() {}
+		// Every event, for layers that don't subscribe
 		virtual void OnEvent(Event& event) {}
 
 		inline const std::string& GetName() { return m_DebugName; }
+
+		const std::vector<EventSubscription>& GetEventSubscriptions() const { return m_EventSubscriptions; }
+	protected:
+		// A layer that subscribes only gets the events it subscribed to, through the handlers,
+		// and OnEvent is not called. A handler returning true marks the event handled. Subscribe
+		// in the constructor or OnAttach: the layer stack builds its dispatch tables once the
+		// layer is pushed.
+		template<typename T, typename F>
+		void Subscribe(const F& func)
+		{
+			m_EventSubscriptions.push_back({ T::GetStaticType(), 0, [func](Event& e) { return func(static_cast<T&>(e)); } });
+		}
+
+		void Subscribe(EventCategory category, const EventHandlerFn& func)
+		{
+			m_EventSubscriptions.push_back({ EventType::None, category, func });
+		}
 	protected:
 		std::string m_DebugName;
+	private:
+		std::vector<EventSubscription> m_EventSubscriptions;
 	};
 
 }
\ No newline at end of file
@@ -19,11 +19,13 @@ namespace Hazel {
 	{
 		m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, layer);
 		m_LayerInsertIndex++;
+		InvalidateEventHandlers();
 	}
 
 	void LayerStack::PushOverlay(Layer* overlay)
 	{
 		m_Layers.emplace_back(overlay);
+		InvalidateEventHandlers();
 	}
 
 	void LayerStack::PopLayer(Layer* layer)
@@ -33,6 +35,7 @@ namespace Hazel {
 		{
 			m_Layers.erase(it);
 			m_LayerInsertIndex--;
+			InvalidateEventHandlers();
 		}
 	}
 
@@ -40,7 +43,60 @@ namespace Hazel {
 	{
 		auto it = std::find(m_Layers.begin(), m_Layers.end(), overlay);
 		if (it != m_Layers.end())
+		{
 			m_Layers.erase(it);
+			InvalidateEventHandlers();
+		}
+	}
+
+	void LayerStack::Dispatch(Event& e)
+	{
+		size_t type = (size_t)e.GetEventType();
+		if (!m_EventHandlersBuilt[type])
+			BuildEventHandlers(e);
+
+		for (const EventHandler& handler : m_EventHandlers[type])
+		{
+			if (e.Handled)
+				break;
+
+			if (handler.Subscription < 0)
+				handler.Target->OnEvent(e);
+			else
+				e.Handled |= handler.Target->GetEventSubscriptions()[handler.Subscription].Handler(e);
+		}
+	}
+
+	void LayerStack::BuildEventHandlers(const Event& e)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		EventType type = e.GetEventType();
+		int categories = e.GetCategoryFlags();
+
+		std::vector<EventHandler>& handlers = m_EventHandlers[(size_t)type];
+		handlers.clear();
+		for (auto it = m_Layers.rbegin(); it != m_Layers.rend(); it++)
+		{
+			const auto& subscriptions = (*it)->GetEventSubscriptions();
+			if (subscriptions.empty())
+			{
+				handlers.push_back({ *it, -1 });
+				continue;
+			}
+
+			for (size_t i = 0; i < subscriptions.size(); i++)
+			{
+				if (subscriptions[i].Type == type || (subscriptions[i].Type == EventType::None && (subscriptions[i].Category & categories)))
+					handlers.push_back({ *it, (int32_t)i });
+			}
+		}
+		m_EventHandlersBuilt[(size_t)type] = true;
+	}
+
+	void LayerStack::InvalidateEventHandlers()
+	{
+		m_EventHandlersBuilt.fill(false);
 	}
 
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Hazel/Core/Core.h"
 #include "Hazel/Core/Layer.h"
 
+#include <array>
 #include <vector>
 
 namespace Hazel {
@@ -18,11 +19,29 @@ namespace Hazel {
 		void PopLayer(Layer* layer);
 		void PopOverlay(Layer* overlay);
 
+		// Top to bottom until handled, to the layers interested in the event's type
+		void Dispatch(Event& e);
+
 		std::vector<Layer*>::iterator begin() { return m_Layers.begin(); }
 		std::vector<Layer*>::iterator end() { return m_Layers.end(); }
+	private:
+		void BuildEventHandlers(const Event& e);
+		void InvalidateEventHandlers();
 	private:
 		std::vector<Layer*> m_Layers;
 		unsigned int m_LayerInsertIndex = 0;
+
+		struct EventHandler
+		{
+			Layer* Target;
+			int32_t Subscription; // Into the layer's subscriptions, -1 for OnEvent
+		};
+
+		static constexpr size_t EventTypeCount = (size_t)EventType::MouseScrolled + 1;
+
+		// Per event type, built the first time the type is dispatched after the layers changed
+		std::array<std::vector<EventHandler>, EventTypeCount> m_EventHandlers;
+		std::array<bool, EventTypeCount> m_EventHandlersBuilt = {};
 	};
 
 }
\ No newline at end of file
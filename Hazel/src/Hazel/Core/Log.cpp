@@ -2,20 +2,295 @@
 #include "Log.h"
 
 #include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/sinks/base_sink.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 namespace Hazel {
 
 	std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
+	std::atomic<bool> Log::s_Asynchronous = false;
+
+	// Keeps the last messages around for the editor console
+	class RecentMessagesSink : public spdlog::sinks::base_sink<std::mutex>
+	{
+	public:
+		void GetMessages(std::vector<LogMessage>& outMessages)
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+
+			uint64_t count = std::min<uint64_t>(m_Count, Log::MaxRecentMessages);
+			outMessages.resize(count);
+			for (uint64_t i = 0; i < count; i++)
+				outMessages[i] = m_Messages[(m_Count - count + i) % Log::MaxRecentMessages];
+		}
+
+		uint64_t GetVersion() const { return m_Version.load(std::memory_order_acquire); }
+
+		void Clear()
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			m_Count = 0;
+			m_Version.fetch_add(1, std::memory_order_release);
+		}
+	protected:
+		void sink_it_(const spdlog::details::log_msg& msg) override
+		{
+			spdlog::memory_buf_t formatted;
+			formatter_->format(msg, formatted);
+
+			size_t size = formatted.size();
+			while (size > 0 && (formatted[size - 1] == '\n' || formatted[size - 1] == '\r'))
+				size--;
+
+			LogMessage& message = m_Messages[m_Count % Log::MaxRecentMessages];
+			message.Level = msg.level;
+			message.Text.assign(formatted.data(), size);
+			m_Count++;
+			m_Version.fetch_add(1, std::memory_order_release);
+		}
+
+		void flush_() override {}
+	private:
+		std::array<LogMessage, Log::MaxRecentMessages> m_Messages;
+		uint64_t m_Count = 0;
+		std::atomic<uint64_t> m_Version = 0;
+	};
 
-	void Log::Init()
+	// Bounded multi-producer queue, each cell's sequence number says whose turn it is:
+	// Position for the producer claiming it, Position + 1 once it is written,
+	// Position + QueueCapacity once the sink thread is done with it.
+	struct LogQueueCell
 	{
-		spdlog::set_pattern("%^[%T] %n: %v%$");
-		s_CoreLogger = spdlog::stdout_color_mt("HAZEL");
+		std::atomic<uint64_t> Sequence;
+		LogQueueEntry Entry;
+	};
+
+	struct LogData
+	{
+		static constexpr uint64_t QueueCapacity = 8192; // Power of two
+
+		std::unique_ptr<LogQueueCell[]> Queue;
+		alignas(64) std::atomic<uint64_t> EnqueuePosition = 0;
+		alignas(64) std::atomic<uint64_t> ProcessedCount = 0;
+		std::atomic<uint64_t> DroppedMessages = 0;
+		uint64_t ReportedDroppedMessages = 0;
+
+		std::thread SinkThread;
+		std::atomic<bool> SinkThreadRunning = false;
+
+		std::shared_ptr<RecentMessagesSink> RecentMessages;
+	};
+
+	static LogData s_Data;
+
+	static void WriteEntry(const LogQueueEntry& entry, fmt::memory_buffer& buffer)
+	{
+		buffer.clear();
+		try
+		{
+			entry.Format(entry.Arguments, buffer);
+		}
+		catch (const std::exception& e)
+		{
+			buffer.clear();
+			fmt::format_to(std::back_inserter(buffer), "[log formatting failed: {}]", e.what());
+		}
+
+		spdlog::details::log_msg message(spdlog::source_loc{}, entry.Logger->name(), entry.Level, spdlog::string_view_t(buffer.data(), buffer.size()));
+		message.time = entry.Time;
+		message.thread_id = entry.ThreadID;
+		for (auto& sink : entry.Logger->sinks())
+		{
+			if (sink->should_log(message.level))
+				sink->log(message);
+		}
+	}
+
+	// Only ever called from one thread at a time: the sink thread, or SetMode once it has stopped
+	static bool ProcessQueue(fmt::memory_buffer& buffer)
+	{
+		bool processed = false;
+		for (;;)
+		{
+			uint64_t position = s_Data.ProcessedCount.load(std::memory_order_relaxed);
+			LogQueueCell& cell = s_Data.Queue[position & (LogData::QueueCapacity - 1)];
+			if (cell.Sequence.load(std::memory_order_acquire) != position + 1)
+				break;
+
+			WriteEntry(cell.Entry, buffer);
+			cell.Entry.Destroy(cell.Entry.Arguments);
+			cell.Sequence.store(position + LogData::QueueCapacity, std::memory_order_release);
+			s_Data.ProcessedCount.store(position + 1, std::memory_order_release);
+			processed = true;
+		}
+		return processed;
+	}
+
+	static void ReportDroppedMessages()
+	{
+		uint64_t dropped = s_Data.DroppedMessages.load(std::memory_order_relaxed);
+		if (dropped == s_Data.ReportedDroppedMessages)
+			return;
+
+		Log::GetCoreLogger()->warn("{0} log messages dropped, the log queue was full", dropped - s_Data.ReportedDroppedMessages);
+		s_Data.ReportedDroppedMessages = dropped;
+	}
+
+	static void SinkThreadMain()
+	{
+		fmt::memory_buffer buffer;
+		while (s_Data.SinkThreadRunning.load(std::memory_order_acquire))
+		{
+			if (!ProcessQueue(buffer))
+			{
+				ReportDroppedMessages();
+				Log::GetCoreLogger()->flush();
+				Log::GetClientLogger()->flush();
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+	}
+
+	void Log::Init(LogMode mode)
+	{
+		auto consoleSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+		consoleSink->set_pattern("%^[%T] %n: %v%$");
+		s_Data.RecentMessages = std::make_shared<RecentMessagesSink>();
+		s_Data.RecentMessages->set_pattern("[%T] %n: %v");
+		spdlog::sink_ptr sinks[] = { consoleSink, s_Data.RecentMessages };
+
+		s_CoreLogger = std::make_shared<spdlog::logger>("HAZEL", std::begin(sinks), std::end(sinks));
 		s_CoreLogger->set_level(spdlog::level::trace);
+		spdlog::register_logger(s_CoreLogger);
 
-		s_ClientLogger = spdlog::stdout_color_mt("APP");
+		s_ClientLogger = std::make_shared<spdlog::logger>("APP", std::begin(sinks), std::end(sinks));
 		s_ClientLogger->set_level(spdlog::level::trace);
+		spdlog::register_logger(s_ClientLogger);
+
+		SetMode(mode);
+	}
+
+	void Log::Shutdown()
+	{
+		// The loggers stay, anything logged from here on is written synchronously
+		SetMode(LogMode::Synchronous);
+	}
+
+	void Log::SetMode(LogMode mode)
+	{
+		if (mode == GetMode())
+			return;
+
+		if (mode == LogMode::Asynchronous)
+		{
+			if (!s_Data.Queue)
+			{
+				s_Data.Queue = std::make_unique<LogQueueCell[]>(LogData::QueueCapacity);
+				for (uint64_t i = 0; i < LogData::QueueCapacity; i++)
+					s_Data.Queue[i].Sequence.store(s_Data.EnqueuePosition + i, std::memory_order_relaxed);
+			}
+
+			s_Data.SinkThreadRunning.store(true, std::memory_order_release);
+			s_Data.SinkThread = std::thread(SinkThreadMain);
+			s_Asynchronous.store(true, std::memory_order_release);
+		}
+		else
+		{
+			s_Asynchronous.store(false, std::memory_order_release);
+			s_Data.SinkThreadRunning.store(false, std::memory_order_release);
+			s_Data.SinkThread.join();
+
+			fmt::memory_buffer buffer;
+			ProcessQueue(buffer);
+			ReportDroppedMessages();
+			s_CoreLogger->flush();
+			s_ClientLogger->flush();
+		}
+	}
+
+	LogMode Log::GetMode()
+	{
+		return s_Asynchronous.load(std::memory_order_acquire) ? LogMode::Asynchronous : LogMode::Synchronous;
+	}
+
+	void Log::Flush()
+	{
+		if (s_Asynchronous.load(std::memory_order_acquire))
+		{
+			uint64_t target = s_Data.EnqueuePosition.load(std::memory_order_acquire);
+			while (s_Data.ProcessedCount.load(std::memory_order_acquire) < target)
+				std::this_thread::yield();
+		}
+
+		s_CoreLogger->flush();
+		s_ClientLogger->flush();
+	}
+
+	uint64_t Log::GetDroppedMessageCount()
+	{
+		return s_Data.DroppedMessages.load(std::memory_order_relaxed);
+	}
+
+	void Log::GetRecentMessages(std::vector<LogMessage>& outMessages)
+	{
+		s_Data.RecentMessages->GetMessages(outMessages);
+	}
+
+	uint64_t Log::GetRecentMessagesVersion()
+	{
+		return s_Data.RecentMessages->GetVersion();
+	}
+
+	void Log::ClearRecentMessages()
+	{
+		s_Data.RecentMessages->Clear();
+	}
+
+	LogQueueEntry* Log::BeginPush(spdlog::level::level_enum level)
+	{
+		uint64_t position = s_Data.EnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			LogQueueCell& cell = s_Data.Queue[position & (LogData::QueueCapacity - 1)];
+			int64_t difference = (int64_t)(cell.Sequence.load(std::memory_order_acquire) - position);
+			if (difference == 0)
+			{
+				if (s_Data.EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					cell.Entry.Position = position;
+					return &cell.Entry;
+				}
+			}
+			else if (difference < 0)
+			{
+				// Full: chatter goes, anything that matters waits for the sink thread
+				if (level < spdlog::level::warn)
+				{
+					s_Data.DroppedMessages.fetch_add(1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				std::this_thread::yield();
+				position = s_Data.EnqueuePosition.load(std::memory_order_relaxed);
+			}
+			else
+			{
+				position = s_Data.EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void Log::EndPush(LogQueueEntry* entry)
+	{
+		spdlog::level::level_enum level = entry->Level;
+		s_Data.Queue[entry->Position & (LogData::QueueCapacity - 1)].Sequence.store(entry->Position + 1, std::memory_order_release);
+
+		if (level >= spdlog::level::err)
+			Flush();
 	}
 
 }
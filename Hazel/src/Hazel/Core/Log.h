@@ -6,34 +6,215 @@
 #pragma warning(push, 0)
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/ostr.h>
+#include <spdlog/details/os.h>
 #pragma warning(pop)
 
+#include <atomic>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Log calls below HZ_LOG_LEVEL are compiled out, arguments included
+#define HZ_LOG_LEVEL_TRACE    0
+#define HZ_LOG_LEVEL_INFO     2
+#define HZ_LOG_LEVEL_WARN     3
+#define HZ_LOG_LEVEL_ERROR    4
+#define HZ_LOG_LEVEL_CRITICAL 5
+#define HZ_LOG_LEVEL_OFF      6
+
+#ifndef HZ_LOG_LEVEL
+	#ifdef HZ_DIST
+		#define HZ_LOG_LEVEL HZ_LOG_LEVEL_INFO
+	#else
+		#define HZ_LOG_LEVEL HZ_LOG_LEVEL_TRACE
+	#endif
+#endif
+
 namespace Hazel {
 
+	enum class LogMode
+	{
+		// Every call formats and writes to the sinks before returning
+		Synchronous = 0,
+		// Calls copy their arguments into a bounded lock-free queue, a background thread
+		// formats and writes them. When the queue is full, trace and info messages are
+		// dropped; warnings and up wait for room. Errors and up flush before returning,
+		// so nothing is lost ahead of an assert.
+		Asynchronous
+	};
+
+	struct LogMessage
+	{
+		spdlog::level::level_enum Level;
+		std::string Text;
+	};
+
+	struct LogQueueEntry
+	{
+		static constexpr size_t ArgumentStorageSize = 112;
+
+		uint64_t Position; // In the queue
+		spdlog::logger* Logger;
+		spdlog::level::level_enum Level;
+		spdlog::log_clock::time_point Time;
+		size_t ThreadID;
+		void(*Format)(const void* arguments, fmt::memory_buffer& out);
+		void(*Destroy)(void* arguments);
+		alignas(std::max_align_t) char Arguments[ArgumentStorageSize];
+	};
+
 	class Log
 	{
 	public:
-		static void Init();
+		static void Init(LogMode mode = LogMode::Asynchronous);
+		static void Shutdown();
+
+		// Call while no other thread is logging
+		static void SetMode(LogMode mode);
+		static LogMode GetMode();
+
+		// Waits until everything logged so far has reached the sinks
+		static void Flush();
+		static uint64_t GetDroppedMessageCount();
+
+		// The last MaxRecentMessages messages, oldest first, for the editor console.
+		// The version changes with every new message.
+		static constexpr uint32_t MaxRecentMessages = 2000;
+		static void GetRecentMessages(std::vector<LogMessage>& outMessages);
+		static uint64_t GetRecentMessagesVersion();
+		static void ClearRecentMessages();
 
 		inline static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
 		inline static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
+
+		// Used by the log macros. The format has to be a string literal when logging asynchronously,
+		// only the pointer is queued.
+		template<typename... Args>
+		static void Write(spdlog::logger* logger, spdlog::level::level_enum level, const char* format, const Args&... args);
+	private:
+		// Arguments that are still meaningful as a copy are formatted on the background thread,
+		// anything else (pointers to live objects, custom types) is formatted by the caller.
+		template<typename T>
+		static constexpr bool IsDeferrable = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_convertible_v<const T&, std::string_view>;
+
+		template<typename T>
+		using DeferredType = std::conditional_t<std::is_arithmetic_v<T> || std::is_enum_v<T>, T, std::string>;
+
+		template<typename... Args>
+		struct DeferredMessage
+		{
+			const char* Format;
+			std::tuple<Args...> Arguments;
+
+			static void FormatTo(const void* data, fmt::memory_buffer& out)
+			{
+				const DeferredMessage& message = *(const DeferredMessage*)data;
+				std::apply([&](const auto&... args) { fmt::format_to(std::back_inserter(out), message.Format, args...); }, message.Arguments);
+			}
+
+			static void Destroy(void* data)
+			{
+				((DeferredMessage*)data)->~DeferredMessage();
+			}
+		};
+
+		// nullptr when the message is dropped
+		static LogQueueEntry* BeginPush(spdlog::level::level_enum level);
+		static void EndPush(LogQueueEntry* entry);
 	private:
 		static std::shared_ptr<spdlog::logger> s_CoreLogger;
 		static std::shared_ptr<spdlog::logger> s_ClientLogger;
+		static std::atomic<bool> s_Asynchronous;
 	};
 
+	template<typename... Args>
+	void Log::Write(spdlog::logger* logger, spdlog::level::level_enum level, const char* format, const Args&... args)
+	{
+		if (!logger->should_log(level))
+			return;
+
+		if (!s_Asynchronous.load(std::memory_order_relaxed))
+		{
+			logger->log(level, format, args...);
+			return;
+		}
+
+		using Message = DeferredMessage<DeferredType<Args>...>;
+		constexpr bool deferrable = (IsDeferrable<Args> && ...) && sizeof(Message) <= LogQueueEntry::ArgumentStorageSize;
+		if constexpr (!deferrable)
+		{
+			fmt::memory_buffer buffer;
+			fmt::format_to(std::back_inserter(buffer), format, args...);
+			Write(logger, level, "{}", std::string_view(buffer.data(), buffer.size()));
+		}
+		else
+		{
+			LogQueueEntry* entry = BeginPush(level);
+			if (!entry)
+				return;
+
+			entry->Logger = logger;
+			entry->Level = level;
+			entry->Time = spdlog::log_clock::now();
+			entry->ThreadID = spdlog::details::os::thread_id();
+			if constexpr (sizeof...(Args) == 0)
+			{
+				// No arguments, no formatting, same as spdlog: braces are printed as they are
+				new (entry->Arguments) Message{ format, {} };
+				entry->Format = [](const void* data, fmt::memory_buffer& out)
+				{
+					std::string_view text = ((const Message*)data)->Format;
+					out.append(text.data(), text.data() + text.size());
+				};
+			}
+			else
+			{
+				new (entry->Arguments) Message{ format, std::tuple<DeferredType<Args>...>(DeferredType<Args>(args)...) };
+				entry->Format = &Message::FormatTo;
+			}
+			entry->Destroy = &Message::Destroy;
+			EndPush(entry);
+		}
+	}
+
 }
 
-// Core log macros
-#define HZ_CORE_TRACE(...)    ::Hazel::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define HZ_CORE_INFO(...)     ::Hazel::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define HZ_CORE_WARN(...)     ::Hazel::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define HZ_CORE_ERROR(...)    ::Hazel::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define HZ_CORE_CRITICAL(...) ::Hazel::Log::GetCoreLogger()->critical(__VA_ARGS__)
-
-// Client log macros
-#define HZ_TRACE(...)         ::Hazel::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define HZ_INFO(...)          ::Hazel::Log::GetClientLogger()->info(__VA_ARGS__)
-#define HZ_WARN(...)          ::Hazel::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define HZ_ERROR(...)         ::Hazel::Log::GetClientLogger()->error(__VA_ARGS__)
-#define HZ_CRITICAL(...)      ::Hazel::Log::GetClientLogger()->critical(__VA_ARGS__)
\ No newline at end of file
+#define HZ_INTERNAL_LOG(logger, level, ...) ::Hazel::Log::Write(logger.get(), level, __VA_ARGS__)
+
+// Log macros, core and client
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_TRACE
+	#define HZ_CORE_TRACE(...)    HZ_INTERNAL_LOG(::Hazel::Log::GetCoreLogger(), spdlog::level::trace, __VA_ARGS__)
+	#define HZ_TRACE(...)         HZ_INTERNAL_LOG(::Hazel::Log::GetClientLogger(), spdlog::level::trace, __VA_ARGS__)
+#else
+	#define HZ_CORE_TRACE(...)    (void)0
+	#define HZ_TRACE(...)         (void)0
+#endif
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_INFO
+	#define HZ_CORE_INFO(...)     HZ_INTERNAL_LOG(::Hazel::Log::GetCoreLogger(), spdlog::level::info, __VA_ARGS__)
+	#define HZ_INFO(...)          HZ_INTERNAL_LOG(::Hazel::Log::GetClientLogger(), spdlog::level::info, __VA_ARGS__)
+#else
+	#define HZ_CORE_INFO(...)     (void)0
+	#define HZ_INFO(...)          (void)0
+#endif
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_WARN
+	#define HZ_CORE_WARN(...)     HZ_INTERNAL_LOG(::Hazel::Log::GetCoreLogger(), spdlog::level::warn, __VA_ARGS__)
+	#define HZ_WARN(...)          HZ_INTERNAL_LOG(::Hazel::Log::GetClientLogger(), spdlog::level::warn, __VA_ARGS__)
+#else
+	#define HZ_CORE_WARN(...)     (void)0
+	#define HZ_WARN(...)          (void)0
+#endif
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_ERROR
+	#define HZ_CORE_ERROR(...)    HZ_INTERNAL_LOG(::Hazel::Log::GetCoreLogger(), spdlog::level::err, __VA_ARGS__)
+	#define HZ_ERROR(...)         HZ_INTERNAL_LOG(::Hazel::Log::GetClientLogger(), spdlog::level::err, __VA_ARGS__)
+#else
+	#define HZ_CORE_ERROR(...)    (void)0
+	#define HZ_ERROR(...)         (void)0
+#endif
+#if HZ_LOG_LEVEL <= HZ_LOG_LEVEL_CRITICAL
+	#define HZ_CORE_CRITICAL(...) HZ_INTERNAL_LOG(::Hazel::Log::GetCoreLogger(), spdlog::level::critical, __VA_ARGS__)
+	#define HZ_CRITICAL(...)      HZ_INTERNAL_LOG(::Hazel::Log::GetClientLogger(), spdlog::level::critical, __VA_ARGS__)
+#else
+	#define HZ_CORE_CRITICAL(...) (void)0
+	#define HZ_CRITICAL(...)      (void)0
+#endif
@@ -0,0 +1,13 @@
+#include "hzpch.h"
+#include "Hazel/Core/Ref.h"
+
+namespace Hazel {
+
+#ifdef HZ_ENABLE_ASSERTS
+	void SingleThreadedRefCounted::OnOwnerThreadViolation()
+	{
+		HZ_CORE_ASSERT(false, "Ref to a SingleThreadedRefCounted object copied or released off the thread that created it, derive from RefCounted instead!");
+	}
+#endif
+
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#ifdef HZ_ENABLE_ASSERTS
+	#include <thread>
+#endif
+
+namespace Hazel {
+
+	// Base class for objects owned through Ref<T>. The count lives in the object itself,
+	// so CreateRef makes a single allocation and copying a Ref touches only the object.
+	class RefCounted
+	{
+	public:
+		virtual ~RefCounted() = default;
+
+		void IncRefCount() const { m_RefCount.fetch_add(1, std::memory_order_relaxed); }
+		uint32_t DecRefCount() const { return m_RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+		uint32_t GetRefCount() const { return m_RefCount.load(std::memory_order_relaxed); }
+	protected:
+		RefCounted() = default;
+		// A copied object starts out unowned
+		RefCounted(const RefCounted&) {}
+		RefCounted& operator=(const RefCounted&) { return *this; }
+	private:
+		mutable std::atomic<uint32_t> m_RefCount = 0;
+	};
+
+	// Same as RefCounted with a plain counter. Only for objects whose Refs are never
+	// copied or released off the main thread (scenes, editor data, sprite sheets).
+	// Debug builds assert that every count change happens on the creating thread.
+	class SingleThreadedRefCounted
+	{
+	public:
+		virtual ~SingleThreadedRefCounted() = default;
+
+		void IncRefCount() const { CheckOwnerThread(); m_RefCount++; }
+		uint32_t DecRefCount() const { CheckOwnerThread(); return --m_RefCount; }
+		uint32_t GetRefCount() const { return m_RefCount; }
+	protected:
+		SingleThreadedRefCounted() = default;
+		SingleThreadedRefCounted(const SingleThreadedRefCounted&) {}
+		SingleThreadedRefCounted& operator=(const SingleThreadedRefCounted&) { return *this; }
+	private:
+	#ifdef HZ_ENABLE_ASSERTS
+		// Log.h and Assert.h come after this header in Core.h, so the assert lives in Ref.cpp
+		static void OnOwnerThreadViolation();
+		void CheckOwnerThread() const { if (std::this_thread::get_id() != m_OwnerThread) OnOwnerThreadViolation(); }
+
+		std::thread::id m_OwnerThread = std::this_thread::get_id();
+	#else
+		void CheckOwnerThread() const {}
+	#endif
+		mutable uint32_t m_RefCount = 0;
+	};
+
+	// Intrusive shared pointer. Keeps the parts of the std::shared_ptr interface the engine
+	// uses (get, reset, bool, comparisons), so existing code compiles unchanged.
+	template<typename T>
+	class Ref
+	{
+	public:
+		Ref() = default;
+		Ref(std::nullptr_t) {}
+
+		// Safe for objects that are already owned elsewhere, the count is in the object
+		explicit Ref(T* instance)
+			: m_Instance(instance)
+		{
+			IncRef();
+		}
+
+		Ref(const Ref& other)
+			: m_Instance(other.m_Instance)
+		{
+			IncRef();
+		}
+
+		Ref(Ref&& other) noexcept
+			: m_Instance(other.m_Instance)
+		{
+			other.m_Instance = nullptr;
+		}
+
+		template<typename T2, typename = std::enable_if_t<std::is_convertible_v<T2*, T*>>>
+		Ref(const Ref<T2>& other)
+			: m_Instance(other.m_Instance)
+		{
+			IncRef();
+		}
+
+		template<typename T2, typename = std::enable_if_t<std::is_convertible_v<T2*, T*>>>
+		Ref(Ref<T2>&& other) noexcept
+			: m_Instance(other.m_Instance)
+		{
+			other.m_Instance = nullptr;
+		}
+
+		~Ref()
+		{
+			DecRef();
+		}
+
+		Ref& operator=(std::nullptr_t)
+		{
+			reset();
+			return *this;
+		}
+
+		Ref& operator=(const Ref& other)
+		{
+			// Increment first, so self-assignment can't free the instance
+			other.IncRef();
+			DecRef();
+			m_Instance = other.m_Instance;
+			return *this;
+		}
+
+		Ref& operator=(Ref&& other) noexcept
+		{
+			if (this != &other)
+			{
+				DecRef();
+				m_Instance = other.m_Instance;
+				other.m_Instance = nullptr;
+			}
+			return *this;
+		}
+
+		template<typename T2, typename = std::enable_if_t<std::is_convertible_v<T2*, T*>>>
+		Ref& operator=(const Ref<T2>& other)
+		{
+			return *this = Ref(other);
+		}
+
+		template<typename T2, typename = std::enable_if_t<std::is_convertible_v<T2*, T*>>>
+		Ref& operator=(Ref<T2>&& other)
+		{
+			return *this = Ref(std::move(other));
+		}
+
+		void reset()
+		{
+			DecRef();
+			m_Instance = nullptr;
+		}
+
+		T* get() const { return m_Instance; }
+		T* operator->() const { return m_Instance; }
+		T& operator*() const { return *m_Instance; }
+
+		explicit operator bool() const { return m_Instance != nullptr; }
+
+		template<typename T2>
+		bool operator==(const Ref<T2>& other) const { return m_Instance == other.m_Instance; }
+		template<typename T2>
+		bool operator!=(const Ref<T2>& other) const { return m_Instance != other.m_Instance; }
+		bool operator==(std::nullptr_t) const { return m_Instance == nullptr; }
+		bool operator!=(std::nullptr_t) const { return m_Instance != nullptr; }
+	private:
+		void IncRef() const
+		{
+			if (m_Instance)
+				m_Instance->IncRefCount();
+		}
+
+		void DecRef() const
+		{
+			if (m_Instance && m_Instance->DecRefCount() == 0)
+				delete m_Instance;
+		}
+	private:
+		T* m_Instance = nullptr;
+
+		template<typename T2>
+		friend class Ref;
+	};
+
+	template<typename T, typename ... Args>
+	Ref<T> CreateRef(Args&& ... args)
+	{
+		static_assert(std::is_base_of_v<RefCounted, T> || std::is_base_of_v<SingleThreadedRefCounted, T>, "Ref<T> requires T to derive from RefCounted");
+		return Ref<T>(new T(std::forward<Args>(args)...));
+	}
+
+}
+
+namespace std {
+
+	template<typename T>
+	struct hash<Hazel::Ref<T>>
+	{
+		size_t operator()(const Hazel::Ref<T>& ref) const
+		{
+			return hash<T*>()(ref.get());
+		}
+	};
+
+}
@@ -0,0 +1,191 @@
+#include "hzpch.h"
+#include "TaskGraph.h"
+
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Core/JobSystem.h"
+
+namespace Hazel {
+
+	bool TaskGraph::Task::ConflictsWith(const Task& other) const
+	{
+		auto contains = [](const std::vector<size_t>& list, size_t id)
+		{
+			return std::find(list.begin(), list.end(), id) != list.end();
+		};
+
+		// Write/write and read/write hazards in either direction
+		for (size_t id : m_Writes)
+		{
+			if (contains(other.m_Writes, id) || contains(other.m_Reads, id))
+				return true;
+		}
+		for (size_t id : m_Reads)
+		{
+			if (contains(other.m_Writes, id))
+				return true;
+		}
+		return false;
+	}
+
+	TaskGraph::Task& TaskGraph::AddTask(const std::string& name, const TaskFunction& function)
+	{
+		auto& task = m_Tasks.emplace_back(CreateScope<Task>());
+		task->m_Name = name;
+		task->m_ProfileName = Instrumentor::Get().InternName(name);
+		task->m_Function = function;
+		m_Compiled = false;
+		return *task;
+	}
+
+	void TaskGraph::Compile()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		for (auto& task : m_Tasks)
+		{
+			task->m_Predecessors.clear();
+			task->m_Successors.clear();
+		}
+
+		// Tasks keep the order they were added in wherever they conflict
+		for (uint32_t i = 0; i < (uint32_t)m_Tasks.size(); i++)
+		{
+			for (uint32_t j = 0; j < i; j++)
+			{
+				if (m_Tasks[i]->ConflictsWith(*m_Tasks[j]))
+				{
+					m_Tasks[i]->m_Predecessors.push_back(j);
+					m_Tasks[j]->m_Successors.push_back(i);
+				}
+			}
+		}
+
+		m_Compiled = true;
+	}
+
+	void TaskGraph::Execute()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!m_Compiled)
+			Compile();
+
+		auto frameStart = std::chrono::steady_clock::now();
+
+		JobCounter counter;
+		for (auto& task : m_Tasks)
+			task->m_RemainingPredecessors = (uint32_t)task->m_Predecessors.size();
+
+		for (uint32_t i = 0; i < (uint32_t)m_Tasks.size(); i++)
+		{
+			if (m_Tasks[i]->m_Predecessors.empty())
+				Launch(i, counter);
+		}
+
+		// Main thread runs its own tasks as they become ready and helps with the rest
+		while (!counter.IsDone())
+		{
+			uint32_t mainThreadTask = ~0u;
+			{
+				std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+				if (!m_MainThreadQueue.empty())
+				{
+					mainThreadTask = m_MainThreadQueue.back();
+					m_MainThreadQueue.pop_back();
+				}
+			}
+
+			if (mainThreadTask != ~0u)
+				Run(mainThreadTask, counter);
+			else if (!JobSystem::RunPendingJob())
+				std::this_thread::yield();
+		}
+
+		UpdateCriticalPath(frameStart);
+	}
+
+	void TaskGraph::Launch(uint32_t taskIndex, JobCounter& counter)
+	{
+		// Counted before the launching task finishes, so the counter can't hit zero early
+		if (m_Tasks[taskIndex]->m_MainThread)
+		{
+			counter.Value.fetch_add(1, std::memory_order_relaxed);
+			std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+			m_MainThreadQueue.push_back(taskIndex);
+			return;
+		}
+
+		counter.Value.fetch_add(1, std::memory_order_relaxed);
+		JobSystem::Execute([this, taskIndex, &counter]() { Run(taskIndex, counter); });
+	}
+
+	void TaskGraph::Run(uint32_t taskIndex, JobCounter& counter)
+	{
+		Task& task = *m_Tasks[taskIndex];
+
+		task.m_StartTime = std::chrono::steady_clock::now();
+		{
+		#if HZ_PROFILE
+			InstrumentationTimer timer(task.m_ProfileName);
+		#endif
+			task.m_Function();
+		}
+		task.m_EndTime = std::chrono::steady_clock::now();
+
+		for (uint32_t successor : task.m_Successors)
+		{
+			if (m_Tasks[successor]->m_RemainingPredecessors.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Launch(successor, counter);
+		}
+
+		counter.Value.fetch_sub(1, std::memory_order_release);
+	}
+
+	void TaskGraph::UpdateCriticalPath(std::chrono::steady_clock::time_point frameStart)
+	{
+		if (m_Tasks.empty())
+			return;
+
+		// Walk back from the task that finished last through the predecessor that released it
+		uint32_t current = 0;
+		for (uint32_t i = 1; i < (uint32_t)m_Tasks.size(); i++)
+		{
+			if (m_Tasks[i]->m_EndTime > m_Tasks[current]->m_EndTime)
+				current = i;
+		}
+		auto frameEnd = m_Tasks[current]->m_EndTime;
+
+		FrameVector<uint32_t> path;
+		path.reserve(m_Tasks.size());
+		while (true)
+		{
+			path.push_back(current);
+
+			const auto& predecessors = m_Tasks[current]->m_Predecessors;
+			if (predecessors.empty())
+				break;
+
+			current = *std::max_element(predecessors.begin(), predecessors.end(), [this](uint32_t lhs, uint32_t rhs)
+			{
+				return m_Tasks[lhs]->m_EndTime < m_Tasks[rhs]->m_EndTime;
+			});
+		}
+
+		m_CriticalPath.clear();
+		for (auto it = path.rbegin(); it != path.rend(); it++)
+		{
+			if (!m_CriticalPath.empty())
+				m_CriticalPath += " > ";
+			m_CriticalPath += m_Tasks[*it]->m_Name;
+		}
+		m_CriticalPathTime = std::chrono::duration<float, std::milli>(frameEnd - frameStart).count();
+
+	#if HZ_PROFILE
+		// Shows up as its own slice spanning the graph in chrome://tracing
+		FrameString name = "Critical path: ";
+		name += m_CriticalPath;
+		Instrumentor::Get().WriteDynamicProfile(name, frameStart, frameEnd - frameStart);
+	#endif
+	}
+
+}
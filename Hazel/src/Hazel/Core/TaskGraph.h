@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace Hazel {
+
+	struct JobCounter;
+
+	// Declarative per-frame task graph. Every task lists the resources (usually
+	// component types) it reads and writes; a task depends on every earlier task
+	// it conflicts with, and tasks without conflicts run concurrently on the JobSystem.
+	//
+	//   graph.AddTask("Culling", [this]() { CullSprites(); })
+	//       .Reads<PrimaryCameraResource, WorldTransformComponent, SpriteRendererComponent>()
+	//       .Writes<VisibleSpritesResource>();
+	class TaskGraph
+	{
+	public:
+		using TaskFunction = std::function<void()>;
+
+		class Task
+		{
+		public:
+			template<typename... T>
+			Task& Reads() { (m_Reads.push_back(typeid(T).hash_code()), ...); return *this; }
+
+			template<typename... T>
+			Task& Writes() { (m_Writes.push_back(typeid(T).hash_code()), ...); return *this; }
+
+			// Tasks that touch the graphics context or GLFW have to run on the main thread
+			Task& OnMainThread() { m_MainThread = true; return *this; }
+
+			const std::string& GetName() const { return m_Name; }
+		private:
+			bool ConflictsWith(const Task& other) const;
+		private:
+			std::string m_Name;
+			// The profiler keeps records after the graph is gone, so it gets a copy that outlives it
+			const char* m_ProfileName = nullptr;
+			TaskFunction m_Function;
+			std::vector<size_t> m_Reads, m_Writes;
+			bool m_MainThread = false;
+
+			std::vector<uint32_t> m_Predecessors, m_Successors;
+			std::atomic<uint32_t> m_RemainingPredecessors{ 0 };
+
+			std::chrono::steady_clock::time_point m_StartTime, m_EndTime;
+
+			friend class TaskGraph;
+		};
+	public:
+		TaskGraph() = default;
+		TaskGraph(const TaskGraph&) = delete;
+
+		Task& AddTask(const std::string& name, const TaskFunction& function);
+
+		// Runs every task once, respecting dependencies. Must be called from the main thread.
+		void Execute();
+
+		// Longest chain of dependent tasks measured during the last Execute
+		const std::string& GetCriticalPath() const { return m_CriticalPath; }
+		float GetCriticalPathMilliseconds() const { return m_CriticalPathTime; }
+	private:
+		void Compile();
+		void Launch(uint32_t taskIndex, JobCounter& counter);
+		void Run(uint32_t taskIndex, JobCounter& counter);
+		void UpdateCriticalPath(std::chrono::steady_clock::time_point frameStart);
+	private:
+		std::vector<Scope<Task>> m_Tasks;
+		bool m_Compiled = false;
+
+		std::mutex m_MainThreadMutex;
+		std::vector<uint32_t> m_MainThreadQueue;
+
+		std::string m_CriticalPath;
+		float m_CriticalPathTime = 0.0f;
+	};
+
+}
@@ -7,6 +7,9 @@
 
 namespace Hazel {
 
+	class GraphicsContext;
+	class EventQueue;
+
 	struct WindowProps
 	{
 		std::string Title;
@@ -25,8 +28,6 @@ namespace Hazel {
 	class Window
 	{
 	public:
-		using EventCallbackFn = std::function<void(Event&)>;
-
 		virtual ~Window() = default;
 
 		virtual void OnUpdate() = 0;
@@ -35,11 +36,13 @@ namespace Hazel {
 		virtual uint32_t GetHeight() const = 0;
 
 		// Window attributes
-		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
+		// Where the window's events go, they are dispatched with the rest of the queue
+		virtual void SetEventQueue(EventQueue* queue) = 0;
 		virtual void SetVSync(bool enabled) = 0;
 		virtual bool IsVSync() const = 0;
 
 		virtual void* GetNativeWindow() const = 0;
+		virtual GraphicsContext* GetGraphicsContext() const = 0;
 
 		static Scope<Window> Create(const WindowProps& props = WindowProps());
 	};
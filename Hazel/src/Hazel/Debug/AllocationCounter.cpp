@@ -0,0 +1,162 @@
+#include "hzpch.h"
+#include "AllocationCounter.h"
+
+#include "Hazel/Debug/MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Hazel {
+
+	// Constant-initialized, so they are usable before any dynamic initialization runs
+	static std::atomic<uint64_t> s_TotalAllocations{ 0 };
+	static std::atomic<uint64_t> s_TotalAllocatedBytes{ 0 };
+
+	static uint64_t s_FrameStartAllocations = 0;
+	static uint64_t s_FrameStartAllocatedBytes = 0;
+	static uint32_t s_FrameAllocations = 0;
+	static uint64_t s_FrameAllocatedBytes = 0;
+
+	static void CountAllocation(size_t size)
+	{
+		s_TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+		s_TotalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void AllocationCounter::NextFrame()
+	{
+		uint64_t allocations = s_TotalAllocations.load(std::memory_order_relaxed);
+		uint64_t bytes = s_TotalAllocatedBytes.load(std::memory_order_relaxed);
+
+		s_FrameAllocations = (uint32_t)(allocations - s_FrameStartAllocations);
+		s_FrameAllocatedBytes = bytes - s_FrameStartAllocatedBytes;
+
+		s_FrameStartAllocations = allocations;
+		s_FrameStartAllocatedBytes = bytes;
+	}
+
+	uint32_t AllocationCounter::GetFrameAllocations()
+	{
+		return s_FrameAllocations;
+	}
+
+	uint64_t AllocationCounter::GetFrameAllocatedBytes()
+	{
+		return s_FrameAllocatedBytes;
+	}
+
+	uint64_t AllocationCounter::GetTotalAllocations()
+	{
+		return s_TotalAllocations.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AllocationCounter::GetTotalAllocatedBytes()
+	{
+		return s_TotalAllocatedBytes.load(std::memory_order_relaxed);
+	}
+
+}
+
+#if HZ_COUNT_ALLOCATIONS || HZ_TRACK_MEMORY
+
+// Every other form of new/delete forwards to these four
+
+void* operator new(size_t size)
+{
+#if HZ_COUNT_ALLOCATIONS
+	Hazel::CountAllocation(size);
+#endif
+
+#if HZ_TRACK_MEMORY
+	void* memory = Hazel::MemoryTracker::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__, Hazel::MemoryTracker::GetCurrentTag());
+#else
+	void* memory = std::malloc(size ? size : 1);
+#endif
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+#if HZ_TRACK_MEMORY
+	Hazel::MemoryTracker::Free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+#if HZ_COUNT_ALLOCATIONS
+	Hazel::CountAllocation(size);
+#endif
+
+	size_t align = (size_t)alignment;
+#if HZ_TRACK_MEMORY
+	void* memory = Hazel::MemoryTracker::Allocate(size, align, Hazel::MemoryTracker::GetCurrentTag());
+#elif defined(HZ_PLATFORM_WINDOWS)
+	void* memory = _aligned_malloc(size ? size : 1, align);
+#else
+	void* memory = std::aligned_alloc(align, (std::max(size, (size_t)1) + align - 1) & ~(align - 1));
+#endif
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+#if HZ_TRACK_MEMORY
+	Hazel::MemoryTracker::Free(memory);
+#elif defined(HZ_PLATFORM_WINDOWS)
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+// The standard library would forward these as well, but not every toolchain
+// pairs them up with replaced versions, so spell them out
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	operator delete(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	operator delete(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	operator delete(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t alignment) noexcept
+{
+	operator delete(memory, alignment);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(memory, alignment);
+}
+
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(memory, alignment);
+}
+
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Counts every global operator new. Off in Dist builds.
+#ifndef HZ_DIST
+	#define HZ_COUNT_ALLOCATIONS 1
+#else
+	#define HZ_COUNT_ALLOCATIONS 0
+#endif
+
+namespace Hazel {
+
+	class AllocationCounter
+	{
+	public:
+		// Latches the counts since the previous call, Application calls this once per frame
+		static void NextFrame();
+
+		// Heap allocations (and their bytes) made during the last frame, by any thread
+		static uint32_t GetFrameAllocations();
+		static uint64_t GetFrameAllocatedBytes();
+
+		// Running totals since startup
+		static uint64_t GetTotalAllocations();
+		static uint64_t GetTotalAllocatedBytes();
+	};
+
+}
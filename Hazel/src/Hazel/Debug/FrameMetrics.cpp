@@ -0,0 +1,213 @@
+#include "hzpch.h"
+#include "FrameMetrics.h"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace Hazel {
+
+	static const char* s_MetricNames[(size_t)FrameMetric::Count] =
+	{
+		"frame_time_ms",
+		"update_time_ms",
+		"render_time_ms",
+		"draw_calls",
+		"quads",
+		"uploaded_bytes",
+		"allocations"
+	};
+
+	struct FrameMetricsData
+	{
+		bool SessionActive = false;
+		std::string SessionName;
+
+		std::vector<FrameMetricsSample> Samples;
+		std::array<MetricHistogram, (size_t)FrameMetric::Count> Histograms;
+	};
+
+	static FrameMetricsData s_Data;
+
+	void MetricHistogram::Add(double value)
+	{
+		uint32_t bucket = 0;
+		if (value >= std::ldexp(1.0, MinExponent))
+		{
+			// value = mantissa * 2^exponent, mantissa in [0.5, 1)
+			int exponent;
+			double mantissa = std::frexp(value, &exponent);
+			exponent--;
+
+			if (exponent >= MaxExponent)
+				bucket = BucketCount - 1;
+			else
+				bucket = 1 + (exponent - MinExponent) * SubBuckets + (uint32_t)((mantissa * 2.0 - 1.0) * SubBuckets);
+		}
+		m_Buckets[bucket]++;
+
+		m_Min = m_Count ? std::min(m_Min, value) : value;
+		m_Max = m_Count ? std::max(m_Max, value) : value;
+		m_Sum += value;
+		m_Count++;
+	}
+
+	void MetricHistogram::Clear()
+	{
+		*this = MetricHistogram();
+	}
+
+	double MetricHistogram::GetPercentile(double percentile) const
+	{
+		if (m_Count == 0)
+			return 0.0;
+
+		uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(percentile / 100.0 * m_Count), 1);
+		uint64_t seen = 0;
+		for (uint32_t bucket = 0; bucket < BucketCount; bucket++)
+		{
+			seen += m_Buckets[bucket];
+			if (seen >= rank)
+				return std::min(GetBucketUpperBound(bucket), m_Max);
+		}
+		return m_Max;
+	}
+
+	double MetricHistogram::GetBucketUpperBound(uint32_t bucket)
+	{
+		if (bucket == 0)
+			return std::ldexp(1.0, MinExponent);
+
+		int32_t exponent = (int32_t)((bucket - 1) / SubBuckets) + MinExponent;
+		uint32_t subBucket = (bucket - 1) % SubBuckets;
+		return std::ldexp(1.0 + (double)(subBucket + 1) / SubBuckets, exponent);
+	}
+
+	void FrameMetrics::BeginSession(const std::string& name)
+	{
+		HZ_CORE_ASSERT(!s_Data.SessionActive, "Frame metrics session already active!");
+
+		s_Data.SessionActive = true;
+		s_Data.SessionName = name;
+		s_Data.Samples.clear();
+		for (auto& histogram : s_Data.Histograms)
+			histogram.Clear();
+	}
+
+	void FrameMetrics::EndSession(const std::string& filepathPrefix)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!s_Data.SessionActive)
+			return;
+		s_Data.SessionActive = false;
+
+		std::ofstream csv(filepathPrefix + ".csv");
+		if (!csv.is_open())
+		{
+			HZ_CORE_ERROR("Could not open frame metrics file '{0}.csv'", filepathPrefix);
+			return;
+		}
+
+		csv << std::setprecision(10) << "frame";
+		for (const char* name : s_MetricNames)
+			csv << ',' << name;
+		csv << '\n';
+		for (size_t frame = 0; frame < s_Data.Samples.size(); frame++)
+		{
+			csv << frame;
+			for (double value : s_Data.Samples[frame])
+				csv << ',' << value;
+			csv << '\n';
+		}
+
+		std::ofstream json(filepathPrefix + ".json");
+		if (!json.is_open())
+		{
+			HZ_CORE_ERROR("Could not open frame metrics file '{0}.json'", filepathPrefix);
+			return;
+		}
+
+		json << std::setprecision(10);
+		json << "{\"session\":\"" << s_Data.SessionName << "\",\"frames\":" << s_Data.Samples.size() << ",\"metrics\":{";
+
+		// Exact percentiles from the raw samples, nearest rank
+		std::vector<double> values(s_Data.Samples.size());
+		for (size_t metric = 0; metric < (size_t)FrameMetric::Count; metric++)
+		{
+			for (size_t frame = 0; frame < s_Data.Samples.size(); frame++)
+				values[frame] = s_Data.Samples[frame][metric];
+			std::sort(values.begin(), values.end());
+
+			auto percentile = [&values](double p)
+			{
+				if (values.empty())
+					return 0.0;
+				size_t rank = std::max<size_t>((size_t)std::ceil(p / 100.0 * values.size()), 1);
+				return values[rank - 1];
+			};
+
+			const MetricHistogram& histogram = s_Data.Histograms[metric];
+			json << (metric ? "," : "") << '"' << s_MetricNames[metric] << "\":{";
+			json << "\"min\":" << histogram.GetMin() << ",\"mean\":" << histogram.GetMean() << ",\"max\":" << histogram.GetMax();
+			json << ",\"p50\":" << percentile(50.0) << ",\"p95\":" << percentile(95.0) << ",\"p99\":" << percentile(99.0);
+
+			// Only the occupied buckets, as [upper bound, samples]
+			json << ",\"histogram\":[";
+			bool first = true;
+			for (uint32_t bucket = 0; bucket < MetricHistogram::BucketCount; bucket++)
+			{
+				if (uint32_t samples = histogram.GetBucketSamples(bucket))
+				{
+					json << (first ? "" : ",") << '[' << MetricHistogram::GetBucketUpperBound(bucket) << ',' << samples << ']';
+					first = false;
+				}
+			}
+			json << "]}";
+		}
+		json << "}}";
+
+		HZ_CORE_INFO("Wrote metrics for {0} frames to '{1}.csv' and '{1}.json'", s_Data.Samples.size(), filepathPrefix);
+	}
+
+	bool FrameMetrics::IsSessionActive()
+	{
+		return s_Data.SessionActive;
+	}
+
+	void FrameMetrics::RecordFrame(const FrameMetricsSample& sample)
+	{
+		if (!s_Data.SessionActive)
+			return;
+
+		s_Data.Samples.push_back(sample);
+		for (size_t metric = 0; metric < (size_t)FrameMetric::Count; metric++)
+			s_Data.Histograms[metric].Add(sample[metric]);
+	}
+
+	FrameMetrics::Summary FrameMetrics::GetSummary(FrameMetric metric)
+	{
+		const MetricHistogram& histogram = GetHistogram(metric);
+
+		Summary summary;
+		summary.Count = histogram.GetCount();
+		summary.Min = histogram.GetMin();
+		summary.Mean = histogram.GetMean();
+		summary.Max = histogram.GetMax();
+		summary.P50 = histogram.GetPercentile(50.0);
+		summary.P95 = histogram.GetPercentile(95.0);
+		summary.P99 = histogram.GetPercentile(99.0);
+		return summary;
+	}
+
+	const MetricHistogram& FrameMetrics::GetHistogram(FrameMetric metric)
+	{
+		return s_Data.Histograms[(size_t)metric];
+	}
+
+	const char* FrameMetrics::GetMetricName(FrameMetric metric)
+	{
+		return s_MetricNames[(size_t)metric];
+	}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace Hazel {
+
+	enum class FrameMetric : uint8_t
+	{
+		FrameTime = 0, // ms
+		UpdateTime,    // ms spent in the layers' OnFixedUpdate and OnUpdate
+		RenderTime,    // ms the render thread spent executing the frame's commands
+		DrawCalls,
+		QuadCount,
+		UploadedBytes, // Vertex data sent to the GPU
+		Allocations,   // Heap allocations, any thread
+		Count
+	};
+
+	using FrameMetricsSample = std::array<double, (size_t)FrameMetric::Count>;
+
+	// Log-linear buckets, every bucket is within 1/SubBuckets of its values. Fixed size, so
+	// adding a sample never allocates and percentiles are available at any point.
+	class MetricHistogram
+	{
+	public:
+		static constexpr int32_t MinExponent = -10; // Smaller values, including zero, share the first bucket
+		static constexpr int32_t MaxExponent = 40;
+		static constexpr uint32_t SubBuckets = 8;
+		static constexpr uint32_t BucketCount = (MaxExponent - MinExponent) * SubBuckets + 1;
+
+		void Add(double value);
+		void Clear();
+
+		// Upper bound of the bucket holding the given percentile, 0 to 100
+		double GetPercentile(double percentile) const;
+
+		uint64_t GetCount() const { return m_Count; }
+		double GetMin() const { return m_Count ? m_Min : 0.0; }
+		double GetMax() const { return m_Count ? m_Max : 0.0; }
+		double GetMean() const { return m_Count ? m_Sum / m_Count : 0.0; }
+
+		uint32_t GetBucketSamples(uint32_t bucket) const { return m_Buckets[bucket]; }
+		static double GetBucketUpperBound(uint32_t bucket);
+	private:
+		std::array<uint32_t, BucketCount> m_Buckets = {};
+		uint64_t m_Count = 0;
+		double m_Sum = 0.0;
+		double m_Min = 0.0, m_Max = 0.0;
+	};
+
+	// Per-frame engine metrics for automated performance runs. Application records a sample
+	// every frame while a session is active; EndSession writes every raw sample to
+	// <prefix>.csv and p50/p95/p99 summaries plus the histograms to <prefix>.json.
+	class FrameMetrics
+	{
+	public:
+		struct Summary
+		{
+			uint64_t Count = 0;
+			double Min = 0.0, Mean = 0.0, Max = 0.0;
+			double P50 = 0.0, P95 = 0.0, P99 = 0.0;
+		};
+
+		static void BeginSession(const std::string& name);
+		static void EndSession(const std::string& filepathPrefix);
+		static bool IsSessionActive();
+
+		static void RecordFrame(const FrameMetricsSample& sample);
+
+		// From the histogram, exact summaries are computed for the export
+		static Summary GetSummary(FrameMetric metric);
+		static const MetricHistogram& GetHistogram(FrameMetric metric);
+
+		static const char* GetMetricName(FrameMetric metric);
+	};
+
+}
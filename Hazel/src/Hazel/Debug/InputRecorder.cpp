@@ -0,0 +1,416 @@
+#include "hzpch.h"
+#include "InputRecorder.h"
+
+#include "Hazel/Events/ApplicationEvent.h"
+#include "Hazel/Events/KeyEvent.h"
+#include "Hazel/Events/MouseEvent.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static constexpr char InputRecordingMagic[4] = { 'H', 'Z', 'I', 'R' };
+		static constexpr uint32_t InputRecordingVersion = 2;
+
+		template<typename T>
+		static void Write(std::vector<uint8_t>& bytes, const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			size_t offset = bytes.size();
+			bytes.resize(offset + sizeof(T));
+			std::memcpy(bytes.data() + offset, &value, sizeof(T));
+		}
+
+		template<typename T>
+		static bool Read(const std::vector<uint8_t>& bytes, size_t& offset, T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (offset + sizeof(T) > bytes.size())
+				return false;
+			std::memcpy(&value, bytes.data() + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+	}
+
+	enum class RecorderMode
+	{
+		None = 0, Recording, Replaying
+	};
+
+	struct InputRecorderData
+	{
+		RecorderMode Mode = RecorderMode::None;
+
+		std::string Filepath;
+		// Recording: the frames written so far. Replaying: the whole file.
+		std::vector<uint8_t> Bytes;
+
+		// The frame being recorded or replayed
+		bool FrameOpen = false;
+		float FrameTimestep = 0.0f;
+		uint16_t FrameEventCount = 0;
+		std::vector<uint8_t> FrameEvents;
+
+		// Replaying
+		size_t Cursor = 0;
+		uint32_t FrameCount = 0;
+		uint32_t FrameIndex = 0;
+		float FixedTimestep = 0.0f;
+		bool Dispatching = false;
+		bool Finished = false;
+
+		InputRecorder::Stats Stats;
+	};
+
+	static InputRecorderData s_Data;
+
+	// Layout: f32 timestep, u16 event count, the events
+	static void WriteFrame()
+	{
+		std::vector<uint8_t>& bytes = s_Data.Bytes;
+		Utils::Write(bytes, s_Data.FrameTimestep);
+		Utils::Write(bytes, s_Data.FrameEventCount);
+		bytes.insert(bytes.end(), s_Data.FrameEvents.begin(), s_Data.FrameEvents.end());
+
+		s_Data.Stats.Frames++;
+		s_Data.Stats.Events += s_Data.FrameEventCount;
+		s_Data.Stats.Bytes = bytes.size();
+	}
+
+	// Leaves the events in FrameEvents for DispatchEvents
+	static bool ReadFrame()
+	{
+		const std::vector<uint8_t>& bytes = s_Data.Bytes;
+		size_t& cursor = s_Data.Cursor;
+
+		if (!Utils::Read(bytes, cursor, s_Data.FrameTimestep) || !Utils::Read(bytes, cursor, s_Data.FrameEventCount))
+			return false;
+
+		// Events are skipped over here and decoded when they are dispatched
+		size_t eventsStart = cursor;
+		for (uint16_t i = 0; i < s_Data.FrameEventCount; i++)
+		{
+			uint8_t type;
+			if (!Utils::Read(bytes, cursor, type))
+				return false;
+			switch ((EventType)type)
+			{
+				case EventType::KeyPressed:          cursor += 2 * sizeof(uint16_t); break;
+				case EventType::KeyReleased:
+				case EventType::KeyTyped:
+				case EventType::MouseButtonPressed:
+				case EventType::MouseButtonReleased: cursor += sizeof(uint16_t); break;
+				case EventType::MouseMoved:
+				case EventType::MouseScrolled:       cursor += 2 * sizeof(float); break;
+				case EventType::WindowResize:        cursor += 2 * sizeof(uint32_t); break;
+				case EventType::WindowClose:         break;
+				default:                             return false;
+			}
+		}
+		if (cursor > bytes.size())
+			return false;
+		s_Data.FrameEvents.assign(bytes.begin() + eventsStart, bytes.begin() + cursor);
+		return true;
+	}
+
+	void InputRecorder::BeginRecording(const std::string& filepath)
+	{
+		HZ_CORE_ASSERT(s_Data.Mode == RecorderMode::None, "InputRecorder is already recording or replaying!");
+
+		s_Data = InputRecorderData();
+		s_Data.Mode = RecorderMode::Recording;
+		s_Data.Filepath = filepath;
+	}
+
+	void InputRecorder::EndRecording()
+	{
+		if (s_Data.Mode != RecorderMode::Recording)
+			return;
+
+		if (s_Data.FrameOpen)
+			WriteFrame();
+		s_Data.Mode = RecorderMode::None;
+
+		std::ofstream file(s_Data.Filepath, std::ios::binary);
+		if (!file)
+		{
+			HZ_CORE_ERROR("Could not open input recording file '{0}'", s_Data.Filepath);
+			return;
+		}
+		file.write(Utils::InputRecordingMagic, sizeof(Utils::InputRecordingMagic));
+		file.write((const char*)&Utils::InputRecordingVersion, sizeof(uint32_t));
+		file.write((const char*)&s_Data.Stats.Frames, sizeof(uint32_t));
+		file.write((const char*)s_Data.Bytes.data(), s_Data.Bytes.size());
+
+		HZ_CORE_INFO("Recorded {0} frames of input to '{1}' ({2} events, {3} bytes)",
+			s_Data.Stats.Frames, s_Data.Filepath, s_Data.Stats.Events, s_Data.Stats.Bytes);
+	}
+
+	bool InputRecorder::IsRecording()
+	{
+		return s_Data.Mode == RecorderMode::Recording;
+	}
+
+	bool InputRecorder::BeginReplay(const std::string& filepath, float fixedTimestep)
+	{
+		HZ_CORE_ASSERT(s_Data.Mode == RecorderMode::None, "InputRecorder is already recording or replaying!");
+
+		s_Data = InputRecorderData();
+		s_Data.Filepath = filepath;
+		s_Data.FixedTimestep = fixedTimestep;
+
+		std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			HZ_CORE_ERROR("Could not open input recording file '{0}'", filepath);
+			return false;
+		}
+		s_Data.Bytes.resize((size_t)file.tellg());
+		file.seekg(0);
+		file.read((char*)s_Data.Bytes.data(), s_Data.Bytes.size());
+
+		char magic[4];
+		uint32_t version;
+		size_t& cursor = s_Data.Cursor;
+		if (!Utils::Read(s_Data.Bytes, cursor, magic) || std::memcmp(magic, Utils::InputRecordingMagic, sizeof(magic)) != 0
+			|| !Utils::Read(s_Data.Bytes, cursor, version) || version != Utils::InputRecordingVersion
+			|| !Utils::Read(s_Data.Bytes, cursor, s_Data.FrameCount))
+		{
+			HZ_CORE_ERROR("'{0}' is not an input recording this version can replay", filepath);
+			s_Data.Bytes.clear();
+			return false;
+		}
+
+		s_Data.Mode = RecorderMode::Replaying;
+		s_Data.Stats.Bytes = s_Data.Bytes.size();
+		return true;
+	}
+
+	void InputRecorder::EndReplay()
+	{
+		if (s_Data.Mode != RecorderMode::Replaying)
+			return;
+
+		s_Data.Mode = RecorderMode::None;
+		s_Data.Bytes.clear();
+	}
+
+	bool InputRecorder::IsReplaying()
+	{
+		return s_Data.Mode == RecorderMode::Replaying;
+	}
+
+	bool InputRecorder::IsReplayFinished()
+	{
+		return s_Data.Mode == RecorderMode::Replaying && s_Data.Finished;
+	}
+
+	Timestep InputRecorder::NextFrame(Timestep timestep)
+	{
+		if (s_Data.Mode == RecorderMode::Recording)
+		{
+			if (s_Data.FrameOpen)
+				WriteFrame();
+
+			s_Data.FrameOpen = true;
+			s_Data.FrameTimestep = timestep;
+			s_Data.FrameEventCount = 0;
+			s_Data.FrameEvents.clear();
+			return timestep;
+		}
+
+		if (s_Data.Mode == RecorderMode::Replaying)
+		{
+			if (s_Data.Finished || s_Data.FrameIndex == s_Data.FrameCount || !ReadFrame())
+			{
+				if (!s_Data.Finished && s_Data.FrameIndex != s_Data.FrameCount)
+					HZ_CORE_ERROR("Input recording '{0}' is cut short after {1} frames", s_Data.Filepath, s_Data.FrameIndex);
+
+				// Runs out with an empty frame until the application stops
+				s_Data.Finished = true;
+				s_Data.FrameEventCount = 0;
+				s_Data.FrameEvents.clear();
+				return s_Data.FixedTimestep > 0.0f ? s_Data.FixedTimestep : (float)timestep;
+			}
+
+			s_Data.FrameIndex++;
+			s_Data.Finished = s_Data.FrameIndex == s_Data.FrameCount;
+			s_Data.Stats.Frames++;
+			s_Data.Stats.Events += s_Data.FrameEventCount;
+			return s_Data.FixedTimestep > 0.0f ? s_Data.FixedTimestep : s_Data.FrameTimestep;
+		}
+
+		return timestep;
+	}
+
+	bool InputRecorder::OnEvent(Event& e)
+	{
+		if (s_Data.Mode == RecorderMode::Replaying)
+			return !s_Data.Dispatching && e.IsInCategory(EventCategoryInput);
+
+		// Events from before the first frame belong to startup and are left out
+		if (s_Data.Mode != RecorderMode::Recording || !s_Data.FrameOpen)
+			return false;
+
+		std::vector<uint8_t>& bytes = s_Data.FrameEvents;
+		EventType type = e.GetEventType();
+		switch (type)
+		{
+			case EventType::KeyPressed:
+			{
+				auto& event = static_cast<KeyPressedEvent&>(e);
+				Utils::Write(bytes, (uint8_t)type);
+				Utils::Write(bytes, (uint16_t)event.GetKeyCode());
+				Utils::Write(bytes, event.GetRepeatCount());
+				break;
+			}
+			case EventType::KeyReleased:
+			case EventType::KeyTyped:
+				Utils::Write(bytes, (uint8_t)type);
+				Utils::Write(bytes, (uint16_t)static_cast<KeyEvent&>(e).GetKeyCode());
+				break;
+			case EventType::MouseButtonPressed:
+			case EventType::MouseButtonReleased:
+				Utils::Write(bytes, (uint8_t)type);
+				Utils::Write(bytes, (uint16_t)static_cast<MouseButtonEvent&>(e).GetMouseButton());
+				break;
+			case EventType::MouseMoved:
+			{
+				auto& event = static_cast<MouseMovedEvent&>(e);
+				Utils::Write(bytes, (uint8_t)type);
+				Utils::Write(bytes, event.GetX());
+				Utils::Write(bytes, event.GetY());
+				break;
+			}
+			case EventType::MouseScrolled:
+			{
+				auto& event = static_cast<MouseScrolledEvent&>(e);
+				Utils::Write(bytes, (uint8_t)type);
+				Utils::Write(bytes, event.GetXOffset());
+				Utils::Write(bytes, event.GetYOffset());
+				break;
+			}
+			case EventType::WindowResize:
+			{
+				auto& event = static_cast<WindowResizeEvent&>(e);
+				Utils::Write(bytes, (uint8_t)type);
+				Utils::Write(bytes, (uint32_t)event.GetWidth());
+				Utils::Write(bytes, (uint32_t)event.GetHeight());
+				break;
+			}
+			case EventType::WindowClose:
+				Utils::Write(bytes, (uint8_t)type);
+				break;
+			default:
+				return false;
+		}
+		s_Data.FrameEventCount++;
+		return false;
+	}
+
+	void InputRecorder::DispatchEvents(const std::function<void(Event&)>& callback)
+	{
+		if (s_Data.Mode != RecorderMode::Replaying || s_Data.FrameEventCount == 0)
+			return;
+
+		const std::vector<uint8_t>& bytes = s_Data.FrameEvents;
+		size_t cursor = 0;
+		s_Data.Dispatching = true;
+		for (uint16_t i = 0; i < s_Data.FrameEventCount; i++)
+		{
+			uint8_t type;
+			Utils::Read(bytes, cursor, type);
+			switch ((EventType)type)
+			{
+				case EventType::KeyPressed:
+				{
+					uint16_t key, repeatCount;
+					Utils::Read(bytes, cursor, key);
+					Utils::Read(bytes, cursor, repeatCount);
+					KeyPressedEvent event((KeyCode)key, repeatCount);
+					callback(event);
+					break;
+				}
+				case EventType::KeyReleased:
+				{
+					uint16_t key;
+					Utils::Read(bytes, cursor, key);
+					KeyReleasedEvent event((KeyCode)key);
+					callback(event);
+					break;
+				}
+				case EventType::KeyTyped:
+				{
+					uint16_t key;
+					Utils::Read(bytes, cursor, key);
+					KeyTypedEvent event((KeyCode)key);
+					callback(event);
+					break;
+				}
+				case EventType::MouseButtonPressed:
+				{
+					uint16_t button;
+					Utils::Read(bytes, cursor, button);
+					MouseButtonPressedEvent event((MouseCode)button);
+					callback(event);
+					break;
+				}
+				case EventType::MouseButtonReleased:
+				{
+					uint16_t button;
+					Utils::Read(bytes, cursor, button);
+					MouseButtonReleasedEvent event((MouseCode)button);
+					callback(event);
+					break;
+				}
+				case EventType::MouseMoved:
+				{
+					float x, y;
+					Utils::Read(bytes, cursor, x);
+					Utils::Read(bytes, cursor, y);
+					MouseMovedEvent event(x, y);
+					callback(event);
+					break;
+				}
+				case EventType::MouseScrolled:
+				{
+					float xOffset, yOffset;
+					Utils::Read(bytes, cursor, xOffset);
+					Utils::Read(bytes, cursor, yOffset);
+					MouseScrolledEvent event(xOffset, yOffset);
+					callback(event);
+					break;
+				}
+				case EventType::WindowResize:
+				{
+					uint32_t width, height;
+					Utils::Read(bytes, cursor, width);
+					Utils::Read(bytes, cursor, height);
+					WindowResizeEvent event(width, height);
+					callback(event);
+					break;
+				}
+				case EventType::WindowClose:
+				{
+					WindowCloseEvent event;
+					callback(event);
+					break;
+				}
+				default:
+					break;
+			}
+		}
+		s_Data.Dispatching = false;
+	}
+
+	InputRecorder::Stats InputRecorder::GetStats()
+	{
+		return s_Data.Stats;
+	}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+#include "Hazel/Core/Timestep.h"
+#include "Hazel/Events/Event.h"
+
+#include <functional>
+#include <string>
+
+namespace Hazel {
+
+	// Records what a run's frames depended on, so a performance run can be repeated frame for
+	// frame: the timestep and the input events reaching Application::OnEvent. Input builds its
+	// state from those same events, so a replay answers the Input queries the way the recorded
+	// run did. A replay feeds them back, with the recorded timesteps or a fixed one, and ignores
+	// live input.
+	//
+	// The file is binary: a header, then per frame the timestep and its events. ImGui reads GLFW
+	// on its own and is not part of a recording.
+	class InputRecorder
+	{
+	public:
+		static void BeginRecording(const std::string& filepath);
+		static void EndRecording();
+		static bool IsRecording();
+
+		// A fixed timestep of zero replays the recorded ones
+		static bool BeginReplay(const std::string& filepath, float fixedTimestep = 0.0f);
+		static void EndReplay();
+		static bool IsReplaying();
+		static bool IsReplayFinished();
+
+		// Called by Application at the start of a frame with the measured timestep, returns
+		// the one to use
+		static Timestep NextFrame(Timestep timestep);
+		// Recording: stores input events. Replaying: returns whether a live event has to be
+		// dropped, input events only come from the recording.
+		static bool OnEvent(Event& e);
+		// Replaying: dispatches the events the recorded frame received, where the window would have
+		static void DispatchEvents(const std::function<void(Event&)>& callback);
+
+		struct Stats
+		{
+			uint32_t Frames = 0;
+			uint32_t Events = 0;
+			uint64_t Bytes = 0;
+		};
+		static Stats GetStats();
+	};
+
+}
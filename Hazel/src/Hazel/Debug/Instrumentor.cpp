@@ -0,0 +1,533 @@
+#include "hzpch.h"
+#include "Instrumentor.h"
+
+#include <charconv>
+#include <cstdio>
+
+namespace Hazel {
+
+	static constexpr auto WriterInterval = std::chrono::milliseconds(5);
+
+	static int64_t SteadyNanoseconds(std::chrono::steady_clock::time_point time)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+	}
+
+	static void AppendInteger(std::string& json, int64_t value)
+	{
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), value);
+		json.append(digits, result.ptr);
+	}
+
+	// Nanoseconds as microseconds with three decimals, without going through printf
+	static void AppendMicroseconds(std::string& json, int64_t nanoseconds)
+	{
+		if (nanoseconds < 0)
+		{
+			json += '-';
+			nanoseconds = -nanoseconds;
+		}
+
+		AppendInteger(json, nanoseconds / 1000);
+		int64_t fraction = nanoseconds % 1000;
+		char decimals[4] = { '.', (char)('0' + fraction / 100), (char)('0' + fraction / 10 % 10), (char)('0' + fraction % 10) };
+		json.append(decimals, sizeof(decimals));
+	}
+
+	// Chrome trace "complete" event. The writer formats a few hundred thousand of these per frame
+	// in heavily profiled builds, so this avoids printf.
+	static void AppendCompleteEvent(std::string& json, std::string_view name, uint32_t threadIndex, int64_t start, int64_t duration)
+	{
+		json += ",{\"cat\":\"function\",\"dur\":";
+		AppendMicroseconds(json, duration);
+		json += ",\"name\":\"";
+		json += name;
+		json += "\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+		AppendInteger(json, threadIndex);
+		json += ",\"ts\":";
+		AppendMicroseconds(json, start);
+		json += '}';
+	}
+
+	Instrumentor::~Instrumentor()
+	{
+		EndSession();
+	}
+
+	void Instrumentor::BeginSession(const std::string& name, const std::string& filepath)
+	{
+		std::lock_guard lock(m_Mutex);
+		InternalBeginSession(name);
+
+		m_OutputStream.open(filepath);
+		if (!m_OutputStream.is_open()) {
+			if (Log::GetCoreLogger()) { // Edge case: BeginSession() might be before Log::Init()
+				HZ_CORE_ERROR("Instrumentor could not open results file '{0}'.", filepath);
+			}
+			return;
+		}
+
+		m_FlightRecorderActive = false;
+		m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
+
+		StartWriter();
+	}
+
+	void Instrumentor::BeginFlightRecorder(const std::string& name, const FlightRecorderSpecification& specification)
+	{
+		std::lock_guard lock(m_Mutex);
+		InternalBeginSession(name);
+
+		m_FlightRecorderActive = true;
+		m_FlightRecorderSpec = specification;
+		m_SpikeThresholdTicks = (uint64_t)(specification.SpikeThresholdMilliseconds * 1000000.0 / m_NanosecondsPerTick);
+		m_FlightRecords.clear();
+		m_FlightFrames.clear();
+		m_FramesUntilDump = -1;
+		m_DumpRequested = false;
+
+		StartWriter();
+	}
+
+	void Instrumentor::EndSession()
+	{
+		std::lock_guard lock(m_Mutex);
+		InternalEndSession();
+	}
+
+	// Note: you must already own lock on m_Mutex before calling InternalBeginSession()
+	void Instrumentor::InternalBeginSession(const std::string& name)
+	{
+		if (m_SessionActive) {
+			// If there is already a current session, then close it before beginning new one.
+			// Subsequent profiling output meant for the original session will end up in the
+			// newly opened session instead.  That's better than having badly formatted
+			// profiling output.
+			if (Log::GetCoreLogger()) { // Edge case: BeginSession() might be before Log::Init()
+				HZ_CORE_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_SessionName);
+			}
+			InternalEndSession();
+		}
+
+		m_SessionName = name;
+		m_LastFrameMark = 0;
+		CalibrateClock();
+	}
+
+	// Note: you must already own lock on m_Mutex before calling StartWriter()
+	void Instrumentor::StartWriter()
+	{
+		// Throw away whatever raced with the end of the previous session
+		{
+			std::lock_guard buffersLock(m_BuffersMutex);
+			for (auto& buffer : m_ThreadBuffers)
+				buffer->Drain([](const ProfileRecord&) {});
+		}
+		{
+			std::lock_guard pendingLock(m_PendingMutex);
+			m_PendingEvents.clear();
+		}
+		{
+			std::lock_guard frameLock(m_FrameMutex);
+			m_NewFrames.clear();
+		}
+		m_LiveRecords.clear();
+		m_LiveFrameMarks.clear();
+		m_DroppedAtSessionStart = GetDroppedRecordCount();
+
+		m_StopWriter = false;
+		m_WriterThread = std::thread(&Instrumentor::WriterThread, this);
+		m_SessionActive.store(true, std::memory_order_release);
+	}
+
+	// Note: you must already own lock on m_Mutex before calling InternalEndSession()
+	void Instrumentor::InternalEndSession()
+	{
+		if (!m_SessionActive)
+			return;
+
+		m_SessionActive.store(false, std::memory_order_release);
+
+		// The writer drains everything once more before it exits
+		{
+			std::lock_guard writerLock(m_WriterMutex);
+			m_StopWriter = true;
+		}
+		m_WriterCondition.notify_one();
+		m_WriterThread.join();
+
+		uint64_t dropped = GetDroppedRecordCount() - m_DroppedAtSessionStart;
+		if (dropped && Log::GetCoreLogger())
+			HZ_CORE_WARN("Instrumentor dropped {0} records in session '{1}'", dropped, m_SessionName);
+
+		if (m_FlightRecorderActive)
+		{
+			// A spike right before shutdown still gets its dump, with fewer frames after it
+			if (m_FramesUntilDump >= 0 || m_DumpRequested.exchange(false))
+				WriteFlightRecord();
+
+			m_FlightRecorderActive = false;
+			m_FlightRecords = {};
+			m_FlightFrames = {};
+			return;
+		}
+
+		m_OutputStream << "]}";
+		m_OutputStream.close();
+	}
+
+	void Instrumentor::MarkFrame()
+	{
+		if (!m_SessionActive.load(std::memory_order_acquire))
+			return;
+
+		uint64_t now = Now();
+		if (m_LastFrameMark != 0 && (m_FlightRecorderActive || m_LiveCaptureEnabled.load(std::memory_order_relaxed)))
+		{
+			{
+				std::lock_guard lock(m_FrameMutex);
+				m_NewFrames.push_back({ m_LastFrameMark, now });
+			}
+
+			if (m_FlightRecorderActive && now - m_LastFrameMark > m_SpikeThresholdTicks)
+				m_DumpRequested.store(true, std::memory_order_relaxed);
+		}
+		m_LastFrameMark = now;
+	}
+
+	void Instrumentor::RequestFlightRecorderDump()
+	{
+		m_DumpRequested.store(true, std::memory_order_relaxed);
+	}
+
+	void Instrumentor::SetLiveCaptureEnabled(bool enabled)
+	{
+		m_LiveCaptureEnabled.store(enabled, std::memory_order_relaxed);
+		if (!enabled)
+		{
+			std::lock_guard lock(m_LiveMutex);
+			m_LiveFrames.clear();
+		}
+	}
+
+	void Instrumentor::ConsumeLiveFrames(std::vector<ProfileFrame>& frames)
+	{
+		std::lock_guard lock(m_LiveMutex);
+		for (ProfileFrame& frame : m_LiveFrames)
+			frames.push_back(std::move(frame));
+		m_LiveFrames.clear();
+	}
+
+	const char* Instrumentor::InternName(std::string_view name)
+	{
+		std::lock_guard lock(m_InternMutex);
+		return m_InternedNames.emplace(name).first->c_str();
+	}
+
+	void Instrumentor::WriteDynamicProfile(std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::duration duration)
+	{
+		if (!IsSessionActive())
+			return;
+
+		uint32_t threadIndex = GetThreadBuffer().GetThreadIndex();
+		int64_t durationNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+		std::lock_guard lock(m_PendingMutex);
+		AppendCompleteEvent(m_PendingEvents, name, threadIndex, SteadyNanoseconds(start), durationNanoseconds);
+	}
+
+	void Instrumentor::WriteCounter(std::string_view name, const CounterValue* values, uint32_t count)
+	{
+		if (!IsSessionActive())
+			return;
+
+		char number[32];
+		int64_t timestamp = SteadyNanoseconds(std::chrono::steady_clock::now());
+
+		std::lock_guard lock(m_PendingMutex);
+		m_PendingEvents += ",{\"cat\":\"counter\",\"name\":\"";
+		m_PendingEvents += name;
+		m_PendingEvents += "\",\"ph\":\"C\",\"pid\":0,\"ts\":";
+		AppendMicroseconds(m_PendingEvents, timestamp);
+		m_PendingEvents += ",\"args\":{";
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (i > 0)
+				m_PendingEvents += ',';
+			m_PendingEvents += '"';
+			m_PendingEvents += values[i].Name;
+			m_PendingEvents += "\":";
+			m_PendingEvents.append(number, std::snprintf(number, sizeof(number), "%.0f", values[i].Value));
+		}
+		m_PendingEvents += "}}";
+	}
+
+	uint64_t Instrumentor::GetDroppedRecordCount()
+	{
+		std::lock_guard lock(m_BuffersMutex);
+
+		uint64_t dropped = 0;
+		for (auto& buffer : m_ThreadBuffers)
+			dropped += buffer->GetDroppedCount();
+		return dropped;
+	}
+
+	void Instrumentor::CalibrateClock()
+	{
+		m_BaseTicks = Now();
+		auto baseTime = std::chrono::steady_clock::now();
+		m_BaseNanoseconds = SteadyNanoseconds(baseTime);
+
+	#if HZ_PROFILE_USE_TSC
+		// The TSC rate never changes, so measuring it once per run is enough
+		static double nanosecondsPerTick = 0.0;
+		if (nanosecondsPerTick == 0.0)
+		{
+			auto end = baseTime + std::chrono::milliseconds(20);
+			auto now = baseTime;
+			while (now < end)
+				now = std::chrono::steady_clock::now();
+			uint64_t ticks = Now() - m_BaseTicks;
+			nanosecondsPerTick = (double)(SteadyNanoseconds(now) - m_BaseNanoseconds) / ticks;
+		}
+		m_NanosecondsPerTick = nanosecondsPerTick;
+	#else
+		m_NanosecondsPerTick = 1.0;
+	#endif
+	}
+
+	int64_t Instrumentor::TicksToNanoseconds(uint64_t ticks) const
+	{
+		// Signed, a scope can start before the session does
+		return m_BaseNanoseconds + (int64_t)(((int64_t)(ticks - m_BaseTicks)) * m_NanosecondsPerTick);
+	}
+
+	ProfileThreadBuffer* Instrumentor::RegisterThread()
+	{
+		// Buffers are never freed, a thread may exit while the writer still drains it
+		std::lock_guard lock(m_BuffersMutex);
+		m_ThreadBuffers.push_back(std::make_unique<ProfileThreadBuffer>((uint32_t)m_ThreadBuffers.size()));
+		return m_ThreadBuffers.back().get();
+	}
+
+	void Instrumentor::WriterThread()
+	{
+		std::string json;
+		json.reserve(1024 * 1024);
+		std::vector<FrameMark> frames;
+
+		bool stop = false;
+		while (!stop)
+		{
+			{
+				std::unique_lock lock(m_WriterMutex);
+				m_WriterCondition.wait_for(lock, WriterInterval, [this]() { return m_StopWriter; });
+				stop = m_StopWriter;
+			}
+
+			if (m_FlightRecorderActive)
+				UpdateFlightRecorder(frames);
+			else
+				Flush(json, frames);
+
+			UpdateLiveCapture(frames);
+		}
+	}
+
+	// Taken after the buffers are drained, so a frame's own records are in before its mark shows up
+	void Instrumentor::TakeNewFrames(std::vector<FrameMark>& frames)
+	{
+		frames.clear();
+
+		std::lock_guard lock(m_FrameMutex);
+		frames.swap(m_NewFrames);
+	}
+
+	void Instrumentor::Flush(std::string& json, std::vector<FrameMark>& frames)
+	{
+		json.clear();
+
+		{
+			bool live = m_LiveCaptureEnabled.load(std::memory_order_relaxed);
+
+			std::lock_guard lock(m_BuffersMutex);
+			for (auto& buffer : m_ThreadBuffers)
+			{
+				uint32_t threadIndex = buffer->GetThreadIndex();
+				buffer->Drain([this, &json, threadIndex, live](const ProfileRecord& record)
+				{
+					int64_t duration = (int64_t)(record.Duration * m_NanosecondsPerTick);
+					AppendCompleteEvent(json, record.Name, threadIndex, TicksToNanoseconds(record.Start), duration);
+
+					if (live)
+						m_LiveRecords.push_back({ record, threadIndex });
+				});
+			}
+		}
+		TakeNewFrames(frames);
+
+		{
+			std::lock_guard lock(m_PendingMutex);
+			json += m_PendingEvents;
+			m_PendingEvents.clear();
+		}
+
+		if (!json.empty())
+			m_OutputStream.write(json.data(), json.size());
+	}
+
+	void Instrumentor::UpdateFlightRecorder(std::vector<FrameMark>& frames)
+	{
+		{
+			bool live = m_LiveCaptureEnabled.load(std::memory_order_relaxed);
+
+			std::lock_guard lock(m_BuffersMutex);
+			for (auto& buffer : m_ThreadBuffers)
+			{
+				uint32_t threadIndex = buffer->GetThreadIndex();
+				buffer->Drain([this, threadIndex, live](const ProfileRecord& record)
+				{
+					m_FlightRecords.push_back({ record, threadIndex });
+
+					if (live)
+						m_LiveRecords.push_back({ record, threadIndex });
+				});
+			}
+		}
+		TakeNewFrames(frames);
+
+		// Dynamic events and counters are already text, they aren't kept around
+		{
+			std::lock_guard lock(m_PendingMutex);
+			m_PendingEvents.clear();
+		}
+
+		for (const FrameMark& frame : frames)
+		{
+			m_FlightFrames.push_back(frame);
+			if (m_FramesUntilDump > 0 && --m_FramesUntilDump == 0)
+				WriteFlightRecord();
+		}
+
+		if (m_DumpRequested.exchange(false, std::memory_order_relaxed) && m_FramesUntilDump < 0)
+		{
+			m_FramesUntilDump = (int32_t)m_FlightRecorderSpec.FramesAfterSpike;
+			if (m_FramesUntilDump == 0)
+				WriteFlightRecord();
+		}
+
+		// Enough history that a dump written FramesAfterSpike frames from now still reaches back
+		// FramesBeforeSpike frames before the spike
+		size_t framesToKeep = (size_t)m_FlightRecorderSpec.FramesBeforeSpike + m_FlightRecorderSpec.FramesAfterSpike + 1;
+		while (m_FlightFrames.size() > framesToKeep)
+			m_FlightFrames.pop_front();
+
+		// Records arrive roughly in the order they ended, so the old ones are at the front
+		if (!m_FlightFrames.empty())
+		{
+			uint64_t windowStart = m_FlightFrames.front().Start;
+			while (!m_FlightRecords.empty() && m_FlightRecords.front().Record.Start + m_FlightRecords.front().Record.Duration < windowStart)
+				m_FlightRecords.pop_front();
+		}
+		while (m_FlightRecords.size() > m_FlightRecorderSpec.MaxRecords)
+			m_FlightRecords.pop_front();
+	}
+
+	void Instrumentor::WriteFlightRecord()
+	{
+		m_FramesUntilDump = -1;
+
+		std::string filepath = m_FlightRecorderSpec.FilepathPrefix + "-" + std::to_string(++m_DumpCount) + ".json";
+		std::ofstream stream(filepath);
+		if (!stream.is_open())
+		{
+			if (Log::GetCoreLogger())
+				HZ_CORE_ERROR("Instrumentor could not open flight recorder file '{0}'.", filepath);
+			return;
+		}
+
+		// Frames get a track of their own, so the spike is easy to find
+		constexpr uint32_t frameTrackIndex = 0xFFFF;
+		std::string json = "{\"otherData\": {},\"traceEvents\":[{}";
+		json += ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+		AppendInteger(json, frameTrackIndex);
+		json += ",\"args\":{\"name\":\"Frames\"}}";
+
+		uint64_t windowStart = m_FlightFrames.empty() ? 0 : m_FlightFrames.front().Start;
+		for (const FrameMark& frame : m_FlightFrames)
+		{
+			uint64_t duration = frame.End - frame.Start;
+			AppendCompleteEvent(json, duration > m_SpikeThresholdTicks ? "Frame (spike)" : "Frame", frameTrackIndex,
+				TicksToNanoseconds(frame.Start), (int64_t)(duration * m_NanosecondsPerTick));
+		}
+
+		for (const ThreadRecord& flightRecord : m_FlightRecords)
+		{
+			const ProfileRecord& record = flightRecord.Record;
+			if (record.Start + record.Duration < windowStart)
+				continue;
+
+			AppendCompleteEvent(json, record.Name, flightRecord.ThreadIndex, TicksToNanoseconds(record.Start), (int64_t)(record.Duration * m_NanosecondsPerTick));
+		}
+
+		json += "]}";
+		stream.write(json.data(), json.size());
+
+		if (Log::GetCoreLogger())
+			HZ_CORE_WARN("Instrumentor flight recorder wrote {0} frames to '{1}'", m_FlightFrames.size(), filepath);
+	}
+
+	void Instrumentor::UpdateLiveCapture(const std::vector<FrameMark>& frames)
+	{
+		if (!m_LiveCaptureEnabled.load(std::memory_order_relaxed))
+		{
+			m_LiveRecords.clear();
+			m_LiveFrameMarks.clear();
+			return;
+		}
+
+		m_LiveFrameMarks.insert(m_LiveFrameMarks.end(), frames.begin(), frames.end());
+
+		// A frame is handed out once the next one is marked too, by then the render thread and
+		// the job workers have had a frame's time to push what they did during it
+		while (m_LiveFrameMarks.size() >= 2)
+		{
+			FrameMark mark = m_LiveFrameMarks.front();
+			m_LiveFrameMarks.pop_front();
+
+			ProfileFrame frame;
+			frame.Index = m_LiveFrameIndex++;
+			frame.Start = TicksToNanoseconds(mark.Start);
+			frame.Duration = (int64_t)((mark.End - mark.Start) * m_NanosecondsPerTick);
+
+			// Records that started during the frame move out, earlier ones belong to no frame we still have
+			auto remaining = m_LiveRecords.begin();
+			for (const ThreadRecord& threadRecord : m_LiveRecords)
+			{
+				const ProfileRecord& record = threadRecord.Record;
+				if (record.Start >= mark.End)
+					*remaining++ = threadRecord;
+				else if (record.Start >= mark.Start)
+					frame.Events.push_back({ record.Name, TicksToNanoseconds(record.Start), (int64_t)(record.Duration * m_NanosecondsPerTick), threadRecord.ThreadIndex });
+			}
+			m_LiveRecords.erase(remaining, m_LiveRecords.end());
+
+			std::sort(frame.Events.begin(), frame.Events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+			{
+				if (a.ThreadIndex != b.ThreadIndex)
+					return a.ThreadIndex < b.ThreadIndex;
+				if (a.Start != b.Start)
+					return a.Start < b.Start;
+				return a.Duration > b.Duration;
+			});
+
+			std::lock_guard lock(m_LiveMutex);
+			m_LiveFrames.push_back(std::move(frame));
+			// Nobody is consuming, keep the newest
+			if (m_LiveFrames.size() > MaxLiveFrames)
+				m_LiveFrames.pop_front();
+		}
+	}
+
+}
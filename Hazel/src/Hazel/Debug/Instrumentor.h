@@ -1,92 +1,187 @@
 #pragma once
 
-#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
-#include <iomanip>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_set>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+	#define HZ_PROFILE_USE_TSC 1
+#else
+	#define HZ_PROFILE_USE_TSC 0
+#endif
 
 namespace Hazel {
 
-	using FloatingPointMicroseconds = std::chrono::duration<double, std::micro>;
+	// What a profiled scope costs: one fixed-size record, no formatting, no locks
+	struct ProfileRecord
+	{
+		const char* Name; // Not copied: a literal or an Instrumentor::InternName pointer
+		uint64_t Start;   // Instrumentor::Now() ticks
+		uint64_t Duration;
+	};
 
-	struct ProfileResult
+	struct CounterValue
 	{
-		std::string Name;
+		std::string_view Name;
+		double Value;
+	};
 
-		FloatingPointMicroseconds Start;
-		std::chrono::microseconds ElapsedTime;
-		std::thread::id ThreadID;
+	// A scope as the live capture hands it out, times are steady_clock nanoseconds
+	struct ProfileEvent
+	{
+		const char* Name; // Valid until the process ends, viewers may keep it as long as they like
+		int64_t Start;
+		int64_t Duration;
+		uint32_t ThreadIndex;
 	};
 
-	struct InstrumentationSession
+	struct ProfileFrame
 	{
-		std::string Name;
+		uint64_t Index = 0;
+		int64_t Start = 0;
+		int64_t Duration = 0;
+		// Scopes that started during the frame, sorted by thread, then start time, then longest first
+		std::vector<ProfileEvent> Events;
 	};
 
-	class Instrumentor
+	struct FlightRecorderSpecification
+	{
+		// Each dump goes to <FilepathPrefix>-<n>.json
+		std::string FilepathPrefix = "HazelFlightRecord";
+		uint32_t FramesBeforeSpike = 60;
+		uint32_t FramesAfterSpike = 10;
+		float SpikeThresholdMilliseconds = 50.0f;
+		// Upper bound on buffered records (24 bytes each), for frames that record far more than usual
+		uint32_t MaxRecords = 1 << 21;
+	};
+
+	// Single-producer/single-consumer ring. The owning thread pushes, the writer thread drains.
+	class ProfileThreadBuffer
 	{
 	public:
-		Instrumentor(const Instrumentor&) = delete;
-		Instrumentor(Instrumentor&&) = delete;
+		static constexpr uint32_t Capacity = 1 << 16;
 
-		void BeginSession(const std::string& name, const std::string& filepath = "results.json")
+		explicit ProfileThreadBuffer(uint32_t threadIndex)
+			: m_Records(new ProfileRecord[Capacity]), m_ThreadIndex(threadIndex)
 		{
-			std::lock_guard lock(m_Mutex);
-			if (m_CurrentSession) {
-				// If there is already a current session, then close it before beginning new one.
-				// Subsequent profiling output meant for the original session will end up in the
-				// newly opened session instead.  That's better than having badly formatted
-				// profiling output.
-				if (Log::GetCoreLogger()) { // Edge case: BeginSession() might be before Log::Init()
-					HZ_CORE_ERROR("Instrumentor::BeginSession('{0}') when session '{1}' already open.", name, m_CurrentSession->Name);
-				}
-				InternalEndSession();
-			}
-			m_OutputStream.open(filepath);
+		}
 
-			if (m_OutputStream.is_open()) {
-				m_CurrentSession = new InstrumentationSession({ name });
-				WriteHeader();
-			}
-			else {
-				if (Log::GetCoreLogger()) { // Edge case: BeginSession() might be before Log::Init()
-					HZ_CORE_ERROR("Instrumentor could not open results file '{0}'.", filepath);
+		void Push(const ProfileRecord& record)
+		{
+			uint32_t head = m_Head.load(std::memory_order_relaxed);
+			if (head - m_CachedTail == Capacity)
+			{
+				// Only look at the writer's cache line when the buffer seems full
+				m_CachedTail = m_Tail.load(std::memory_order_acquire);
+				if (head - m_CachedTail == Capacity)
+				{
+					// The writer fell behind, losing records beats stalling the profiled thread
+					m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+					return;
 				}
 			}
+
+			m_Records[head & (Capacity - 1)] = record;
+			m_Head.store(head + 1, std::memory_order_release);
 		}
 
-		void EndSession()
+		template<typename F>
+		void Drain(const F& func)
+		{
+			uint32_t tail = m_Tail.load(std::memory_order_relaxed);
+			uint32_t head = m_Head.load(std::memory_order_acquire);
+			for (; tail != head; tail++)
+				func(m_Records[tail & (Capacity - 1)]);
+			m_Tail.store(tail, std::memory_order_release);
+		}
+
+		uint32_t GetThreadIndex() const { return m_ThreadIndex; }
+		uint32_t GetDroppedCount() const { return m_DroppedCount.load(std::memory_order_relaxed); }
+	private:
+		std::unique_ptr<ProfileRecord[]> m_Records;
+		uint32_t m_ThreadIndex;
+		std::atomic<uint32_t> m_DroppedCount = 0;
+
+		// Producer and consumer indices on separate cache lines
+		alignas(64) std::atomic<uint32_t> m_Head = 0;
+		uint32_t m_CachedTail = 0;
+		alignas(64) std::atomic<uint32_t> m_Tail = 0;
+	};
+
+	// Scopes append binary records to a per-thread buffer. A background thread drains the
+	// buffers every few milliseconds and writes chrome://tracing JSON.
+	class Instrumentor
+	{
+	public:
+		Instrumentor(const Instrumentor&) = delete;
+		Instrumentor(Instrumentor&&) = delete;
+
+		void BeginSession(const std::string& name, const std::string& filepath = "results.json");
+		void EndSession();
+
+		// Same recording as a session, but the writer keeps only the last frames in memory. A frame
+		// slower than the threshold, or RequestFlightRecorderDump, writes the frames around it to
+		// a trace file. EndSession stops it.
+		void BeginFlightRecorder(const std::string& name, const FlightRecorderSpecification& specification = {});
+		void RequestFlightRecorderDump();
+
+		bool IsSessionActive() const { return m_SessionActive.load(std::memory_order_relaxed); }
+
+		// Frame boundary for the flight recorder and the live capture, once per frame from the main thread
+		void MarkFrame();
+
+		// Live capture groups the records of the running session into frames for in-process
+		// viewers. Frames are handed out one frame late, so other threads' records can arrive.
+		void SetLiveCaptureEnabled(bool enabled);
+		// Moves the frames completed since the last call to the end of frames, oldest first
+		void ConsumeLiveFrames(std::vector<ProfileFrame>& frames);
+
+		// Hot path, called by every InstrumentationTimer. Times are Now() ticks.
+		void WriteProfile(const char* name, uint64_t start, uint64_t duration)
 		{
-			std::lock_guard lock(m_Mutex);
-			InternalEndSession();
+			if (!IsSessionActive())
+				return;
+
+			GetThreadBuffer().Push({ name, start, duration });
 		}
 
-		void WriteProfile(const ProfileResult& result)
+		// A copy of name that stays valid until the process ends, for scope names whose owner may
+		// go away while the writer, the flight recorder or a live capture viewer still holds
+		// records. Equal names share one copy. Takes a lock, intern once and keep the pointer.
+		const char* InternName(std::string_view name);
+
+		// For names built at runtime. Copies the name and takes a lock, keep it to a few per frame.
+		void WriteDynamicProfile(std::string_view name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::duration duration);
+
+		// Counter event, shown as a stacked graph with one series per value
+		void WriteCounter(std::string_view name, const CounterValue* values, uint32_t count);
+
+		// Records lost because a thread filled its buffer faster than the writer drained it, since startup
+		uint64_t GetDroppedRecordCount();
+
+		// Timestamp for profile records. The TSC where there is one (invariant on every x64 CPU we
+		// target), it costs a few ns against ~20 for steady_clock. The writer converts to time.
+		static uint64_t Now()
 		{
-			std::stringstream json;
-
-			//std::string name = result.Name;
-			//std::replace(name.begin(), name.end(), '"', '\'');
-
-			json << std::setprecision(3) << std::fixed;
-			json << ",{";
-			json << "\"cat\":\"function\",";
-			json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
-			json << "\"name\":\"" << result.Name << "\",";
-			json << "\"ph\":\"X\",";
-			json << "\"pid\":0,";
-			json << "\"tid\":" << result.ThreadID << ",";
-			json << "\"ts\":" << result.Start.count();
-			json << "}";
-
-			std::lock_guard lock(m_Mutex);
-			if (m_CurrentSession) 
-			{
-				m_OutputStream << json.str();
-				m_OutputStream.flush();
-			}
+		#if HZ_PROFILE_USE_TSC
+			return __rdtsc();
+		#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		#endif
 		}
 
 		static Instrumentor& Get() 
@@ -95,54 +190,106 @@ namespace Hazel {
 			return instance;
 		}
 	private:
-		Instrumentor()
-			: m_CurrentSession(nullptr)
+		struct ThreadRecord
 		{
-		}
+			ProfileRecord Record;
+			uint32_t ThreadIndex;
+		};
 
-		~Instrumentor()
+		struct FrameMark
 		{
-			EndSession();
-		}
+			uint64_t Start;
+			uint64_t End;
+		};
+	private:
+		Instrumentor() = default;
+		~Instrumentor();
 
-		void WriteHeader()
+		ProfileThreadBuffer& GetThreadBuffer()
 		{
-			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
-			m_OutputStream.flush();
+			thread_local ProfileThreadBuffer* buffer = nullptr;
+			if (!buffer)
+				buffer = RegisterThread();
+			return *buffer;
 		}
 
-		void WriteFooter()
-		{
-			m_OutputStream << "]}";
-			m_OutputStream.flush();
-		}
+		ProfileThreadBuffer* RegisterThread();
 
-		// Note: you must already own lock on m_Mutex before
-		// calling InternalEndSession()
-		void InternalEndSession()
-		{
-			if (m_CurrentSession)
-			{
-				WriteFooter();
-				m_OutputStream.close();
-				delete m_CurrentSession;
-				m_CurrentSession = nullptr;
-			}
-		}
+		void CalibrateClock();
+		int64_t TicksToNanoseconds(uint64_t ticks) const;
+
+		void WriterThread();
+		void TakeNewFrames(std::vector<FrameMark>& frames);
+		void Flush(std::string& json, std::vector<FrameMark>& frames);
+		void UpdateFlightRecorder(std::vector<FrameMark>& frames);
+		void WriteFlightRecord();
+		void UpdateLiveCapture(const std::vector<FrameMark>& frames);
 
+		void InternalBeginSession(const std::string& name);
+		void StartWriter();
+		void InternalEndSession();
 	private:
 		std::mutex m_Mutex;
-		InstrumentationSession* m_CurrentSession;
+		std::atomic<bool> m_SessionActive = false;
+		std::string m_SessionName;
 		std::ofstream m_OutputStream;
+
+		// Now() ticks to steady_clock nanoseconds: BaseNanoseconds + (ticks - BaseTicks) * NanosecondsPerTick
+		uint64_t m_BaseTicks = 0;
+		int64_t m_BaseNanoseconds = 0;
+		double m_NanosecondsPerTick = 0.0;
+
+		std::mutex m_BuffersMutex;
+		std::vector<std::unique_ptr<ProfileThreadBuffer>> m_ThreadBuffers;
+		uint64_t m_DroppedAtSessionStart = 0;
+
+		// Node-based, so the strings never move
+		std::mutex m_InternMutex;
+		std::unordered_set<std::string> m_InternedNames;
+
+		// Events from the slow paths, already formatted
+		std::mutex m_PendingMutex;
+		std::string m_PendingEvents;
+
+		std::thread m_WriterThread;
+		std::mutex m_WriterMutex;
+		std::condition_variable m_WriterCondition;
+		bool m_StopWriter = false;
+
+		// Flight recorder. Set up before the session goes active, the records and frames
+		// are only touched by the writer thread afterwards.
+		bool m_FlightRecorderActive = false;
+		FlightRecorderSpecification m_FlightRecorderSpec;
+		uint64_t m_SpikeThresholdTicks = 0;
+		std::deque<ThreadRecord> m_FlightRecords;
+		std::deque<FrameMark> m_FlightFrames;
+		int32_t m_FramesUntilDump = -1;
+		uint32_t m_DumpCount = 0;
+
+		uint64_t m_LastFrameMark = 0; // Main thread
+		std::mutex m_FrameMutex;
+		std::vector<FrameMark> m_NewFrames;
+		std::atomic<bool> m_DumpRequested = false;
+
+		// Live capture. The pending records and frames belong to the writer thread.
+		static constexpr uint32_t MaxLiveFrames = 120;
+		std::atomic<bool> m_LiveCaptureEnabled = false;
+		std::vector<ThreadRecord> m_LiveRecords;
+		std::deque<FrameMark> m_LiveFrameMarks;
+		uint64_t m_LiveFrameIndex = 0;
+		std::mutex m_LiveMutex;
+		std::deque<ProfileFrame> m_LiveFrames;
 	};
 
 	class InstrumentationTimer
 	{
 	public:
 		InstrumentationTimer(const char* name)
-			: m_Name(name), m_Stopped(false)
+			: m_Name(name), m_Stopped(!Instrumentor::Get().IsSessionActive())
 		{
-			m_StartTimepoint = std::chrono::steady_clock::now();
+			// Without a session a scope costs one load, not even the clock
+			if (!m_Stopped)
+				m_Start = Instrumentor::Now();
 		}
 
 		~InstrumentationTimer()
@@ -153,17 +300,14 @@ namespace Hazel {
 
 		void Stop()
 		{
-			auto endTimepoint = std::chrono::steady_clock::now();
-			auto highResStart = FloatingPointMicroseconds{ m_StartTimepoint.time_since_epoch() };
-			auto elapsedTime = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch() - std::chrono::time_point_cast<std::chrono::microseconds>(m_StartTimepoint).time_since_epoch();
-
-			Instrumentor::Get().WriteProfile({ m_Name, highResStart, elapsedTime, std::this_thread::get_id() });
+			uint64_t end = Instrumentor::Now();
+			Instrumentor::Get().WriteProfile(m_Name, m_Start, end - m_Start);
 
 			m_Stopped = true;
 		}
 	private:
 		const char* m_Name;
-		std::chrono::time_point<std::chrono::steady_clock> m_StartTimepoint;
+		uint64_t m_Start = 0;
 		bool m_Stopped;
 	};
 
@@ -198,6 +342,8 @@ namespace Hazel {
 }
 
 #define HZ_PROFILE 0
+// Runtime session keeps a rolling window in memory and dumps it on frame spikes, instead of tracing everything
+#define HZ_PROFILE_FLIGHT_RECORDER 0
 #if HZ_PROFILE
 	// Resolve which function signature macro will be used. Note that this only
 	// is resolved when the (pre)compiler starts, so the syntax highlighting
@@ -222,15 +368,19 @@ namespace Hazel {
 	//#define HZ_FUNC_SIG __FUNCSIG__
 
 	#define HZ_PROFILE_BEGIN_SESSION(name, filepath) ::Hazel::Instrumentor::Get().BeginSession(name, filepath)
+	#define HZ_PROFILE_BEGIN_FLIGHT_RECORDER(name, specification) ::Hazel::Instrumentor::Get().BeginFlightRecorder(name, specification)
 	#define HZ_PROFILE_END_SESSION() ::Hazel::Instrumentor::Get().EndSession()
-	#define HZ_PROFILE_SCOPE_LINE2(name, line) constexpr auto fixedName##line = ::Hazel::InstrumentorUtils::CleanupOutputString(name, "__cdecl ");\
+	#define HZ_PROFILE_MARK_FRAME() ::Hazel::Instrumentor::Get().MarkFrame()
+	#define HZ_PROFILE_SCOPE_LINE2(name, line) static constexpr auto fixedName##line = ::Hazel::InstrumentorUtils::CleanupOutputString(name, "__cdecl ");\
 													::Hazel::InstrumentationTimer timer##line(fixedName##line.Data)
 	#define HZ_PROFILE_SCOPE_LINE(name, line) HZ_PROFILE_SCOPE_LINE2(name, line)
 	#define HZ_PROFILE_SCOPE(name) HZ_PROFILE_SCOPE_LINE(name, __LINE__)
 	#define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(HZ_FUNC_SIG)
 #else
 	#define HZ_PROFILE_BEGIN_SESSION(name, filepath)
+	#define HZ_PROFILE_BEGIN_FLIGHT_RECORDER(name, specification)
 	#define HZ_PROFILE_END_SESSION()
+	#define HZ_PROFILE_MARK_FRAME()
 	#define HZ_PROFILE_SCOPE(name)
 	#define HZ_PROFILE_FUNCTION()
 #endif
\ No newline at end of file
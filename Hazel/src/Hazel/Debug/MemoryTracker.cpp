@@ -0,0 +1,187 @@
+#include "hzpch.h"
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace Hazel {
+
+	// Sits right in front of every tracked allocation
+	struct AllocationHeader
+	{
+		uint64_t Size;
+		uint32_t Offset; // From the start of the malloc block to the user pointer
+		MemoryTag Tag;
+		uint8_t Padding[3];
+	};
+	static_assert(sizeof(AllocationHeader) == 16, "Header must keep the user pointer 16 byte aligned");
+
+	// Guaranteed by malloc on every 64-bit target we build for
+	static constexpr size_t MallocAlignment = 16;
+
+	struct TagData
+	{
+		std::atomic<const char*> Name{ nullptr };
+
+		std::atomic<uint64_t> LiveBytes{ 0 };
+		std::atomic<uint64_t> PeakBytes{ 0 };
+		std::atomic<uint64_t> LiveAllocations{ 0 };
+		std::atomic<uint64_t> TotalAllocations{ 0 };
+		std::atomic<uint64_t> TotalAllocatedBytes{ 0 };
+
+		// Main thread only, see NextFrame
+		uint64_t FrameStartAllocations = 0;
+		uint64_t FrameStartAllocatedBytes = 0;
+		uint32_t FrameAllocations = 0;
+		uint64_t FrameAllocatedBytes = 0;
+	};
+
+	// Constant-initialized, new can run before any dynamic initializer
+	static TagData s_Tags[MemoryTracker::MaxTags];
+	static std::atomic<uint32_t> s_TagCount{ 1 }; // Tag 0 is "Untagged"
+	static std::mutex s_RegisterMutex;
+
+	static thread_local MemoryTag s_CurrentTag = MemoryTracker::UntaggedTag;
+
+	MemoryTag MemoryTracker::RegisterTag(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(s_RegisterMutex);
+
+		uint32_t count = s_TagCount.load(std::memory_order_relaxed);
+		for (uint32_t i = 1; i < count; i++)
+		{
+			if (strcmp(s_Tags[i].Name.load(std::memory_order_relaxed), name) == 0)
+				return (MemoryTag)i;
+		}
+
+		// Out of tags, everything else lands in the untagged bucket
+		if (count == MaxTags)
+			return UntaggedTag;
+
+		s_Tags[count].Name.store(name, std::memory_order_relaxed);
+		s_TagCount.store(count + 1, std::memory_order_release);
+		return (MemoryTag)count;
+	}
+
+	MemoryTag MemoryTracker::SetCurrentTag(MemoryTag tag)
+	{
+		MemoryTag previous = s_CurrentTag;
+		s_CurrentTag = tag;
+		return previous;
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return s_CurrentTag;
+	}
+
+	void* MemoryTracker::Allocate(size_t size, size_t alignment, MemoryTag tag)
+	{
+		alignment = std::max(alignment, MallocAlignment);
+
+		// The header takes the first 16 bytes, anything above malloc's alignment is padding
+		uint8_t* block = (uint8_t*)std::malloc(size + sizeof(AllocationHeader) + alignment - MallocAlignment);
+		if (!block)
+			return nullptr;
+
+		uintptr_t address = (uintptr_t)(block + sizeof(AllocationHeader));
+		address = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+		AllocationHeader* header = (AllocationHeader*)address - 1;
+		header->Size = size;
+		header->Offset = (uint32_t)(address - (uintptr_t)block);
+		header->Tag = tag;
+
+		TagData& data = s_Tags[tag];
+		uint64_t live = data.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		data.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+		data.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+		data.TotalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+		uint64_t peak = data.PeakBytes.load(std::memory_order_relaxed);
+		while (live > peak && !data.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+			;
+
+		return (void*)address;
+	}
+
+	void* MemoryTracker::Reallocate(void* memory, size_t size, MemoryTag tag)
+	{
+		if (!memory)
+			return Allocate(size, MallocAlignment, tag);
+
+		AllocationHeader* header = (AllocationHeader*)memory - 1;
+		void* newMemory = Allocate(size, MallocAlignment, header->Tag);
+		if (newMemory)
+		{
+			memcpy(newMemory, memory, std::min<uint64_t>(header->Size, size));
+			Free(memory);
+		}
+		return newMemory;
+	}
+
+	void MemoryTracker::Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		AllocationHeader* header = (AllocationHeader*)memory - 1;
+
+		TagData& data = s_Tags[header->Tag];
+		data.LiveBytes.fetch_sub(header->Size, std::memory_order_relaxed);
+		data.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+		std::free((uint8_t*)memory - header->Offset);
+	}
+
+	void MemoryTracker::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!IsEnabled())
+			return;
+
+		uint32_t count = s_TagCount.load(std::memory_order_acquire);
+		CounterValue values[MaxTags];
+		for (uint32_t i = 0; i < count; i++)
+		{
+			TagData& data = s_Tags[i];
+			uint64_t allocations = data.TotalAllocations.load(std::memory_order_relaxed);
+			uint64_t bytes = data.TotalAllocatedBytes.load(std::memory_order_relaxed);
+
+			data.FrameAllocations = (uint32_t)(allocations - data.FrameStartAllocations);
+			data.FrameAllocatedBytes = bytes - data.FrameStartAllocatedBytes;
+			data.FrameStartAllocations = allocations;
+			data.FrameStartAllocatedBytes = bytes;
+
+			values[i] = { GetTagStats((MemoryTag)i).Name, (double)data.LiveBytes.load(std::memory_order_relaxed) };
+		}
+
+		Instrumentor::Get().WriteCounter("Live heap bytes", values, count);
+	}
+
+	uint32_t MemoryTracker::GetTagCount()
+	{
+		return s_TagCount.load(std::memory_order_acquire);
+	}
+
+	MemoryTracker::TagStats MemoryTracker::GetTagStats(MemoryTag tag)
+	{
+		HZ_CORE_ASSERT(tag < GetTagCount(), "Unknown memory tag");
+
+		const TagData& data = s_Tags[tag];
+
+		TagStats stats;
+		stats.Name = tag == UntaggedTag ? "Untagged" : data.Name.load(std::memory_order_relaxed);
+		stats.LiveBytes = data.LiveBytes.load(std::memory_order_relaxed);
+		stats.PeakBytes = data.PeakBytes.load(std::memory_order_relaxed);
+		stats.LiveAllocations = data.LiveAllocations.load(std::memory_order_relaxed);
+		stats.TotalAllocations = data.TotalAllocations.load(std::memory_order_relaxed);
+		stats.FrameAllocations = data.FrameAllocations;
+		stats.FrameAllocatedBytes = data.FrameAllocatedBytes;
+		return stats;
+	}
+
+}
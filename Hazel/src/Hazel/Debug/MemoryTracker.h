@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Attributes every heap allocation to a tag. Opt-in because it adds a 16 byte header to
+// each allocation; define HZ_TRACK_MEMORY=1 for the whole workspace to turn it on.
+#ifndef HZ_TRACK_MEMORY
+	#define HZ_TRACK_MEMORY 0
+#endif
+
+namespace Hazel {
+
+	using MemoryTag = uint8_t;
+
+	class MemoryTracker
+	{
+	public:
+		static constexpr uint32_t MaxTags = 64;
+		static constexpr MemoryTag UntaggedTag = 0;
+
+		struct TagStats
+		{
+			const char* Name = nullptr;
+
+			uint64_t LiveBytes = 0;
+			uint64_t PeakBytes = 0;
+			uint64_t LiveAllocations = 0;
+			uint64_t TotalAllocations = 0;
+
+			// Allocation rate during the last frame
+			uint32_t FrameAllocations = 0;
+			uint64_t FrameAllocatedBytes = 0;
+		};
+
+		static constexpr bool IsEnabled() { return HZ_TRACK_MEMORY; }
+
+		// Same name, same tag. The name is not copied, pass a string literal.
+		static MemoryTag RegisterTag(const char* name);
+
+		// Tag that global new attributes to on the calling thread, returns the previous one
+		static MemoryTag SetCurrentTag(MemoryTag tag);
+		static MemoryTag GetCurrentTag();
+
+		// Tracked heap, used by the global operator new and the malloc hooks of vendor libraries
+		static void* Allocate(size_t size, size_t alignment, MemoryTag tag);
+		static void* Reallocate(void* memory, size_t size, MemoryTag tag);
+		static void Free(void* memory);
+
+		// Latches the per-frame rates and writes a counter event to the profiling session
+		static void NextFrame();
+
+		static uint32_t GetTagCount();
+		static TagStats GetTagStats(MemoryTag tag);
+	};
+
+	class MemoryScope
+	{
+	public:
+		MemoryScope(MemoryTag tag)
+			: m_PreviousTag(MemoryTracker::SetCurrentTag(tag))
+		{
+		}
+
+		~MemoryScope()
+		{
+			MemoryTracker::SetCurrentTag(m_PreviousTag);
+		}
+
+		MemoryScope(const MemoryScope&) = delete;
+		MemoryScope& operator=(const MemoryScope&) = delete;
+	private:
+		MemoryTag m_PreviousTag;
+	};
+
+}
+
+#if HZ_TRACK_MEMORY
+	#define HZ_MEMORY_SCOPE_LINE2(name, line) static const ::Hazel::MemoryTag memoryTag##line = ::Hazel::MemoryTracker::RegisterTag(name);\
+												::Hazel::MemoryScope memoryScope##line(memoryTag##line)
+	#define HZ_MEMORY_SCOPE_LINE(name, line) HZ_MEMORY_SCOPE_LINE2(name, line)
+	#define HZ_MEMORY_SCOPE(name) HZ_MEMORY_SCOPE_LINE(name, __LINE__)
+#else
+	#define HZ_MEMORY_SCOPE(name)
+#endif
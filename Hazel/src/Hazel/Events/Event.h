@@ -6,10 +6,9 @@
 
 namespace Hazel {
 
-	// Events in Hazel are currently blocking, meaning when an event occurs it
-	// immediately gets dispatched and must be dealt with right then an there.
-	// For the future, a better strategy might be to buffer events in an event
-	// bus and process them during the "event" part of the update stage.
+	// Window events are buffered in the application's EventQueue and dispatched
+	// together once a frame, right after the window polled them. Dispatching an
+	// event is still blocking: it goes through the layers there and then.
 
 	enum class EventType
 	{
@@ -0,0 +1,64 @@
+#include "hzpch.h"
+#include "EventQueue.h"
+
+#include "Hazel/Events/ApplicationEvent.h"
+#include "Hazel/Events/MouseEvent.h"
+
+namespace Hazel {
+
+	EventQueue::~EventQueue()
+	{
+		Clear();
+	}
+
+	void EventQueue::Clear()
+	{
+		for (Event* event : m_Events)
+			event->~Event();
+		m_Events.clear();
+		m_Sealed = 0;
+	}
+
+	void* EventQueue::AllocateSlot()
+	{
+		size_t index = m_Events.size();
+		if (index / SlotsPerChunk == m_Chunks.size())
+			m_Chunks.push_back(CreateScope<Chunk>());
+
+		return &m_Chunks[index / SlotsPerChunk]->Slots[index % SlotsPerChunk];
+	}
+
+	bool EventQueue::Coalesce(const Event& event)
+	{
+		Event* last = m_Events.back();
+		if (last->GetEventType() != event.GetEventType())
+			return false;
+
+		switch (event.GetEventType())
+		{
+			case EventType::MouseMoved:
+			{
+				static_cast<MouseMovedEvent&>(*last) = static_cast<const MouseMovedEvent&>(event);
+				break;
+			}
+			case EventType::MouseScrolled:
+			{
+				auto& scrolled = static_cast<MouseScrolledEvent&>(*last);
+				auto& next = static_cast<const MouseScrolledEvent&>(event);
+				scrolled = MouseScrolledEvent(scrolled.GetXOffset() + next.GetXOffset(), scrolled.GetYOffset() + next.GetYOffset());
+				break;
+			}
+			case EventType::WindowResize:
+			{
+				static_cast<WindowResizeEvent&>(*last) = static_cast<const WindowResizeEvent&>(event);
+				break;
+			}
+			default:
+				return false;
+		}
+
+		m_Stats.Coalesced++;
+		return true;
+	}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+#include "Hazel/Events/Event.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Hazel {
+
+	// Buffers events until the frame dispatches them in one pass. Events are constructed in
+	// place in pooled slots that are reused from frame to frame, so queueing never allocates
+	// once the pool has grown to a frame's worth. An event of the same type as the one queued
+	// right before it is merged into that one where only the result matters: mouse moves and
+	// resizes keep the latest, scrolls add up. Main thread only.
+	class EventQueue
+	{
+	public:
+		static constexpr size_t SlotSize = 32;
+		static constexpr size_t SlotsPerChunk = 256;
+
+		EventQueue() = default;
+		EventQueue(const EventQueue&) = delete;
+		EventQueue& operator=(const EventQueue&) = delete;
+		~EventQueue();
+
+		template<typename T, typename... Args>
+		void Push(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Only events can be queued!");
+			static_assert(sizeof(T) <= SlotSize && alignof(T) <= alignof(Slot), "Event does not fit an event queue slot!");
+
+			m_Stats.Pushed++;
+			if (m_Events.size() > m_Sealed)
+			{
+				T event(std::forward<Args>(args)...);
+				if (Coalesce(event))
+					return;
+				m_Events.push_back(new (AllocateSlot()) T(event));
+				return;
+			}
+			m_Events.push_back(new (AllocateSlot()) T(std::forward<Args>(args)...));
+		}
+
+		// Calls func for every queued event in order, then empties the queue. Events queued
+		// while dispatching are dispatched in the same pass.
+		template<typename F>
+		void Dispatch(const F& func)
+		{
+			for (size_t i = 0; i < m_Events.size(); i++)
+			{
+				// Nothing merges into an event that is being or has been dispatched
+				m_Sealed = i + 1;
+				func(*m_Events[i]);
+			}
+			m_Stats.Dispatched += m_Events.size();
+			Clear();
+		}
+
+		void Clear();
+
+		uint32_t GetSize() const { return (uint32_t)m_Events.size(); }
+
+		struct Statistics
+		{
+			uint64_t Pushed = 0;
+			uint64_t Coalesced = 0; // Merged into the event before, never dispatched on their own
+			uint64_t Dispatched = 0;
+		};
+		Statistics GetStats() const { return m_Stats; }
+		void ResetStats() { m_Stats = Statistics(); }
+	private:
+		struct alignas(std::max_align_t) Slot
+		{
+			uint8_t Bytes[SlotSize];
+		};
+
+		// Chunks never move, so the events in them stay put while the pool grows
+		struct Chunk
+		{
+			Slot Slots[SlotsPerChunk];
+		};
+
+		void* AllocateSlot();
+		bool Coalesce(const Event& event);
+	private:
+		std::vector<Scope<Chunk>> m_Chunks;
+		// The queued events, in slot order
+		std::vector<Event*> m_Events;
+		size_t m_Sealed = 0;
+
+		Statistics m_Stats;
+	};
+
+}
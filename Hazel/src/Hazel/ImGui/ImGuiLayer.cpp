@@ -6,6 +6,8 @@
 #include <examples/imgui_impl_opengl3.h>
 
 #include "Hazel/Core/Application.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
 
 // TEMPORARY
 #include <GLFW/glfw3.h>
@@ -15,9 +17,47 @@
 
 namespace Hazel {
 
+	// ImGui reuses its draw lists every frame, so the render thread gets its own copy.
+	// Lives in frame memory, which outlasts the frame's render commands.
+	struct ImGuiDrawDataSnapshot
+	{
+		ImDrawData DrawData;
+		FrameVector<ImDrawList*> CmdLists;
+
+		ImGuiDrawDataSnapshot(const ImDrawData* source)
+			: DrawData(*source)
+		{
+			CmdLists.reserve(source->CmdListsCount);
+			for (int i = 0; i < source->CmdListsCount; i++)
+				CmdLists.push_back(source->CmdLists[i]->CloneOutput());
+			DrawData.CmdLists = CmdLists.data();
+		}
+
+		~ImGuiDrawDataSnapshot()
+		{
+			for (ImDrawList* list : CmdLists)
+				IM_DELETE(list);
+		}
+	};
+
+#if HZ_TRACK_MEMORY
+	static void* ImGuiAllocate(size_t size, void* userData)
+	{
+		return MemoryTracker::Allocate(size, 16, *(MemoryTag*)userData);
+	}
+
+	static void ImGuiFree(void* memory, void* userData)
+	{
+		MemoryTracker::Free(memory);
+	}
+#endif
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
+		// ImGui can only take input, everything else goes past without a call
+		Subscribe(EventCategoryMouse, [this](Event& e) { return m_BlockEvents && ImGui::GetIO().WantCaptureMouse; });
+		Subscribe(EventCategoryKeyboard, [this](Event& e) { return m_BlockEvents && ImGui::GetIO().WantCaptureKeyboard; });
 	}
 
 	void ImGuiLayer::OnAttach()
@@ -26,12 +66,19 @@ namespace Hazel {
 
 		// Setup Dear ImGui context
 		IMGUI_CHECKVERSION();
+	#if HZ_TRACK_MEMORY
+		// ImGui calls malloc directly, route it through the tracker under its own tag
+		static MemoryTag imguiTag = MemoryTracker::RegisterTag("ImGui");
+		ImGui::SetAllocatorFunctions(ImGuiAllocate, ImGuiFree, &imguiTag);
+	#endif
 		ImGui::CreateContext();
 		ImGuiIO& io = ImGui::GetIO(); (void)io;
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
 		//io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
+		// Platform windows render with their own contexts on the main thread, which only works while the main thread owns the GL context
+		if (RenderThread::GetPolicy() == RenderThreadPolicy::SingleThreaded)
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;     // Enable Multi-Viewport / Platform Windows
 		//io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoTaskBarIcons;
 		//io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoMerge;
 
@@ -57,27 +104,23 @@ namespace Hazel {
 
 		// Setup Platform/Renderer bindings
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
-		ImGui_ImplOpenGL3_Init("#version 410");
+		RenderThread::SubmitAndWait([]()
+		{
+			ImGui_ImplOpenGL3_Init("#version 410");
+			// Created up front so ImGui_ImplOpenGL3_NewFrame never has to touch GL on the main thread
+			ImGui_ImplOpenGL3_CreateDeviceObjects();
+		});
 	}
 
 	void ImGuiLayer::OnDetach()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		ImGui_ImplOpenGL3_Shutdown();
+		RenderThread::SubmitAndWait([]() { ImGui_ImplOpenGL3_Shutdown(); });
 		ImGui_ImplGlfw_Shutdown();
 		ImGui::DestroyContext();
 	}
 
-	void ImGuiLayer::OnEvent(Event& e)
-	{
-		if (m_BlockEvents) {
-			ImGuiIO& io = ImGui::GetIO();
-			e.Handled |= e.IsInCategory(EventCategory::EventCategoryMouse) & io.WantCaptureMouse;
-			e.Handled |= e.IsInCategory(EventCategory::EventCategoryKeyboard) & io.WantCaptureKeyboard;
-		}
-	}
-
 	void ImGuiLayer::Begin()
 	{
 		HZ_PROFILE_FUNCTION();
@@ -101,7 +144,13 @@ namespace Hazel {
 
 		// Rendering
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		auto drawData = FrameAllocator::Allocate(sizeof(ImGuiDrawDataSnapshot), alignof(ImGuiDrawDataSnapshot));
+		auto snapshot = new (drawData) ImGuiDrawDataSnapshot(ImGui::GetDrawData());
+		Renderer::Submit([snapshot]()
+		{
+			ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData);
+			snapshot->~ImGuiDrawDataSnapshot();
+		});
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
@@ -16,7 +16,6 @@ namespace Hazel {
 
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
-		virtual void OnEvent(Event& e) override;
 
 		void Begin();
 		void End();
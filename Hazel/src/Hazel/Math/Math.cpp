@@ -3,6 +3,7 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace Hazel::Math {
 
@@ -78,4 +79,39 @@ namespace Hazel::Math {
 		return true;
     }
 
-}
\ No newline at end of file
+	glm::mat4 ComposeTransform(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+	{
+		return ComposeTransform(translation, glm::quat(rotation), scale);
+	}
+
+	glm::mat4 ComposeTransform(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale)
+	{
+		glm::mat3 rotationMatrix = glm::mat3_cast(rotation);
+		return glm::mat4(
+			glm::vec4(rotationMatrix[0] * scale.x, 0.0f),
+			glm::vec4(rotationMatrix[1] * scale.y, 0.0f),
+			glm::vec4(rotationMatrix[2] * scale.z, 0.0f),
+			glm::vec4(translation, 1.0f));
+	}
+
+	// [M t; 0 1]^-1 = [M^-1 -M^-1 t; 0 1]
+	static glm::mat4 InverseFromLinear(const glm::mat3& inverseLinear, const glm::vec3& translation)
+	{
+		return glm::mat4(
+			glm::vec4(inverseLinear[0], 0.0f),
+			glm::vec4(inverseLinear[1], 0.0f),
+			glm::vec4(inverseLinear[2], 0.0f),
+			glm::vec4(-(inverseLinear * translation), 1.0f));
+	}
+
+	glm::mat4 InverseAffine(const glm::mat4& transform)
+	{
+		return InverseFromLinear(glm::inverse(glm::mat3(transform)), glm::vec3(transform[3]));
+	}
+
+	glm::mat4 InverseRigid(const glm::mat4& transform)
+	{
+		return InverseFromLinear(glm::transpose(glm::mat3(transform)), glm::vec3(transform[3]));
+	}
+
+}
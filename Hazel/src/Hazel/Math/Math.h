@@ -1,9 +1,20 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace Hazel::Math {
 
 	bool DecomposeTransform(const glm::mat4& transform, glm::vec3& outTranslation, glm::vec3& outRotation, glm::vec3& outScale);
 
-}
\ No newline at end of file
+	// translate * toMat4(quat(rotation)) * scale, built straight from the quaternion
+	// instead of multiplying three matrices. rotation is in radians, as in TransformComponent.
+	glm::mat4 ComposeTransform(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale);
+	glm::mat4 ComposeTransform(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale);
+
+	// Inverses for transforms without projection, a fraction of glm::inverse's work.
+	// InverseAffine takes any scale and shear, InverseRigid only rotation and translation.
+	glm::mat4 InverseAffine(const glm::mat4& transform);
+	glm::mat4 InverseRigid(const glm::mat4& transform);
+
+}
@@ -0,0 +1,491 @@
+#include "hzpch.h"
+#include "TransformBatch.h"
+
+#include <cmath>
+
+// MSVC compiles any intrinsic on x64, GCC and Clang only what the target flags allow
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define HZ_MATH_SSE41 1
+	#define HZ_MATH_AVX2 1
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <immintrin.h>
+	#ifdef __SSE4_1__
+		#define HZ_MATH_SSE41 1
+	#else
+		#define HZ_MATH_SSE41 0
+	#endif
+	#ifdef __AVX2__
+		#define HZ_MATH_AVX2 1
+	#else
+		#define HZ_MATH_AVX2 0
+	#endif
+#else
+	#define HZ_MATH_SSE41 0
+	#define HZ_MATH_AVX2 0
+#endif
+
+namespace Hazel::Math {
+
+	// Each wrapper is one register of floats with the same set of operations, so the kernels
+	// below are written once. Mask is what comparisons return and Select and Any take.
+
+	struct Float1
+	{
+		static constexpr size_t Width = 1;
+		using Mask = bool;
+
+		float V;
+
+		Float1() = default;
+		Float1(float value) : V(value) {}
+
+		static Float1 Load(const float* data) { return *data; }
+		void Store(float* data) const { *data = V; }
+
+		friend Float1 operator+(Float1 a, Float1 b) { return a.V + b.V; }
+		friend Float1 operator-(Float1 a, Float1 b) { return a.V - b.V; }
+		friend Float1 operator*(Float1 a, Float1 b) { return a.V * b.V; }
+		friend Float1 operator/(Float1 a, Float1 b) { return a.V / b.V; }
+		friend Float1 operator-(Float1 a) { return -a.V; }
+		friend Mask operator<(Float1 a, Float1 b) { return a.V < b.V; }
+		friend Mask operator>(Float1 a, Float1 b) { return a.V > b.V; }
+		friend Mask operator==(Float1 a, Float1 b) { return a.V == b.V; }
+
+		friend Float1 Select(Mask mask, Float1 a, Float1 b) { return mask ? a : b; }
+		static bool Any(Mask mask) { return mask; }
+		friend Float1 Abs(Float1 a) { return std::abs(a.V); }
+		friend Float1 Min(Float1 a, Float1 b) { return std::min(a.V, b.V); }
+		friend Float1 Max(Float1 a, Float1 b) { return std::max(a.V, b.V); }
+		friend Float1 Sqrt(Float1 a) { return std::sqrt(a.V); }
+		friend Float1 Round(Float1 a) { return std::nearbyint(a.V); }
+		friend Float1 Floor(Float1 a) { return std::floor(a.V); }
+		// a with the sign of b
+		friend Float1 CopySign(Float1 a, Float1 b) { return std::copysign(a.V, b.V); }
+
+		// Column c of the matrix, as four registers: x, y, z, w
+		static void LoadColumn(const glm::mat4* matrices, int c, Float1 out[4])
+		{
+			for (int r = 0; r < 4; r++)
+				out[r] = matrices[0][c][r];
+		}
+
+		static void StoreColumn(glm::mat4* matrices, int c, const Float1 column[4])
+		{
+			for (int r = 0; r < 4; r++)
+				matrices[0][c][r] = column[r].V;
+		}
+	};
+
+#if HZ_MATH_SSE41
+	struct Float4
+	{
+		static constexpr size_t Width = 4;
+		using Mask = Float4;
+
+		__m128 V;
+
+		Float4() = default;
+		Float4(__m128 value) : V(value) {}
+		Float4(float value) : V(_mm_set1_ps(value)) {}
+
+		static Float4 Load(const float* data) { return _mm_loadu_ps(data); }
+		void Store(float* data) const { _mm_storeu_ps(data, V); }
+
+		friend Float4 operator+(Float4 a, Float4 b) { return _mm_add_ps(a.V, b.V); }
+		friend Float4 operator-(Float4 a, Float4 b) { return _mm_sub_ps(a.V, b.V); }
+		friend Float4 operator*(Float4 a, Float4 b) { return _mm_mul_ps(a.V, b.V); }
+		friend Float4 operator/(Float4 a, Float4 b) { return _mm_div_ps(a.V, b.V); }
+		friend Float4 operator-(Float4 a) { return _mm_xor_ps(a.V, _mm_set1_ps(-0.0f)); }
+		friend Mask operator<(Float4 a, Float4 b) { return _mm_cmplt_ps(a.V, b.V); }
+		friend Mask operator>(Float4 a, Float4 b) { return _mm_cmpgt_ps(a.V, b.V); }
+		friend Mask operator==(Float4 a, Float4 b) { return _mm_cmpeq_ps(a.V, b.V); }
+		friend Mask operator|(Float4 a, Float4 b) { return _mm_or_ps(a.V, b.V); }
+
+		friend Float4 Select(Mask mask, Float4 a, Float4 b) { return _mm_blendv_ps(b.V, a.V, mask.V); }
+		static bool Any(Mask mask) { return _mm_movemask_ps(mask.V) != 0; }
+		friend Float4 Abs(Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.V); }
+		friend Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a.V, b.V); }
+		friend Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a.V, b.V); }
+		friend Float4 Sqrt(Float4 a) { return _mm_sqrt_ps(a.V); }
+		friend Float4 Round(Float4 a) { return _mm_round_ps(a.V, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		friend Float4 Floor(Float4 a) { return _mm_floor_ps(a.V); }
+		friend Float4 CopySign(Float4 a, Float4 b)
+		{
+			__m128 sign = _mm_set1_ps(-0.0f);
+			return _mm_or_ps(_mm_andnot_ps(sign, a.V), _mm_and_ps(sign, b.V));
+		}
+
+		// Four matrices' column c, transposed so each register holds one row of all four
+		static void LoadColumn(const glm::mat4* matrices, int c, Float4 out[4])
+		{
+			__m128 m0 = _mm_loadu_ps(&matrices[0][c][0]);
+			__m128 m1 = _mm_loadu_ps(&matrices[1][c][0]);
+			__m128 m2 = _mm_loadu_ps(&matrices[2][c][0]);
+			__m128 m3 = _mm_loadu_ps(&matrices[3][c][0]);
+			_MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+			out[0] = m0; out[1] = m1; out[2] = m2; out[3] = m3;
+		}
+
+		static void StoreColumn(glm::mat4* matrices, int c, const Float4 column[4])
+		{
+			__m128 m0 = column[0].V, m1 = column[1].V, m2 = column[2].V, m3 = column[3].V;
+			_MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+			_mm_storeu_ps(&matrices[0][c][0], m0);
+			_mm_storeu_ps(&matrices[1][c][0], m1);
+			_mm_storeu_ps(&matrices[2][c][0], m2);
+			_mm_storeu_ps(&matrices[3][c][0], m3);
+		}
+	};
+#endif
+
+#if HZ_MATH_AVX2
+	struct Float8
+	{
+		static constexpr size_t Width = 8;
+		using Mask = Float8;
+
+		__m256 V;
+
+		Float8() = default;
+		Float8(__m256 value) : V(value) {}
+		Float8(float value) : V(_mm256_set1_ps(value)) {}
+
+		static Float8 Load(const float* data) { return _mm256_loadu_ps(data); }
+		void Store(float* data) const { _mm256_storeu_ps(data, V); }
+
+		friend Float8 operator+(Float8 a, Float8 b) { return _mm256_add_ps(a.V, b.V); }
+		friend Float8 operator-(Float8 a, Float8 b) { return _mm256_sub_ps(a.V, b.V); }
+		friend Float8 operator*(Float8 a, Float8 b) { return _mm256_mul_ps(a.V, b.V); }
+		friend Float8 operator/(Float8 a, Float8 b) { return _mm256_div_ps(a.V, b.V); }
+		friend Float8 operator-(Float8 a) { return _mm256_xor_ps(a.V, _mm256_set1_ps(-0.0f)); }
+		friend Mask operator<(Float8 a, Float8 b) { return _mm256_cmp_ps(a.V, b.V, _CMP_LT_OQ); }
+		friend Mask operator>(Float8 a, Float8 b) { return _mm256_cmp_ps(a.V, b.V, _CMP_GT_OQ); }
+		friend Mask operator==(Float8 a, Float8 b) { return _mm256_cmp_ps(a.V, b.V, _CMP_EQ_OQ); }
+		friend Mask operator|(Float8 a, Float8 b) { return _mm256_or_ps(a.V, b.V); }
+
+		friend Float8 Select(Mask mask, Float8 a, Float8 b) { return _mm256_blendv_ps(b.V, a.V, mask.V); }
+		static bool Any(Mask mask) { return _mm256_movemask_ps(mask.V) != 0; }
+		friend Float8 Abs(Float8 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.V); }
+		friend Float8 Min(Float8 a, Float8 b) { return _mm256_min_ps(a.V, b.V); }
+		friend Float8 Max(Float8 a, Float8 b) { return _mm256_max_ps(a.V, b.V); }
+		friend Float8 Sqrt(Float8 a) { return _mm256_sqrt_ps(a.V); }
+		friend Float8 Round(Float8 a) { return _mm256_round_ps(a.V, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		friend Float8 Floor(Float8 a) { return _mm256_floor_ps(a.V); }
+		friend Float8 CopySign(Float8 a, Float8 b)
+		{
+			__m256 sign = _mm256_set1_ps(-0.0f);
+			return _mm256_or_ps(_mm256_andnot_ps(sign, a.V), _mm256_and_ps(sign, b.V));
+		}
+
+		// Two 4x4 transposes, one per 128-bit half
+		static void LoadColumn(const glm::mat4* matrices, int c, Float8 out[4])
+		{
+			__m128 low[4], high[4];
+			for (int i = 0; i < 4; i++)
+			{
+				low[i] = _mm_loadu_ps(&matrices[i][c][0]);
+				high[i] = _mm_loadu_ps(&matrices[i + 4][c][0]);
+			}
+			_MM_TRANSPOSE4_PS(low[0], low[1], low[2], low[3]);
+			_MM_TRANSPOSE4_PS(high[0], high[1], high[2], high[3]);
+			for (int r = 0; r < 4; r++)
+				out[r] = _mm256_insertf128_ps(_mm256_castps128_ps256(low[r]), high[r], 1);
+		}
+
+		static void StoreColumn(glm::mat4* matrices, int c, const Float8 column[4])
+		{
+			__m128 low[4], high[4];
+			for (int r = 0; r < 4; r++)
+			{
+				low[r] = _mm256_castps256_ps128(column[r].V);
+				high[r] = _mm256_extractf128_ps(column[r].V, 1);
+			}
+			_MM_TRANSPOSE4_PS(low[0], low[1], low[2], low[3]);
+			_MM_TRANSPOSE4_PS(high[0], high[1], high[2], high[3]);
+			for (int i = 0; i < 4; i++)
+			{
+				_mm_storeu_ps(&matrices[i][c][0], low[i]);
+				_mm_storeu_ps(&matrices[i + 4][c][0], high[i]);
+			}
+		}
+	};
+#endif
+
+	// Polynomial approximations after Cephes' single precision routines, within a few ulp
+	// of the C library for the angles transforms use.
+
+	template<typename F>
+	static void SinCos(F x, F& outSin, F& outCos)
+	{
+		// x = quadrant * pi/2 + r, |r| <= pi/4, pi/2 split in three for an exact product
+		F quadrant = Round(x * F(0.636619772f));
+		F r = x - quadrant * F(1.5703125f);
+		r = r - quadrant * F(4.837512969970703125e-4f);
+		r = r - quadrant * F(7.54978995489188216e-8f);
+
+		F r2 = r * r;
+		F sinR = r + r * r2 * (F(-1.6666654611e-1f) + r2 * (F(8.3321608736e-3f) + r2 * F(-1.9515295891e-4f)));
+		F cosR = F(1.0f) - F(0.5f) * r2 + r2 * r2 * (F(4.166664568298827e-2f) + r2 * (F(-1.388731625493765e-3f) + r2 * F(2.443315711809948e-5f)));
+
+		// quadrant mod 4: 1 and 3 swap sin and cos, 2 and 3 negate sin, 1 and 2 negate cos
+		F q = quadrant - F(4.0f) * Floor(quadrant * F(0.25f));
+		auto swap = (q == F(1.0f)) | (q == F(3.0f));
+		F s = Select(swap, cosR, sinR);
+		F c = Select(swap, sinR, cosR);
+		outSin = Select(q > F(1.5f), -s, s);
+		outCos = Select((q == F(1.0f)) | (q == F(2.0f)), -c, c);
+	}
+
+	template<typename F>
+	static F Asin(F x)
+	{
+		F a = Min(Abs(x), F(1.0f));
+
+		// Near 1, asin(a) = pi/2 - 2 asin(sqrt((1 - a) / 2))
+		auto large = a > F(0.5f);
+		F z = Select(large, F(0.5f) * (F(1.0f) - a), a * a);
+		F t = Select(large, Sqrt(z), a);
+
+		F p = (((F(4.2163199048e-2f) * z + F(2.4181311049e-2f)) * z + F(4.5470025998e-2f)) * z + F(7.4953002686e-2f)) * z + F(1.6666752422e-1f);
+		F result = t + t * z * p;
+		result = Select(large, F(1.570796326794896f) - F(2.0f) * result, result);
+		return CopySign(result, x);
+	}
+
+	template<typename F>
+	static F Atan2(F y, F x)
+	{
+		F absY = Abs(y), absX = Abs(x);
+		F largest = Max(absX, absY);
+		// atan2(0, 0) is 0, as in the C library
+		F a = Select(largest > F(0.0f), Min(absX, absY) / largest, F(0.0f));
+
+		// Above tan(pi/8), atan(a) = pi/4 + atan((a - 1) / (a + 1))
+		auto reduce = a > F(0.414213562f);
+		a = Select(reduce, (a - F(1.0f)) / (a + F(1.0f)), a);
+
+		F z = a * a;
+		F result = (((F(8.05374449538e-2f) * z - F(1.38776856032e-1f)) * z + F(1.99777106478e-1f)) * z - F(3.33329491539e-1f)) * z * a + a;
+		result = Select(reduce, result + F(0.785398163397448f), result);
+
+		result = Select(absY > absX, F(1.570796326794896f) - result, result);
+		result = Select(x < F(0.0f), F(3.141592653589793f) - result, result);
+		return CopySign(result, y);
+	}
+
+	// Same as TransformComponent's quat(euler) followed by mat3_cast, translation and scale
+	// written into place
+	template<typename F>
+	static void ComposeBlock(const TRSArrays& trs, size_t index, glm::mat4* outTransforms)
+	{
+		F sx, cx, sy, cy, sz, cz;
+		SinCos(F::Load(&trs.RotationX[index]) * F(0.5f), sx, cx);
+		SinCos(F::Load(&trs.RotationY[index]) * F(0.5f), sy, cy);
+		SinCos(F::Load(&trs.RotationZ[index]) * F(0.5f), sz, cz);
+
+		F w = cx * cy * cz + sx * sy * sz;
+		F x = sx * cy * cz - cx * sy * sz;
+		F y = cx * sy * cz + sx * cy * sz;
+		F z = cx * cy * sz - sx * sy * cz;
+
+		F xx = x * x, yy = y * y, zz = z * z;
+		F xy = x * y, xz = x * z, yz = y * z;
+		F wx = w * x, wy = w * y, wz = w * z;
+
+		F one(1.0f), two(2.0f), zero(0.0f);
+		F scaleX = F::Load(&trs.ScaleX[index]);
+		F scaleY = F::Load(&trs.ScaleY[index]);
+		F scaleZ = F::Load(&trs.ScaleZ[index]);
+
+		F columns[4][4] =
+		{
+			{ (one - two * (yy + zz)) * scaleX, two * (xy + wz) * scaleX, two * (xz - wy) * scaleX, zero },
+			{ two * (xy - wz) * scaleY, (one - two * (xx + zz)) * scaleY, two * (yz + wx) * scaleY, zero },
+			{ two * (xz + wy) * scaleZ, two * (yz - wx) * scaleZ, (one - two * (xx + yy)) * scaleZ, zero },
+			{ F::Load(&trs.TranslationX[index]), F::Load(&trs.TranslationY[index]), F::Load(&trs.TranslationZ[index]), one }
+		};
+
+		for (int c = 0; c < 4; c++)
+			F::StoreColumn(outTransforms + index, c, columns[c]);
+	}
+
+	// Same steps as DecomposeTransform
+	template<typename F>
+	static void DecomposeBlock(const glm::mat4* transforms, size_t index, TRSArrays& outTRS)
+	{
+		F columns[4][4];
+		for (int c = 0; c < 4; c++)
+			F::LoadColumn(transforms + index, c, columns[c]);
+
+		columns[3][0].Store(&outTRS.TranslationX[index]);
+		columns[3][1].Store(&outTRS.TranslationY[index]);
+		columns[3][2].Store(&outTRS.TranslationZ[index]);
+
+		F scale[3];
+		for (int c = 0; c < 3; c++)
+		{
+			scale[c] = Sqrt(columns[c][0] * columns[c][0] + columns[c][1] * columns[c][1] + columns[c][2] * columns[c][2]);
+			F inverseScale = F(1.0f) / scale[c];
+			for (int r = 0; r < 3; r++)
+				columns[c][r] = columns[c][r] * inverseScale;
+		}
+		scale[0].Store(&outTRS.ScaleX[index]);
+		scale[1].Store(&outTRS.ScaleY[index]);
+		scale[2].Store(&outTRS.ScaleZ[index]);
+
+		F rotationY = Asin(-columns[0][2]);
+		rotationY.Store(&outTRS.RotationY[index]);
+
+		// Gimbal lock: with cos(y) == 0, x takes the whole rotation about the remaining axis
+		F sinY, cosY;
+		SinCos(rotationY, sinY, cosY);
+		auto locked = cosY == F(0.0f);
+		F rotationX = Atan2(columns[1][2], columns[2][2]);
+		F rotationZ = Atan2(columns[0][1], columns[0][0]);
+		if (F::Any(locked))
+		{
+			rotationX = Select(locked, Atan2(-columns[2][0], columns[1][1]), rotationX);
+			rotationZ = Select(locked, F(0.0f), rotationZ);
+		}
+		rotationX.Store(&outTRS.RotationX[index]);
+		rotationZ.Store(&outTRS.RotationZ[index]);
+	}
+
+	template<typename F>
+	static size_t ComposeBlocks(const TRSArrays& trs, size_t begin, size_t end, glm::mat4* outTransforms)
+	{
+		for (; begin + F::Width <= end; begin += F::Width)
+			ComposeBlock<F>(trs, begin, outTransforms);
+		return begin;
+	}
+
+	template<typename F>
+	static size_t DecomposeBlocks(const glm::mat4* transforms, size_t begin, size_t end, TRSArrays& outTRS)
+	{
+		for (; begin + F::Width <= end; begin += F::Width)
+			DecomposeBlock<F>(transforms, begin, outTRS);
+		return begin;
+	}
+
+	static SIMDLevel DetectSIMDLevel()
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		bool sse41 = (info[2] & (1 << 19)) != 0;
+		// AVX state has to be enabled by the OS as well
+		bool avx = (info[2] & (1 << 28)) && (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+
+		bool avx2 = false;
+		if (maxLeaf >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			avx2 = avx && (info[1] & (1 << 5));
+		}
+
+		if (avx2)
+			return SIMDLevel::AVX2;
+		if (sse41)
+			return SIMDLevel::SSE41;
+#elif defined(__x86_64__) || defined(__i386__)
+		// Runs from a static initializer, before the runtime has filled in the CPU model
+		__builtin_cpu_init();
+	#if HZ_MATH_AVX2
+		if (__builtin_cpu_supports("avx2"))
+			return SIMDLevel::AVX2;
+	#endif
+	#if HZ_MATH_SSE41
+		if (__builtin_cpu_supports("sse4.1"))
+			return SIMDLevel::SSE41;
+	#endif
+#endif
+		return SIMDLevel::Scalar;
+	}
+
+	static SIMDLevel s_SupportedLevel = DetectSIMDLevel();
+	static SIMDLevel s_Level = s_SupportedLevel;
+
+	void TRSArrays::Resize(size_t count)
+	{
+		for (std::vector<float>* component : { &TranslationX, &TranslationY, &TranslationZ, &RotationX, &RotationY, &RotationZ, &ScaleX, &ScaleY, &ScaleZ })
+			component->resize(count);
+	}
+
+	void TRSArrays::Set(size_t index, const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+	{
+		TranslationX[index] = translation.x; TranslationY[index] = translation.y; TranslationZ[index] = translation.z;
+		RotationX[index] = rotation.x; RotationY[index] = rotation.y; RotationZ[index] = rotation.z;
+		ScaleX[index] = scale.x; ScaleY[index] = scale.y; ScaleZ[index] = scale.z;
+	}
+
+	void TRSArrays::Get(size_t index, glm::vec3& outTranslation, glm::vec3& outRotation, glm::vec3& outScale) const
+	{
+		outTranslation = { TranslationX[index], TranslationY[index], TranslationZ[index] };
+		outRotation = { RotationX[index], RotationY[index], RotationZ[index] };
+		outScale = { ScaleX[index], ScaleY[index], ScaleZ[index] };
+	}
+
+	SIMDLevel GetSupportedSIMDLevel()
+	{
+		return s_SupportedLevel;
+	}
+
+	SIMDLevel GetSIMDLevel()
+	{
+		return s_Level;
+	}
+
+	void SetSIMDLevel(SIMDLevel level)
+	{
+		s_Level = std::min(level, s_SupportedLevel);
+	}
+
+	const char* GetSIMDLevelName(SIMDLevel level)
+	{
+		switch (level)
+		{
+			case SIMDLevel::Scalar: return "Scalar";
+			case SIMDLevel::SSE41:  return "SSE4.1";
+			case SIMDLevel::AVX2:   return "AVX2";
+		}
+		return "Unknown";
+	}
+
+	void ComposeTRS(const TRSArrays& trs, glm::mat4* outTransforms)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		size_t count = trs.Size(), index = 0;
+#if HZ_MATH_AVX2
+		if (s_Level == SIMDLevel::AVX2)
+			index = ComposeBlocks<Float8>(trs, index, count, outTransforms);
+#endif
+#if HZ_MATH_SSE41
+		if (s_Level >= SIMDLevel::SSE41)
+			index = ComposeBlocks<Float4>(trs, index, count, outTransforms);
+#endif
+		ComposeBlocks<Float1>(trs, index, count, outTransforms);
+	}
+
+	void DecomposeTRS(const glm::mat4* transforms, size_t count, TRSArrays& outTRS)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		outTRS.Resize(count);
+		size_t index = 0;
+#if HZ_MATH_AVX2
+		if (s_Level == SIMDLevel::AVX2)
+			index = DecomposeBlocks<Float8>(transforms, index, count, outTRS);
+#endif
+#if HZ_MATH_SSE41
+		if (s_Level >= SIMDLevel::SSE41)
+			index = DecomposeBlocks<Float4>(transforms, index, count, outTRS);
+#endif
+		DecomposeBlocks<Float1>(transforms, index, count, outTRS);
+	}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Hazel::Math {
+
+	// Translation, rotation (Euler, radians) and scale of many transforms, one array per
+	// component, so that the SIMD lanes work on consecutive transforms
+	struct TRSArrays
+	{
+		std::vector<float> TranslationX, TranslationY, TranslationZ;
+		std::vector<float> RotationX, RotationY, RotationZ;
+		std::vector<float> ScaleX, ScaleY, ScaleZ;
+
+		void Resize(size_t count);
+		size_t Size() const { return TranslationX.size(); }
+
+		void Set(size_t index, const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale);
+		void Get(size_t index, glm::vec3& outTranslation, glm::vec3& outRotation, glm::vec3& outScale) const;
+	};
+
+	enum class SIMDLevel
+	{
+		Scalar = 0, SSE41, AVX2
+	};
+
+	// The best level this CPU runs, and the one the batch functions use. SetSIMDLevel
+	// picks a lower one, for comparisons; levels the CPU lacks are clamped.
+	SIMDLevel GetSupportedSIMDLevel();
+	SIMDLevel GetSIMDLevel();
+	void SetSIMDLevel(SIMDLevel level);
+	const char* GetSIMDLevelName(SIMDLevel level);
+
+	// Same matrices as ComposeTransform, outTransforms holds trs.Size() of them
+	void ComposeTRS(const TRSArrays& trs, glm::mat4* outTransforms);
+
+	// Same values as DecomposeTransform for affine transforms. There is no failure result:
+	// perspective is ignored, and a zero scale gives NaN rotations as it does there.
+	void DecomposeTRS(const glm::mat4* transforms, size_t count, TRSArrays& outTRS);
+
+}
@@ -4,6 +4,7 @@
 #include "Hazel/Renderer/Renderer.h"
 
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Null/NullBuffer.h"
 
 namespace Hazel {
 
@@ -11,7 +12,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullVertexBuffer>();
 			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLVertexBuffer>(size);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -22,7 +23,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullVertexBuffer>();
 			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLVertexBuffer>(vertices, size);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!"); 
@@ -33,7 +34,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullIndexBuffer>(count);
 			case RendererAPI::API::OpenGL:		return  CreateRef<OpenGLIndexBuffer>(indices, count);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -12,9 +12,28 @@ namespace Hazel {
 			: m_Projection(projection) {}
 		virtual ~Camera() = default;
 
-		const glm::mat4& GetProjection() const { return m_Projection; }
+		// Recomputed on first use after InvalidateProjection, so setters stay cheap.
+		// Not for concurrent use: the first call after a change writes the cache.
+		const glm::mat4& GetProjection() const
+		{
+			if (m_ProjectionDirty)
+			{
+				m_Projection = CalculateProjection();
+				m_ProjectionDirty = false;
+				m_ProjectionVersion++;
+			}
+			return m_Projection;
+		}
+
+		// Changes whenever the projection does, for caching what is derived from it
+		uint32_t GetProjectionVersion() const { GetProjection(); return m_ProjectionVersion; }
 	protected:
-		glm::mat4 m_Projection = glm::mat4(1.0f);
+		void InvalidateProjection() { m_ProjectionDirty = true; }
+		virtual glm::mat4 CalculateProjection() const { return m_Projection; }
+	private:
+		mutable glm::mat4 m_Projection = glm::mat4(1.0f);
+		mutable bool m_ProjectionDirty = false;
+		mutable uint32_t m_ProjectionVersion = 0;
 	};
 
 }
@@ -4,6 +4,7 @@
 #include "Hazel/Core/Input.h"
 #include "Hazel/Core/KeyCodes.h"
 #include "Hazel/Core/MouseCodes.h"
+#include "Hazel/Math/Math.h"
 
 #include <glfw/glfw3.h>
 
@@ -13,25 +14,58 @@
 namespace Hazel {
 
 	EditorCamera::EditorCamera(float fov, float aspectRatio, float nearClip, float farClip)
-		: m_FOV(fov), m_AspectRatio(aspectRatio), m_NearClip(nearClip), m_FarClip(farClip), Camera(glm::perspective(glm::radians(fov), aspectRatio, nearClip, farClip))
+		: m_FOV(fov), m_AspectRatio(aspectRatio), m_NearClip(nearClip), m_FarClip(farClip)
 	{
-		UpdateView();
+		InvalidateProjection();
 	}
 
-	void EditorCamera::UpdateProjection()
+	void EditorCamera::SetViewportSize(float width, float height)
 	{
+		m_ViewportWidth = width;
+		m_ViewportHeight = height;
 		m_AspectRatio = m_ViewportWidth / m_ViewportHeight;
-		m_Projection = glm::perspective(glm::radians(m_FOV), m_AspectRatio, m_NearClip, m_FarClip);
+		InvalidateProjection();
+	}
+
+	glm::mat4 EditorCamera::CalculateProjection() const
+	{
+		return glm::perspective(glm::radians(m_FOV), m_AspectRatio, m_NearClip, m_FarClip);
+	}
+
+	const glm::mat4& EditorCamera::GetViewMatrix() const
+	{
+		UpdateView();
+		return m_ViewMatrix;
 	}
 
-	void EditorCamera::UpdateView()
+	const glm::mat4& EditorCamera::GetViewProjection() const
 	{
+		UpdateView();
+		uint32_t projectionVersion = GetProjectionVersion();
+		if (m_ViewProjectionDirty || projectionVersion != m_ViewProjectionVersion)
+		{
+			m_ViewProjection = GetProjection() * m_ViewMatrix;
+			m_ViewProjectionVersion = projectionVersion;
+			m_ViewProjectionDirty = false;
+		}
+		return m_ViewProjection;
+	}
+
+	void EditorCamera::UpdateView() const
+	{
+		if (!m_ViewDirty)
+			return;
+
 		// m_Yaw = m_Pitch = 0.0f; // Lock the camera's rotation
 		m_Position = CalculatePosition();
 
+		// Rotation and translation only, so the inverse is the transposed rotation
 		glm::quat orientation = GetOrientation();
 		m_ViewMatrix = glm::translate(glm::mat4(1.0f), m_Position) * glm::toMat4(orientation);
-		m_ViewMatrix = glm::inverse(m_ViewMatrix);
+		m_ViewMatrix = Math::InverseRigid(m_ViewMatrix);
+
+		m_ViewDirty = false;
+		m_ViewProjectionDirty = true;
 	}
 
 	std::pair<float, float> EditorCamera::PanSpeed() const
@@ -74,8 +108,6 @@ namespace Hazel {
 			else if (Input::IsMouseButtonPressed(Mouse::ButtonRight))
 				MouseZoom(delta.y);
 		}
-
-		UpdateView();
 	}
 
 	void EditorCamera::OnEvent(Event& e)
@@ -88,7 +120,6 @@ namespace Hazel {
 	{
 		float delta = e.GetYOffset() * 0.1f;
 		MouseZoom(delta);
-		UpdateView();
 		return false;
 	}
 
@@ -97,6 +128,7 @@ namespace Hazel {
 		auto [xSpeed, ySpeed] = PanSpeed();
 		m_FocalPoint += -GetRightDirection() * delta.x * xSpeed * m_Distance;
 		m_FocalPoint += GetUpDirection() * delta.y * ySpeed * m_Distance;
+		m_ViewDirty = true;
 	}
 
 	void EditorCamera::MouseRotate(const glm::vec2& delta)
@@ -104,6 +136,7 @@ namespace Hazel {
 		float yawSign = GetUpDirection().y < 0 ? -1.0f : 1.0f;
 		m_Yaw += yawSign * delta.x * RotationSpeed();
 		m_Pitch += delta.y * RotationSpeed();
+		m_ViewDirty = true;
 	}
 
 	void EditorCamera::MouseZoom(float delta)
@@ -114,6 +147,7 @@ namespace Hazel {
 			m_FocalPoint += GetForwardDirection();
 			m_Distance = 1.0f;
 		}
+		m_ViewDirty = true;
 	}
 
 	glm::vec3 EditorCamera::GetUpDirection() const
@@ -12,31 +12,33 @@ namespace Hazel {
 	class EditorCamera : public Camera
 	{
 	public:
-		EditorCamera() = default;
+		EditorCamera() { InvalidateProjection(); }
 		EditorCamera(float fov, float aspectRatio, float nearClip, float farClip);
 
 		void OnUpdate(Timestep ts);
 		void OnEvent(Event& e);
 
 		inline float GetDistance() const { return m_Distance; }
-		inline void SetDistance(float distance) { m_Distance = distance; }
+		inline void SetDistance(float distance) { m_Distance = distance; m_ViewDirty = true; }
 
-		inline void SetViewportSize(float width, float height) { m_ViewportWidth = width; m_ViewportHeight = height; UpdateProjection(); }
+		void SetViewportSize(float width, float height);
 
-		const glm::mat4& GetViewMatrix() const { return m_ViewMatrix; }
-		glm::mat4 GetViewProjection() const { return m_Projection * m_ViewMatrix; }
+		// Recomputed on first use after the camera moved or the viewport changed
+		const glm::mat4& GetViewMatrix() const;
+		const glm::mat4& GetViewProjection() const;
 
 		glm::vec3 GetUpDirection() const;
 		glm::vec3 GetRightDirection() const;
 		glm::vec3 GetForwardDirection() const;
-		const glm::vec3& GetPosition() const { return m_Position; }
+		const glm::vec3& GetPosition() const { UpdateView(); return m_Position; }
 		glm::quat GetOrientation() const;
 
 		float GetPitch() const { return m_Pitch; }
 		float GetYaw() const { return m_Yaw; }
+	protected:
+		glm::mat4 CalculateProjection() const override;
 	private:
-		void UpdateProjection();
-		void UpdateView();
+		void UpdateView() const;
 
 		bool OnMouseScroll(MouseScrolledEvent& e);
 
@@ -52,8 +54,13 @@ namespace Hazel {
 	private:
 		float m_FOV = 45.0f, m_AspectRatio = 1.778f, m_NearClip = 0.1f, m_FarClip = 1000.0f;
 
-		glm::mat4 m_ViewMatrix;
-		glm::vec3 m_Position = { 0.0f, 0.0f, 0.0f };
+		mutable glm::mat4 m_ViewMatrix;
+		mutable glm::vec3 m_Position = { 0.0f, 0.0f, 0.0f };
+		mutable bool m_ViewDirty = true;
+
+		mutable glm::mat4 m_ViewProjection;
+		mutable bool m_ViewProjectionDirty = true;
+		mutable uint32_t m_ViewProjectionVersion = 0; // Projection version m_ViewProjection was built from
 		glm::vec3 m_FocalPoint = { 0.0f, 0.0f, 0.0f };
 
 		glm::vec2 m_InitialMousePosition = { 0.0f, 0.0f };
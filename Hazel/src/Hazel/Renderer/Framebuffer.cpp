@@ -4,6 +4,7 @@
 #include "Hazel/Renderer/Renderer.h"
 
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
+#include "Platform/Null/NullFramebuffer.h"
 
 namespace Hazel {
 
@@ -11,7 +12,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullFramebuffer>(spec);
 			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLFramebuffer>(spec);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
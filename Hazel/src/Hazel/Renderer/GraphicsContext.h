@@ -10,6 +10,10 @@ namespace Hazel {
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
 
+		// Moves the context between threads, it can only be current on one at a time
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
+
 		static Scope<GraphicsContext> Create(void* window);
 	};
 
@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OrthographicCamera.h"
 
+#include "Hazel/Math/Math.h"
+
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Hazel {
@@ -9,8 +11,6 @@ namespace Hazel {
 		:m_ProjectionMatrix(glm::ortho(left, right, bottom, top, -1.0f, 1.0f)), m_ViewMatrix(1.0f)
 	{
 		HZ_PROFILE_FUNCTION();
-
-		m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
 	}
 
 	void OrthographicCamera::SetProjection(float left, float right, float bottom, float top)
@@ -18,18 +18,38 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		m_ProjectionMatrix = glm::ortho(left, right, bottom, top, -1.0f, 1.0f);
-		m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
+		m_ViewProjectionDirty = true;
+	}
+
+	const glm::mat4& OrthographicCamera::GetViewMatrix() const
+	{
+		if (m_ViewDirty)
+			RecalculateViewMatrix();
+		return m_ViewMatrix;
+	}
+
+	const glm::mat4& OrthographicCamera::GetViewProjectionMatrix() const
+	{
+		if (m_ViewDirty)
+			RecalculateViewMatrix();
+		if (m_ViewProjectionDirty)
+		{
+			m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
+			m_ViewProjectionDirty = false;
+		}
+		return m_ViewProjectionMatrix;
 	}
 
-	void OrthographicCamera::RecalculateViewMatrix()
+	void OrthographicCamera::RecalculateViewMatrix() const
 	{
 		HZ_PROFILE_FUNCTION();
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), m_Position) *
 			glm::rotate(glm::mat4(1.0f), glm::radians(m_Rotation), glm::vec3(0, 0, 1));
 
-		m_ViewMatrix = glm::inverse(transform);
-		m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
+		m_ViewMatrix = Math::InverseRigid(transform);
+		m_ViewDirty = false;
+		m_ViewProjectionDirty = true;
 	}
 
-}
\ No newline at end of file
+}
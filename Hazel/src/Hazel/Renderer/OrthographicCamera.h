@@ -10,23 +10,26 @@ namespace Hazel {
 		void SetProjection(float left, float right, float bottom, float top);
 
 		const glm::vec3& GetPosition() const { return m_Position; }
-		void SetPosition(const glm::vec3& position) { m_Position = position; RecalculateViewMatrix(); }
+		void SetPosition(const glm::vec3& position) { m_Position = position; m_ViewDirty = true; }
 
 		float GetRotation() const { return m_Rotation; }
-		void SetRotation(float rotation) { m_Rotation = rotation; RecalculateViewMatrix(); }
+		void SetRotation(float rotation) { m_Rotation = rotation; m_ViewDirty = true; }
 
+		// View and view-projection are recomputed on first use after a change
 		const glm::mat4& GetProjectionMatrix() const { return m_ProjectionMatrix; }
-		const glm::mat4& GetViewMatrix() const { return m_ViewMatrix; }
-		const glm::mat4& GetViewProjectionMatrix() const { return m_ViewProjectionMatrix; }
+		const glm::mat4& GetViewMatrix() const;
+		const glm::mat4& GetViewProjectionMatrix() const;
 	private:
-		void RecalculateViewMatrix();
+		void RecalculateViewMatrix() const;
 	private:
 		glm::mat4 m_ProjectionMatrix;
-		glm::mat4 m_ViewMatrix;
-		glm::mat4 m_ViewProjectionMatrix;
+		mutable glm::mat4 m_ViewMatrix;
+		mutable glm::mat4 m_ViewProjectionMatrix;
+		mutable bool m_ViewDirty = false;
+		mutable bool m_ViewProjectionDirty = true;
 
 		glm::vec3 m_Position{ 0.0f, 0.0f, 0.0f };
 		float m_Rotation = 0.0f;
 	};
 
-}
\ No newline at end of file
+}
@@ -9,6 +9,8 @@ namespace Hazel {
 	public:
 		inline static void Init()
 		{
+			// The API may have been switched since static initialization
+			s_RendererAPI = RendererAPI::Create();
 			s_RendererAPI->Init();
 		}
 
@@ -0,0 +1,111 @@
+#include "hzpch.h"
+#include "RenderCommandQueue.h"
+
+namespace Hazel {
+
+	namespace Utils {
+
+		// Every entry starts with a header; data blocks have no function and are skipped on Execute
+		struct alignas(RenderCommandQueue::Alignment) CommandHeader
+		{
+			RenderCommandQueue::RenderCommandFn Func;
+			uint32_t Size;
+		};
+
+		static uint32_t AlignSize(uint32_t size)
+		{
+			return (size + RenderCommandQueue::Alignment - 1) & ~(RenderCommandQueue::Alignment - 1);
+		}
+
+	}
+
+	RenderCommandQueue::RenderCommandQueue(uint32_t pageSize)
+		: m_PageSize(pageSize)
+	{
+		HZ_MEMORY_SCOPE("RenderCommandQueue");
+
+		Page page;
+		page.Data = (uint8_t*)::operator new(m_PageSize, std::align_val_t(Alignment));
+		page.Size = m_PageSize;
+		m_Pages.push_back(page);
+	}
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		HZ_CORE_ASSERT(m_CommandCount == 0, "Render command queue destroyed with pending commands!");
+
+		for (auto& page : m_Pages)
+			::operator delete(page.Data, std::align_val_t(Alignment));
+	}
+
+	void* RenderCommandQueue::Allocate(RenderCommandFn func, uint32_t size)
+	{
+		HZ_CORE_ASSERT(func, "Render command needs a function!");
+
+		m_CommandCount++;
+		return AllocateEntry(func, size);
+	}
+
+	void* RenderCommandQueue::AllocateData(uint32_t size)
+	{
+		return AllocateEntry(nullptr, size);
+	}
+
+	void* RenderCommandQueue::AllocateEntry(RenderCommandFn func, uint32_t size)
+	{
+		uint32_t entrySize = sizeof(Utils::CommandHeader) + Utils::AlignSize(size);
+
+		// Entries never straddle pages; move on (or grow) when the current page is full
+		while (m_Pages[m_CurrentPage].Used + entrySize > m_Pages[m_CurrentPage].Size)
+		{
+			m_CurrentPage++;
+			if (m_CurrentPage == m_Pages.size() || m_Pages[m_CurrentPage].Size < entrySize)
+			{
+				HZ_MEMORY_SCOPE("RenderCommandQueue");
+
+				Page page;
+				page.Size = std::max(m_PageSize, entrySize);
+				page.Data = (uint8_t*)::operator new(page.Size, std::align_val_t(Alignment));
+				m_Pages.insert(m_Pages.begin() + m_CurrentPage, page);
+			}
+		}
+
+		Page& page = m_Pages[m_CurrentPage];
+		auto header = (Utils::CommandHeader*)(page.Data + page.Used);
+		header->Func = func;
+		header->Size = entrySize;
+		page.Used += entrySize;
+
+		return header + 1;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		for (uint32_t i = 0; i <= m_CurrentPage; i++)
+		{
+			Page& page = m_Pages[i];
+			for (uint32_t offset = 0; offset < page.Used; )
+			{
+				auto header = (Utils::CommandHeader*)(page.Data + offset);
+				if (header->Func)
+					header->Func(header + 1);
+				offset += header->Size;
+			}
+			page.Used = 0;
+		}
+
+		m_CurrentPage = 0;
+		m_CommandCount = 0;
+	}
+
+	uint32_t RenderCommandQueue::GetUsedBytes() const
+	{
+		uint32_t used = 0;
+		for (uint32_t i = 0; i <= m_CurrentPage; i++)
+			used += m_Pages[i].Used;
+		return used;
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+
+#include <vector>
+
+namespace Hazel {
+
+	// Linear buffer of type-erased render commands. Commands are stored in place in
+	// fixed-size pages that are kept between frames, so recording a frame does not
+	// allocate once the queue has warmed up. Only one thread may record at a time.
+	class RenderCommandQueue
+	{
+	public:
+		typedef void(*RenderCommandFn)(void*);
+
+		static constexpr uint32_t Alignment = 16;
+
+		RenderCommandQueue(uint32_t pageSize = 4 * 1024 * 1024);
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		// Returns storage for a command of the given size; func is called with it on Execute
+		void* Allocate(RenderCommandFn func, uint32_t size);
+
+		// Raw storage that stays valid until the queue has been executed
+		void* AllocateData(uint32_t size);
+
+		// Runs every command in submission order and resets the queue
+		void Execute();
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		uint32_t GetUsedBytes() const;
+	private:
+		struct Page
+		{
+			uint8_t* Data = nullptr;
+			uint32_t Size = 0;
+			uint32_t Used = 0;
+		};
+
+		void* AllocateEntry(RenderCommandFn func, uint32_t size);
+	private:
+		std::vector<Page> m_Pages;
+		uint32_t m_CurrentPage = 0;
+		uint32_t m_PageSize;
+		uint32_t m_CommandCount = 0;
+	};
+
+}
@@ -0,0 +1,242 @@
+#include "hzpch.h"
+#include "RenderThread.h"
+
+#include "Hazel/Renderer/GraphicsContext.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	struct RenderThreadData
+	{
+		GraphicsContext* Context = nullptr;
+		RenderThreadPolicy Policy = RenderThreadPolicy::SingleThreaded;
+		bool Initialized = false;
+
+		// The main thread records into Queues[SubmitIndex] while the other one executes
+		std::array<Scope<RenderCommandQueue>, 2> Queues;
+		uint32_t SubmitIndex = 0;
+
+		std::thread Thread;
+		std::mutex Mutex;
+		std::condition_variable Condition;
+
+		// Guarded by Mutex
+		bool Running = false;
+		RenderCommandQueue* PendingFrame = nullptr; // Cleared once the frame has been executed
+		std::vector<const std::function<void()>*> BlockingCommands;
+		uint64_t BlockingSubmitted = 0;
+		uint64_t BlockingCompleted = 0;
+		float LastBusyTime = 0.0f;
+
+		RenderThread::Statistics Stats;
+	};
+
+	static RenderThreadData s_Data;
+
+	static thread_local bool s_IsRenderThread = false;
+
+	static float MillisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	static void RenderThreadLoop()
+	{
+		s_IsRenderThread = true;
+		s_Data.Context->MakeCurrent();
+
+		std::unique_lock<std::mutex> lock(s_Data.Mutex);
+		while (true)
+		{
+			s_Data.Condition.wait(lock, []()
+			{
+				return s_Data.PendingFrame || !s_Data.BlockingCommands.empty() || !s_Data.Running;
+			});
+
+			// A kicked frame always runs before blocking commands issued after the kick
+			if (s_Data.PendingFrame)
+			{
+				RenderCommandQueue* queue = s_Data.PendingFrame;
+				lock.unlock();
+
+				auto start = std::chrono::steady_clock::now();
+				{
+					HZ_PROFILE_SCOPE("RenderThread Frame");
+					queue->Execute();
+				}
+				float busyTime = MillisecondsSince(start);
+
+				lock.lock();
+				s_Data.PendingFrame = nullptr;
+				s_Data.LastBusyTime = busyTime;
+				s_Data.Condition.notify_all();
+				continue;
+			}
+
+			if (!s_Data.BlockingCommands.empty())
+			{
+				std::vector<const std::function<void()>*> commands;
+				commands.swap(s_Data.BlockingCommands);
+				lock.unlock();
+
+				for (auto command : commands)
+					(*command)();
+
+				lock.lock();
+				s_Data.BlockingCompleted += commands.size();
+				s_Data.Condition.notify_all();
+				continue;
+			}
+
+			if (!s_Data.Running)
+				break;
+		}
+
+		s_Data.Context->ReleaseCurrent();
+		s_IsRenderThread = false;
+	}
+
+	void RenderThread::Init(GraphicsContext* context, RenderThreadPolicy policy)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(!s_Data.Initialized, "RenderThread already initialized!");
+		HZ_CORE_ASSERT(context, "RenderThread needs a graphics context!");
+
+		s_Data.Context = context;
+		s_Data.Policy = policy;
+		s_Data.SubmitIndex = 0;
+		for (auto& queue : s_Data.Queues)
+			queue = CreateScope<RenderCommandQueue>();
+
+		if (policy == RenderThreadPolicy::MultiThreaded)
+		{
+			// The context can only be current on one thread; the render thread takes it over
+			context->ReleaseCurrent();
+			s_Data.Running = true;
+			s_Data.Thread = std::thread(RenderThreadLoop);
+		}
+
+		s_Data.Initialized = true;
+
+		HZ_CORE_INFO("Renderer running {0}", policy == RenderThreadPolicy::MultiThreaded ? "on a dedicated render thread" : "single-threaded");
+	}
+
+	void RenderThread::Shutdown()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!s_Data.Initialized)
+			return;
+
+		// Flush whatever was recorded since the last frame
+		NextFrame();
+
+		if (s_Data.Policy == RenderThreadPolicy::MultiThreaded)
+		{
+			{
+				std::unique_lock<std::mutex> lock(s_Data.Mutex);
+				s_Data.Condition.wait(lock, []() { return s_Data.PendingFrame == nullptr; });
+				s_Data.Running = false;
+			}
+			s_Data.Condition.notify_all();
+			s_Data.Thread.join();
+
+			// Anything released after this point runs inline on the main thread again
+			s_Data.Context->MakeCurrent();
+		}
+
+		s_Data.Initialized = false;
+		for (auto& queue : s_Data.Queues)
+			queue.reset();
+	}
+
+	void RenderThread::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		RenderCommandQueue& queue = *s_Data.Queues[s_Data.SubmitIndex];
+		uint32_t commandCount = queue.GetCommandCount();
+		uint32_t commandBytes = queue.GetUsedBytes();
+
+		if (s_Data.Policy == RenderThreadPolicy::SingleThreaded)
+		{
+			auto start = std::chrono::steady_clock::now();
+			s_IsRenderThread = true;
+			queue.Execute();
+			s_IsRenderThread = false;
+
+			s_Data.Stats.RenderThreadBusyTime = MillisecondsSince(start);
+			s_Data.Stats.MainThreadWaitTime = 0.0f;
+			s_Data.Stats.OverlapTime = 0.0f;
+			s_Data.Stats.CommandCount = commandCount;
+			s_Data.Stats.CommandBytes = commandBytes;
+			return;
+		}
+
+		auto waitStart = std::chrono::steady_clock::now();
+		{
+			std::unique_lock<std::mutex> lock(s_Data.Mutex);
+			s_Data.Condition.wait(lock, []() { return s_Data.PendingFrame == nullptr; });
+			float waitTime = MillisecondsSince(waitStart);
+
+			// The part of the previous frame's execution we didn't spend blocked on ran alongside us
+			s_Data.Stats.MainThreadWaitTime = waitTime;
+			s_Data.Stats.RenderThreadBusyTime = s_Data.LastBusyTime;
+			s_Data.Stats.OverlapTime = std::max(0.0f, s_Data.LastBusyTime - waitTime);
+			s_Data.Stats.CommandCount = commandCount;
+			s_Data.Stats.CommandBytes = commandBytes;
+
+			s_Data.PendingFrame = &queue;
+			s_Data.SubmitIndex = (s_Data.SubmitIndex + 1) % 2;
+		}
+		s_Data.Condition.notify_all();
+	}
+
+	void RenderThread::SubmitAndWait(const std::function<void()>& func)
+	{
+		if (!s_Data.Initialized || s_Data.Policy == RenderThreadPolicy::SingleThreaded || s_IsRenderThread)
+		{
+			func();
+			return;
+		}
+
+		HZ_PROFILE_FUNCTION();
+
+		std::unique_lock<std::mutex> lock(s_Data.Mutex);
+		s_Data.BlockingCommands.push_back(&func);
+		uint64_t ticket = ++s_Data.BlockingSubmitted;
+		s_Data.Condition.notify_all();
+		s_Data.Condition.wait(lock, [ticket]() { return s_Data.BlockingCompleted >= ticket; });
+	}
+
+	RenderCommandQueue& RenderThread::GetSubmissionQueue()
+	{
+		return *s_Data.Queues[s_Data.SubmitIndex];
+	}
+
+	bool RenderThread::IsInitialized()
+	{
+		return s_Data.Initialized;
+	}
+
+	bool RenderThread::IsRenderThread()
+	{
+		return s_IsRenderThread;
+	}
+
+	RenderThreadPolicy RenderThread::GetPolicy()
+	{
+		return s_Data.Policy;
+	}
+
+	RenderThread::Statistics RenderThread::GetStats()
+	{
+		return s_Data.Stats;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+#include "Hazel/Renderer/RenderCommandQueue.h"
+
+#include <functional>
+
+namespace Hazel {
+
+	class GraphicsContext;
+
+	enum class RenderThreadPolicy
+	{
+		// Commands are recorded the same way but executed on the main thread at the end of the frame
+		SingleThreaded = 0,
+		// A dedicated thread owns the graphics context and executes frame N while the main thread records N + 1
+		MultiThreaded
+	};
+
+	// Owns the two command queues the renderer records into and, in multi-threaded
+	// mode, the thread that executes them. Everything that talks to the graphics API
+	// goes through Renderer::Submit (deferred) or RenderThread::SubmitAndWait (blocking).
+	class RenderThread
+	{
+	public:
+		static void Init(GraphicsContext* context, RenderThreadPolicy policy);
+		static void Shutdown();
+
+		// Hands the recorded frame over for execution and starts recording the next one.
+		// Blocks only while the previous frame is still being executed.
+		static void NextFrame();
+
+		// Runs func with the graphics context current and waits for it. Used for resource
+		// creation and read-backs; it runs after the frame being executed, before any
+		// commands recorded since the last NextFrame.
+		static void SubmitAndWait(const std::function<void()>& func);
+
+		static RenderCommandQueue& GetSubmissionQueue();
+
+		static bool IsInitialized();
+		static bool IsRenderThread();
+		static RenderThreadPolicy GetPolicy();
+
+		struct Statistics
+		{
+			float MainThreadWaitTime = 0.0f;   // ms the main thread blocked on the render thread
+			float RenderThreadBusyTime = 0.0f; // ms spent executing the last frame's commands
+			float OverlapTime = 0.0f;          // ms of that which ran concurrently with the main thread
+			uint32_t CommandCount = 0;
+			uint32_t CommandBytes = 0;
+		};
+		static Statistics GetStats();
+	};
+
+}
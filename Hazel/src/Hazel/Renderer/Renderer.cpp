@@ -22,6 +22,17 @@ namespace Hazel {
 		Renderer2D::Shutdown();
 	}
 
+	const void* Renderer::CopyToCommandQueue(const void* data, uint32_t size)
+	{
+		// Commands execute immediately when there is no queue, so the caller's memory is fine
+		if (!RenderThread::IsInitialized())
+			return data;
+
+		void* copy = RenderThread::GetSubmissionQueue().AllocateData(size);
+		memcpy(copy, data, size);
+		return copy;
+	}
+
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
 	{
 		RenderCommand::SetViewport(0, 0, width, height);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RenderCommand.h"
+#include "RenderThread.h"
 
 #include "Shader.h"
 #include "OrthographicCamera.h"
@@ -20,6 +21,35 @@ namespace Hazel {
 
 		static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f));
 
+		// Records func into the current frame's command queue. It runs later, on the render
+		// thread, so capture everything by value. Must be called from the main thread.
+		template<typename FuncT>
+		static void Submit(FuncT&& func)
+		{
+			using Command = std::decay_t<FuncT>;
+			static_assert(alignof(Command) <= RenderCommandQueue::Alignment, "Render command is over-aligned!");
+
+			if (!RenderThread::IsInitialized())
+			{
+				func();
+				return;
+			}
+
+			HZ_CORE_ASSERT(!RenderThread::IsRenderThread(), "Cannot submit render commands from inside a render command!");
+
+			auto renderCmd = [](void* ptr)
+			{
+				auto command = (Command*)ptr;
+				(*command)();
+				command->~Command();
+			};
+			void* storage = RenderThread::GetSubmissionQueue().Allocate(renderCmd, sizeof(Command));
+			new (storage) Command(std::forward<FuncT>(func));
+		}
+
+		// Copies data into the current command queue so a submitted command can read it later
+		static const void* CopyToCommandQueue(const void* data, uint32_t size);
+
 		inline static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); };
 	private:
 		struct SceneData {
@@ -6,6 +6,8 @@
 
 #include "Hazel/Renderer/RenderCommand.h"
 
+#include "Hazel/Math/Math.h"
+
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Hazel {
@@ -51,6 +53,7 @@ namespace Hazel {
 	void Renderer2D::Init()
 	{
 		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Renderer2D");
 
 		s_Data.QuadVertexArray = VertexArray::Create();
 
@@ -126,7 +129,7 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glm::mat4 viewProj = camera.GetProjection() * glm::inverse(transform);
+		glm::mat4 viewProj = camera.GetProjection() * Math::InverseAffine(transform);
 
 		s_Data.TextureShader->Bind();
 		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
@@ -138,7 +141,7 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glm::mat4 viewProj = camera.GetViewProjection();
+		const glm::mat4& viewProj = camera.GetViewProjection();
 
 		s_Data.TextureShader->Bind();
 		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProj);
@@ -146,6 +149,16 @@ namespace Hazel {
 		StartBatch();
 	}
 
+	void Renderer2D::BeginScene(const glm::mat4& viewProjection)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		s_Data.TextureShader->Bind();
+		s_Data.TextureShader->SetMat4("u_ViewProjection", viewProjection);
+
+		StartBatch();
+	}
+
 	void Renderer2D::EndScene()
 	{
 		HZ_PROFILE_FUNCTION();
@@ -171,6 +184,7 @@ namespace Hazel {
 		s_Data.QuadVertexArray->Unbind();
 
 		s_Data.Stats.DrawCalls++;
+		s_Data.Stats.UploadedBytes += dataSize;
 	}
 
 	void Renderer2D::StartBatch()
@@ -279,7 +293,8 @@ namespace Hazel {
 		float textureIndex = 0.0f;
 		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
 		{
-			if (*s_Data.TextureSlots[i].get() == *texture.get())
+			// Same Ref is the common case, skip the virtual compare for it
+			if (s_Data.TextureSlots[i] == texture || *s_Data.TextureSlots[i] == *texture)
 			{
 				textureIndex = (float)i;
 				break;
@@ -318,6 +333,7 @@ namespace Hazel {
 
 		constexpr size_t quadVertexCount = 4;
 		const glm::vec2* textureCoords = subTexture->GetTextCoords();
+		const Ref<Texture2D>& texture = subTexture->GetTexture();
 
 		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 			NextBatch();
@@ -325,7 +341,7 @@ namespace Hazel {
 		float textureIndex = 0.0f;
 		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
 		{
-			if (*s_Data.TextureSlots[i].get() == *subTexture->GetTexture().get())
+			if (s_Data.TextureSlots[i] == texture || *s_Data.TextureSlots[i] == *texture)
 			{
 				textureIndex = (float)i;
 				break;
@@ -338,7 +354,7 @@ namespace Hazel {
 				NextBatch();
 
 			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = subTexture->GetTexture();
+			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
 			s_Data.TextureSlotIndex++;
 		}
 
@@ -21,6 +21,7 @@ namespace Hazel {
 		static void BeginScene(const Camera& camera, const glm::mat4& transform);
 		static void BeginScene(const EditorCamera& camera);
 		static void BeginScene(const OrthographicCamera& camera); // TODO: Remove
+		static void BeginScene(const glm::mat4& viewProjection);
 		static void EndScene();
 		static void Flush();
 
@@ -43,6 +44,7 @@ namespace Hazel {
 		{
 			uint32_t DrawCalls = 0;
 			uint32_t QuadCount = 0;
+			uint64_t UploadedBytes = 0; // Vertex data
 
 			uint32_t GetTotalVertexCount() { return QuadCount * 4; }
 			uint32_t GetTotalIndexCount() { return QuadCount * 6; }
@@ -2,16 +2,24 @@
 #include "RendererAPI.h"
 
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
+#include "Hazel/Renderer/RenderThread.h"
 
 namespace Hazel {
 
 	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
 
+	void RendererAPI::SetAPI(API api)
+	{
+		HZ_CORE_ASSERT(!RenderThread::IsInitialized(), "The renderer API has to be picked before the renderer starts!");
+		s_API = api;
+	}
+
 	Scope<RendererAPI> RendererAPI::Create()
 	{
 		switch (s_API)
 		{
-			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return CreateScope<NullRendererAPI>();
 			case RendererAPI::API::OpenGL:  return CreateScope<OpenGLRendererAPI>();
 		}
 
@@ -11,6 +11,7 @@ namespace Hazel {
 	public:
 		enum class API
 		{
+			// No-op backend for headless runs
 			None = 0, OpenGL = 1
 		};
 	public:
@@ -26,6 +27,8 @@ namespace Hazel {
 		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
 	
 		inline static API GetAPI() { return s_API; }
+		// Before Renderer::Init, and before any renderer resource is created
+		static void SetAPI(API api);
 
 		static Scope<RendererAPI> RendererAPI::Create();
 	private:
@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Null/NullShader.h"
 
 namespace Hazel {
 
@@ -10,7 +11,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:		return CreateRef<NullShader>(NullShader::GetNameFromFilepath(filepath));
 		case RendererAPI::API::OpenGL:		return CreateRef<OpenGLShader>(filepath);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -21,7 +22,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:		return CreateRef<NullShader>(name);
 		case RendererAPI::API::OpenGL:		return CreateRef<OpenGLShader>(name, filepath);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -32,7 +33,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullShader>(name);
 			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -1,13 +1,14 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
 
 namespace Hazel {
 
-	class Shader
+	class Shader : public RefCounted
 	{
 	public:
 		virtual ~Shader() = default;
@@ -15,13 +16,13 @@ namespace Hazel {
 		virtual void Bind() const = 0;
 		virtual void UnBind() const = 0;
 
-		virtual void SetInt(const std::string& name, int value) = 0;
-		virtual void SetIntArray(const std::string& name, int* value, uint32_t count) = 0;
-		virtual void SetFloat(const std::string& name, float value) = 0;
-		virtual void SetFloat2(const std::string& name, const glm::vec2& value) = 0;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& value) = 0;
-		virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
-		virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
+		virtual void SetInt(std::string_view name, int value) = 0;
+		virtual void SetIntArray(std::string_view name, int* value, uint32_t count) = 0;
+		virtual void SetFloat(std::string_view name, float value) = 0;
+		virtual void SetFloat2(std::string_view name, const glm::vec2& value) = 0;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) = 0;
+		virtual void SetFloat4(std::string_view name, const glm::vec4& value) = 0;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) = 0;
 
 		virtual const std::string& GetName() const = 0;
 		
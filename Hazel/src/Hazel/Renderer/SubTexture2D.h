@@ -6,12 +6,12 @@
 
 namespace Hazel {
 
-	class SubTexture2D
+	class SubTexture2D : public SingleThreadedRefCounted
 	{
 	public:
 		SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max);
 	
-		const Ref<Texture2D> GetTexture() const { return m_Texture; }
+		const Ref<Texture2D>& GetTexture() const { return m_Texture; }
 		const glm::vec2* GetTextCoords() const { return m_TexCoords; }
 
 		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize = { 1.0f, 1.0f });
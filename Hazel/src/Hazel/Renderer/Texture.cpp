@@ -3,6 +3,7 @@
 
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Null/NullTexture.h"
 
 namespace Hazel {
 
@@ -10,7 +11,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:		return CreateRef<NullTexture2D>(width, height);
 		case RendererAPI::API::OpenGL:		return CreateRef<OpenGLTexture2D>(width, height);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -21,7 +22,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullTexture2D>(path);
 			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLTexture2D>(path);
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
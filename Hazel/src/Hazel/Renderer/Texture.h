@@ -6,7 +6,7 @@
 
 namespace Hazel {
 
-	class Texture
+	class Texture : public RefCounted
 	{
 	public:
 		virtual ~Texture() = default;
@@ -4,6 +4,7 @@
 #include"Renderer.h"
 
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Null/NullVertexArray.h"
 
 namespace Hazel {
 
@@ -11,7 +12,7 @@ namespace Hazel {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:		HZ_CORE_ASSERT(false, "None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:		return CreateRef<NullVertexArray>();
 			case RendererAPI::API::OpenGL:		return CreateRef<OpenGLVertexArray>();
 		}
 		HZ_CORE_ASSERT(false, "Unknown Renderer API!");
@@ -5,7 +5,7 @@
 
 namespace Hazel {
 
-	class VertexArray
+	class VertexArray : public RefCounted
 	{
 	public:
 		virtual ~VertexArray() {}
@@ -6,6 +6,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 
+#include "Hazel/Math/Math.h"
+
 #include "SceneCamera.h"
 #include "ScriptableEntity.h"
 
@@ -35,11 +37,50 @@ namespace Hazel {
 
 		glm::mat4 GetTransform() const
 		{
-			glm::mat4 rotation = glm::toMat4(glm::quat(Rotation));
-			return glm::translate(glm::mat4(1.0f), Translation) * rotation * glm::scale(glm::mat4(1.0f), Scale);
+			return Math::ComposeTransform(Translation, Rotation, Scale);
 		}
 	};
 
+	// Intrusive parent/child links (first-child / sibling list).
+	// Depth is 0 for root entities and is kept up to date by Scene::SetParent.
+	struct RelationshipComponent
+	{
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity PreviousSibling = entt::null;
+		entt::entity NextSibling = entt::null;
+		uint32_t ChildCount = 0;
+		uint32_t Depth = 0;
+
+		RelationshipComponent() = default;
+		RelationshipComponent(const RelationshipComponent&) = default;
+	};
+
+	// Cached world matrix, owned by the Scene. Only recomputed when the local
+	// TransformComponent differs from the cached TRS or when an ancestor changed.
+	struct WorldTransformComponent
+	{
+		glm::mat4 Transform{ 1.0f };
+		glm::mat4 LocalTransform{ 1.0f };
+
+		glm::vec3 CachedTranslation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 CachedRotation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 CachedScale = { 1.0f, 1.0f, 1.0f };
+		bool CachedRotationBlended = false; // LocalTransform's rotation is a blend, not CachedRotation
+
+		// The local transform before the last fixed update, interpolated from when rendering
+		glm::vec3 PreviousTranslation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 PreviousRotation = { 0.0f, 0.0f, 0.0f };
+		glm::vec3 PreviousScale = { 1.0f, 1.0f, 1.0f };
+
+		bool Dirty = true;        // Forces a recompute on the next update (creation, reparenting)
+		bool Updated = false;     // Set when Transform changed during the last update, read by children
+		bool HasPrevious = false; // Not before the entity's first fixed update
+
+		WorldTransformComponent() = default;
+		WorldTransformComponent(const WorldTransformComponent&) = default;
+	};
+
 	struct SpriteRendererComponent
 	{
 		glm::vec4 Color{ 1.0f };
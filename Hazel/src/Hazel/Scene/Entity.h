@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Scene.h"
+#include "Hazel/Debug/MemoryTracker.h"
 
 #include "entt.hpp"
 
@@ -17,6 +18,7 @@ namespace Hazel {
 		T& AddComponent(Args&&... args)
 		{
 			HZ_CORE_ASSERT(!HasComponent<T>(), "Entity already has component!");
+			HZ_MEMORY_SCOPE("Scene");
 			T& component = m_Scene->m_Registry.emplace<T>(m_EntityHandle, std::forward<Args>(args)...);
 			m_Scene->OnComponentAdded<T>(*this, component);
 			return component;
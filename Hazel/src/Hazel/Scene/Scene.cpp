@@ -3,99 +3,496 @@
 
 #include "Entity.h"
 #include "Components.h"
+#include "Hazel/Core/JobSystem.h"
+#include "Hazel/Math/Math.h"
 #include "Hazel/Renderer/Renderer2D.h"
 
 #include <glm/glm.hpp>
 
 namespace Hazel {
 
+	// Non-component resources shared between update stages
+	struct PrimaryCameraResource {};
+	struct VisibleSpritesResource {};
+	struct SceneStatisticsResource {};
+
 	Scene::Scene()
 	{
+		// Pools and groups are created up front, the update stages may run concurrently
+		m_Registry.prepare<CameraComponent>();
+		m_Registry.prepare<NativeScriptComponent>();
+		m_Registry.group<SpriteRendererComponent>(entt::get<WorldTransformComponent>);
+
+		m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagConstruct>(*this);
+		m_Registry.on_update<TagComponent>().connect<&Scene::OnTagUpdate>(*this);
+		m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagDestroy>(*this);
+
+		BuildUpdateGraphs();
 	}
 
 	Scene::~Scene()
 	{
+		m_Registry.view<NativeScriptComponent>().each([](auto entity, auto& nsc)
+		{
+			if (nsc.Instance)
+			{
+				nsc.Instance->OnDestroy();
+				nsc.DestroyScript(&nsc);
+			}
+		});
+
+		m_Registry.on_construct<TagComponent>().disconnect(*this);
+		m_Registry.on_update<TagComponent>().disconnect(*this);
+		m_Registry.on_destroy<TagComponent>().disconnect(*this);
+	}
+
+	// One range insert per pool, in the order of the source pool so sorted pools stay sorted.
+	// The components are copied as a block, but each entity still gets its own sparse set
+	// entry, and an on_construct signal for pools with listeners (the tag index on tags).
+	template<typename Component>
+	static void CopyComponents(entt::registry& dst, const entt::registry& src)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		const entt::entity* entities = src.data<Component>();
+		const Component* components = src.raw<Component>();
+		size_t count = src.size<Component>();
+		dst.insert<Component>(entities, entities + count, components, components + count);
+	}
+
+	Ref<Scene> Scene::Copy(const Ref<Scene>& other)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Scene");
+
+		Ref<Scene> scene = CreateRef<Scene>();
+		scene->m_ViewportWidth = other->m_ViewportWidth;
+		scene->m_ViewportHeight = other->m_ViewportHeight;
+		scene->m_HierarchyDirty = other->m_HierarchyDirty;
+
+		auto& dst = scene->m_Registry;
+		const auto& src = other->m_Registry;
+
+		// The entity list as it is, destroyed slots included, so every live handle and version
+		// stays the same. assign rebuilds the free list in index order though, entities created
+		// in the copy don't get the handles the source would hand out next.
+		dst.assign(src.data(), src.data() + src.size());
+
+		CopyComponents<TagComponent>(dst, src);
+		CopyComponents<TransformComponent>(dst, src);
+		CopyComponents<RelationshipComponent>(dst, src);
+		CopyComponents<WorldTransformComponent>(dst, src);
+		CopyComponents<SpriteRendererComponent>(dst, src);
+		CopyComponents<CameraComponent>(dst, src);
+		CopyComponents<NativeScriptComponent>(dst, src);
+
+		// Only the bindings, each scene runs its own instances
+		dst.view<NativeScriptComponent>().each([](auto entity, auto& nsc) { nsc.Instance = nullptr; });
+
+		return scene;
 	}
 
 	Entity Scene::CreateEntity(const std::string name)
 	{
+		HZ_MEMORY_SCOPE("Scene");
+
 		Entity entity = { m_Registry.create(), this };
 		entity.AddComponent<TransformComponent>();
-		auto& tag = entity.AddComponent<TagComponent>();
-		tag.Tag = name.empty() ? "Entity" : name;
+		entity.AddComponent<RelationshipComponent>();
+		entity.AddComponent<WorldTransformComponent>();
+		entity.AddComponent<TagComponent>(name.empty() ? "Entity" : name);
 		return entity;
 	}
 
 	void Scene::DestroyEntity(Entity entity)
 	{
+		// Children are destroyed along with their parent
+		auto& relationship = entity.GetComponent<RelationshipComponent>();
+		entt::entity child = relationship.FirstChild;
+		while (child != entt::null)
+		{
+			entt::entity next = m_Registry.get<RelationshipComponent>(child).NextSibling;
+			DestroyEntity({ child, this });
+			child = next;
+		}
+
+		SetParent(entity, {});
 		m_Registry.destroy(entity);
+
+		// Destroying swaps the last element of each pool into the hole
+		m_HierarchyDirty = true;
+		m_HierarchyVersion++;
 	}
 
-	void Scene::OnUpdateRuntime(Timestep ts)
+	void Scene::SetParent(Entity entity, Entity parent)
 	{
+		HZ_CORE_ASSERT(entity != parent, "Entity cannot be its own parent!");
+
+		auto& relationship = entity.GetComponent<RelationshipComponent>();
+		if (relationship.Parent == (entt::entity)parent)
+			return;
+
+		// Unlink from the current parent
+		if (relationship.Parent != entt::null)
 		{
-			m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto& nsc)
-			{
-					if (!nsc.Instance/*->m_Entity*/)
-					{
-						nsc.Instance = nsc.InstantiateScript();
-						nsc.Instance->m_Entity = Entity{ entity, this };
-						nsc.Instance->OnCreate();
-					}
-
-					nsc.Instance->OnUpdate(ts);
-			});
+			auto& oldParent = m_Registry.get<RelationshipComponent>(relationship.Parent);
+			if (oldParent.FirstChild == (entt::entity)entity)
+				oldParent.FirstChild = relationship.NextSibling;
+			if (relationship.PreviousSibling != entt::null)
+				m_Registry.get<RelationshipComponent>(relationship.PreviousSibling).NextSibling = relationship.NextSibling;
+			if (relationship.NextSibling != entt::null)
+				m_Registry.get<RelationshipComponent>(relationship.NextSibling).PreviousSibling = relationship.PreviousSibling;
+			oldParent.ChildCount--;
+
+			relationship.Parent = entt::null;
+			relationship.PreviousSibling = entt::null;
+			relationship.NextSibling = entt::null;
 		}
 
-		// Render 2D
-		Camera* mainCamera = nullptr;
-		glm::mat4 cameraTransform;
+		// Link as the first child of the new parent
+		uint32_t depth = 0;
+		if (parent)
 		{
-			auto group = m_Registry.group<CameraComponent>(entt::get<TransformComponent>);
-			for (auto entity : group)
+			auto& newParent = parent.GetComponent<RelationshipComponent>();
+		#ifdef HZ_ENABLE_ASSERTS
+			for (entt::entity it = parent; it != entt::null; it = m_Registry.get<RelationshipComponent>(it).Parent)
+				HZ_CORE_ASSERT(it != (entt::entity)entity, "Cannot parent an entity to one of its descendants!");
+		#endif
+
+			relationship.Parent = parent;
+			relationship.NextSibling = newParent.FirstChild;
+			if (newParent.FirstChild != entt::null)
+				m_Registry.get<RelationshipComponent>(newParent.FirstChild).PreviousSibling = entity;
+			newParent.FirstChild = entity;
+			newParent.ChildCount++;
+
+			depth = newParent.Depth + 1;
+		}
+
+		UpdateDepth(entity, depth);
+		entity.GetComponent<WorldTransformComponent>().Dirty = true;
+		m_HierarchyDirty = true;
+		m_HierarchyVersion++;
+	}
+
+	Entity Scene::GetParent(Entity entity)
+	{
+		entt::entity parent = entity.GetComponent<RelationshipComponent>().Parent;
+		return parent == entt::null ? Entity{} : Entity{ parent, this };
+	}
+
+	bool Scene::IsValid(Entity entity) const
+	{
+		return m_Registry.valid(entity);
+	}
+
+	void Scene::SetTag(Entity entity, const std::string& tag)
+	{
+		m_Registry.patch<TagComponent>(entity, [&](TagComponent& component) { component.Tag = tag; });
+	}
+
+	void Scene::OnTagConstruct(entt::registry& registry, entt::entity entity)
+	{
+		m_TagIndex.Insert(entity, registry.get<TagComponent>(entity).Tag);
+		m_HierarchyVersion++;
+	}
+
+	void Scene::OnTagUpdate(entt::registry& registry, entt::entity entity)
+	{
+		m_TagIndex.Rename(entity, registry.get<TagComponent>(entity).Tag);
+	}
+
+	void Scene::OnTagDestroy(entt::registry& registry, entt::entity entity)
+	{
+		m_TagIndex.Erase(entity);
+	}
+
+	void Scene::UpdateDepth(entt::entity entity, uint32_t depth)
+	{
+		auto& relationship = m_Registry.get<RelationshipComponent>(entity);
+		relationship.Depth = depth;
+		for (entt::entity child = relationship.FirstChild; child != entt::null; child = m_Registry.get<RelationshipComponent>(child).NextSibling)
+			UpdateDepth(child, depth + 1);
+	}
+
+	void Scene::UpdateWorldTransforms()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_HierarchyDirty)
+		{
+			HZ_PROFILE_SCOPE("Sort transform hierarchy");
+
+			// Parent-before-child order, shared by all three pools so the update walks them linearly
+			m_Registry.sort<RelationshipComponent>([](const RelationshipComponent& lhs, const RelationshipComponent& rhs) { return lhs.Depth < rhs.Depth; });
+			m_Registry.sort<WorldTransformComponent, RelationshipComponent>();
+			m_Registry.sort<TransformComponent, RelationshipComponent>();
+			m_HierarchyDirty = false;
+		}
+
+		const float interpolation = m_FrameInterpolation;
+		auto view = m_Registry.view<WorldTransformComponent>();
+		for (auto entity : view)
+		{
+			auto& world = view.get(entity);
+			const auto& transform = m_Registry.get<TransformComponent>(entity);
+			const auto& relationship = m_Registry.get<RelationshipComponent>(entity);
+
+			glm::vec3 translation = transform.Translation;
+			glm::vec3 rotation = transform.Rotation;
+			glm::vec3 scale = transform.Scale;
+			// Rotations blend as quaternions, Euler angles would turn the long way across +-pi
+			bool rotationBlended = false;
+			if (interpolation < 1.0f && world.HasPrevious && !world.Dirty)
 			{
-				auto [camera, transform] = group.get<CameraComponent, TransformComponent>(entity);
+				if (translation != world.PreviousTranslation)
+					translation = glm::mix(world.PreviousTranslation, translation, interpolation);
+				if (rotation != world.PreviousRotation)
+					rotationBlended = true;
+				if (scale != world.PreviousScale)
+					scale = glm::mix(world.PreviousScale, scale, interpolation);
+			}
+
+			// A blended rotation changes with every rendered frame
+			bool localChanged = world.Dirty
+				|| rotationBlended
+				|| world.CachedRotationBlended
+				|| translation != world.CachedTranslation
+				|| rotation != world.CachedRotation
+				|| scale != world.CachedScale;
+
+			const WorldTransformComponent* parentWorld = relationship.Parent != entt::null ? &m_Registry.get<WorldTransformComponent>(relationship.Parent) : nullptr;
+			bool parentChanged = parentWorld && parentWorld->Updated;
+
+			world.Updated = localChanged || parentChanged;
+			world.Dirty = false;
+			if (!world.Updated)
+				continue;
+
+			if (localChanged)
+			{
+				world.CachedTranslation = translation;
+				world.CachedRotation = rotation;
+				world.CachedScale = scale;
+				world.CachedRotationBlended = rotationBlended;
+				if (rotationBlended)
+					world.LocalTransform = Math::ComposeTransform(translation, glm::slerp(glm::quat(world.PreviousRotation), glm::quat(rotation), interpolation), scale);
+				else
+					world.LocalTransform = Math::ComposeTransform(translation, rotation, scale);
+			}
+
+			world.Transform = parentWorld ? parentWorld->Transform * world.LocalTransform : world.LocalTransform;
+		}
+	}
+
+	void Scene::BuildUpdateGraphs()
+	{
+		// Scripts can touch any component and may poll input, so they stay on the main thread
+		m_RuntimeGraph.AddTask("Scripts", [this]() { if (m_FrameRunsScripts) UpdateScripts(); })
+			.Writes<NativeScriptComponent, TransformComponent, CameraComponent, SpriteRendererComponent>()
+			.OnMainThread();
+
+		// Only reads transforms and relationships, but re-sorting their pools after a hierarchy change is a write
+		m_RuntimeGraph.AddTask("Transform Propagation", [this]() { UpdateWorldTransforms(); })
+			.Writes<WorldTransformComponent, TransformComponent, RelationshipComponent>();
+
+		m_RuntimeGraph.AddTask("Camera Selection", [this]() { SelectPrimaryCamera(); })
+			.Reads<CameraComponent, WorldTransformComponent>()
+			.Writes<PrimaryCameraResource>();
+
+		m_EditorGraph.AddTask("Transform Propagation", [this]() { UpdateWorldTransforms(); })
+			.Writes<WorldTransformComponent, TransformComponent, RelationshipComponent>();
+
+		for (TaskGraph* graph : { &m_RuntimeGraph, &m_EditorGraph })
+		{
+			graph->AddTask("Culling", [this]() { CullSprites(); })
+				.Reads<PrimaryCameraResource, WorldTransformComponent, SpriteRendererComponent>()
+				.Writes<VisibleSpritesResource>();
+
+			// Renderer2D talks to the graphics context
+			graph->AddTask("Batch Building", [this]() { SubmitSprites(); })
+				.Reads<PrimaryCameraResource, VisibleSpritesResource, WorldTransformComponent, SpriteRendererComponent>()
+				.Writes<Renderer2D>()
+				.OnMainThread();
+
+			graph->AddTask("Statistics", [this]() { UpdateStats(); })
+				.Reads<VisibleSpritesResource, SpriteRendererComponent>()
+				.Writes<SceneStatisticsResource>();
+		}
+	}
+
+	void Scene::OnUpdateRuntime(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Scene");
+
+		m_FrameTimestep = ts;
+		m_FrameRunsScripts = true;
+		m_FrameInterpolation = 1.0f;
+		m_FrameEditorCamera = nullptr;
+		m_RuntimeGraph.Execute();
+	}
+
+	void Scene::OnFixedUpdateRuntime(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Scene");
 
-				if (camera.Primary)
+		// Where the rendering blends from until the next fixed update
+		auto view = m_Registry.view<WorldTransformComponent>();
+		for (auto entity : view)
+		{
+			auto& world = view.get(entity);
+			const auto& transform = m_Registry.get<TransformComponent>(entity);
+			world.PreviousTranslation = transform.Translation;
+			world.PreviousRotation = transform.Rotation;
+			world.PreviousScale = transform.Scale;
+			world.HasPrevious = true;
+		}
+
+		m_FrameTimestep = ts;
+		UpdateScripts();
+	}
+
+	void Scene::OnRenderRuntime(float interpolation)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Scene");
+
+		m_FrameRunsScripts = false;
+		m_FrameInterpolation = glm::clamp(interpolation, 0.0f, 1.0f);
+		m_FrameEditorCamera = nullptr;
+		m_RuntimeGraph.Execute();
+	}
+
+	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
+	{
+		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Scene");
+
+		m_FrameTimestep = ts;
+		m_FrameInterpolation = 1.0f;
+		m_FrameEditorCamera = &camera;
+		m_FrameViewProjection = camera.GetViewProjection();
+		m_EditorGraph.Execute();
+	}
+
+	void Scene::UpdateScripts()
+	{
+		Timestep ts = m_FrameTimestep;
+		m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto& nsc)
+		{
+				if (!nsc.Instance/*->m_Entity*/)
 				{
-					mainCamera = &camera.Camera;
-					cameraTransform = transform.GetTransform();
-					break;
+					nsc.Instance = nsc.InstantiateScript();
+					nsc.Instance->m_Entity = Entity{ entity, this };
+					nsc.Instance->OnCreate();
 				}
+
+				nsc.Instance->OnUpdate(ts);
+		});
+	}
+
+	void Scene::SelectPrimaryCamera()
+	{
+		m_FrameCamera = nullptr;
+
+		auto view = m_Registry.view<CameraComponent, WorldTransformComponent>();
+		for (auto entity : view)
+		{
+			auto [camera, transform] = view.get<CameraComponent, WorldTransformComponent>(entity);
+
+			if (camera.Primary)
+			{
+				uint32_t projectionVersion = camera.Camera.GetProjectionVersion();
+				if (entity != m_PrimaryCameraEntity || &camera.Camera != m_PrimaryCamera || projectionVersion != m_PrimaryCameraProjectionVersion || transform.Updated)
+				{
+					m_PrimaryCameraViewProjection = camera.Camera.GetProjection() * Math::InverseAffine(transform.Transform);
+					m_PrimaryCameraEntity = entity;
+					m_PrimaryCamera = &camera.Camera;
+					m_PrimaryCameraProjectionVersion = projectionVersion;
+				}
+
+				m_FrameCamera = &camera.Camera;
+				m_FrameViewProjection = m_PrimaryCameraViewProjection;
+				break;
 			}
 		}
+	}
+
+	void Scene::CullSprites()
+	{
+		m_VisibleSprites.clear();
+		if (!m_FrameCamera && !m_FrameEditorCamera)
+			return;
 
-		if (mainCamera)
+		// Frustum planes from the view-projection matrix (Gribb/Hartmann), clip z in [-w, w]
+		const glm::mat4& m = m_FrameViewProjection;
+		glm::vec4 rowX = { m[0][0], m[1][0], m[2][0], m[3][0] };
+		glm::vec4 rowY = { m[0][1], m[1][1], m[2][1], m[3][1] };
+		glm::vec4 rowZ = { m[0][2], m[1][2], m[2][2], m[3][2] };
+		glm::vec4 rowW = { m[0][3], m[1][3], m[2][3], m[3][3] };
+
+		glm::vec4 planes[6] = { rowW + rowX, rowW - rowX, rowW + rowY, rowW - rowY, rowW + rowZ, rowW - rowZ };
+		for (auto& plane : planes)
+			plane /= glm::length(glm::vec3(plane));
+
+		auto group = m_Registry.group<SpriteRendererComponent>(entt::get<WorldTransformComponent>);
+		const entt::entity* entities = group.data();
+		uint32_t count = (uint32_t)group.size();
+
+		m_SpriteVisibility.resize(count);
+		JobSystem::ParallelFor(count, 1024, [&](uint32_t i)
 		{
-			Renderer2D::BeginScene(*mainCamera, cameraTransform);
+			const glm::mat4& transform = group.get<WorldTransformComponent>(entities[i]).Transform;
 
-			auto group = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-			for (auto entity : group)
-			{
-				auto [sprite, transform] = group.get<SpriteRendererComponent, TransformComponent>(entity);
+			// Bounding sphere of the unit quad, conservative under scale and shear
+			glm::vec3 center = transform[3];
+			float radius = 0.5f * (glm::length(glm::vec3(transform[0])) + glm::length(glm::vec3(transform[1])));
 
-				Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
+			bool visible = true;
+			for (const auto& plane : planes)
+			{
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+				{
+					visible = false;
+					break;
+				}
 			}
+			m_SpriteVisibility[i] = visible;
+		});
 
-			Renderer2D::EndScene();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (m_SpriteVisibility[i])
+				m_VisibleSprites.push_back(entities[i]);
 		}
 	}
 
-	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
+	void Scene::SubmitSprites()
 	{
-		Renderer2D::BeginScene(camera);
+		if (!m_FrameCamera && !m_FrameEditorCamera)
+			return;
+
+		Renderer2D::BeginScene(m_FrameViewProjection);
 
-		auto group = m_Registry.group<SpriteRendererComponent>(entt::get<TransformComponent>);
-		for (auto entity : group)
+		auto group = m_Registry.group<SpriteRendererComponent>(entt::get<WorldTransformComponent>);
+		for (auto entity : m_VisibleSprites)
 		{
-			auto [sprite, transform] = group.get<SpriteRendererComponent, TransformComponent>(entity);
+			auto [sprite, transform] = group.get<SpriteRendererComponent, WorldTransformComponent>(entity);
 
-			Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
+			Renderer2D::DrawSprite(transform.Transform, sprite, (int)entity);
 		}
 
 		Renderer2D::EndScene();
 	}
 
+	void Scene::UpdateStats()
+	{
+		m_Stats.SpriteCount = (uint32_t)m_Registry.group<SpriteRendererComponent>(entt::get<WorldTransformComponent>).size();
+		m_Stats.VisibleSpriteCount = (uint32_t)m_VisibleSprites.size();
+	}
+
 	void Scene::OnViewportResize(uint32_t width, uint32_t height)
 	{
 		m_ViewportWidth = width;
@@ -141,6 +538,16 @@ namespace Hazel {
 	{
 	}
 
+	template<>
+	void Scene::OnComponentAdded<RelationshipComponent>(Entity entity, RelationshipComponent& component)
+	{
+	}
+
+	template<>
+	void Scene::OnComponentAdded<WorldTransformComponent>(Entity entity, WorldTransformComponent& component)
+	{
+	}
+
 	template<>
 	void Scene::OnComponentAdded<CameraComponent>(Entity entity, CameraComponent& component)
 	{
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Hazel/Core/Timestep.h"
+#include "Hazel/Core/TaskGraph.h"
 #include "Hazel/Renderer/EditorCamera.h"
+#include "Hazel/Scene/TagIndex.h"
 
 #include "entt.hpp"
 
@@ -9,30 +11,107 @@ namespace Hazel {
 
 	class Entity;
 
-	class Scene
+	class Scene : public SingleThreadedRefCounted
 	{
 	public:
 		Scene();
 		~Scene();
 
+		// Clones every entity with the same handle, for play mode. Component pools are copied
+		// whole and keep their order; script instances are not copied, the copy creates its own.
+		// Recycled handles come out in a different order than in the source.
+		static Ref<Scene> Copy(const Ref<Scene>& other);
+
 		Entity CreateEntity(const std::string name = std::string());
 		void DestroyEntity(Entity entity);
 
+		// Pass a null Entity to make the entity a root again
+		void SetParent(Entity entity, Entity parent);
+		Entity GetParent(Entity entity);
+		bool IsValid(Entity entity) const;
+
+		// Renames through the registry, so the tag index follows
+		void SetTag(Entity entity, const std::string& tag);
+
+		// Changes whenever an entity is created, destroyed or reparented
+		uint64_t GetHierarchyVersion() const { return m_HierarchyVersion; }
+		const TagIndex& GetTagIndex() const { return m_TagIndex; }
+
+		// Variable timestep: the scripts run with the frame's timestep, then the scene renders
 		void OnUpdateRuntime(Timestep ts);
+		// Fixed timestep: OnFixedUpdateRuntime runs the scripts, zero or more times a frame, and
+		// OnRenderRuntime renders once. Transforms the last fixed update changed are rendered
+		// blended from where they were before it, interpolation in [0, 1] goes from there to now.
+		void OnFixedUpdateRuntime(Timestep ts);
+		void OnRenderRuntime(float interpolation);
 		void OnUpdateEditor(Timestep ts, EditorCamera& camera);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
 		Entity GetPrimaryCameraEntity();
+
+		struct Statistics
+		{
+			uint32_t SpriteCount = 0;
+			uint32_t VisibleSpriteCount = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+		// The graphs expose the critical path measured during the last update
+		const TaskGraph& GetUpdateGraph(bool runtime) const { return runtime ? m_RuntimeGraph : m_EditorGraph; }
 	private:
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
+
+		void BuildUpdateGraphs();
+
+		// Update stages, scheduled by the task graphs
+		void UpdateScripts();
+		void UpdateWorldTransforms();
+		void SelectPrimaryCamera();
+		void CullSprites();
+		void SubmitSprites();
+		void UpdateStats();
+
+		void UpdateDepth(entt::entity entity, uint32_t depth);
+
+		void OnTagConstruct(entt::registry& registry, entt::entity entity);
+		void OnTagUpdate(entt::registry& registry, entt::entity entity);
+		void OnTagDestroy(entt::registry& registry, entt::entity entity);
 	private:
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
 
+		// Set whenever the parent-before-child order of the transform pools may be broken
+		bool m_HierarchyDirty = false;
+		uint64_t m_HierarchyVersion = 0;
+		TagIndex m_TagIndex;
+
+		TaskGraph m_RuntimeGraph;
+		TaskGraph m_EditorGraph;
+
+		// Per-frame state shared between the update stages
+		Timestep m_FrameTimestep = 0.0f;
+		bool m_FrameRunsScripts = true;
+		float m_FrameInterpolation = 1.0f;
+		Camera* m_FrameCamera = nullptr;
+		EditorCamera* m_FrameEditorCamera = nullptr;
+		glm::mat4 m_FrameViewProjection{ 1.0f };
+
+		// The primary camera's view-projection, reused while neither the camera's projection
+		// nor its world transform changes
+		entt::entity m_PrimaryCameraEntity = entt::null;
+		const Camera* m_PrimaryCamera = nullptr;
+		uint32_t m_PrimaryCameraProjectionVersion = 0;
+		glm::mat4 m_PrimaryCameraViewProjection{ 1.0f };
+		std::vector<uint8_t> m_SpriteVisibility;
+		std::vector<entt::entity> m_VisibleSprites;
+		Statistics m_Stats;
+
 		friend class Entity;
 		friend class SceneSerializer;
 		friend class SceneHierarchyPanel;
+		friend class SceneHistory;
+		friend class SceneSnapshotRing;
 	};
 
 }
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace Hazel {
 
 	SceneCamera::SceneCamera()
 	{
-		RecalculateProjection();
+		InvalidateProjection();
 	}
 
 	void SceneCamera::SetPerspective(float verticalFOV, float nearClip, float farClip)
@@ -16,7 +16,7 @@ namespace Hazel {
 		m_PerspectiveFOV = verticalFOV;
 		m_PerspectiveNear = nearClip;
 		m_PerspectiveFar = farClip;
-		RecalculateProjection();
+		InvalidateProjection();
 	}
 
 	void SceneCamera::SetOrthographic(float size, float nearClip, float farClip)
@@ -25,20 +25,37 @@ namespace Hazel {
 		m_OrthographicSize = size;
 		m_OrthographicNear = nearClip;
 		m_OrthographicFar = farClip;
-		RecalculateProjection();
+		InvalidateProjection();
 	}
 
 	void SceneCamera::SetViewportSize(uint32_t width, uint32_t height)
 	{
 		m_AspectRatio = (float)width / (float)height;
-		RecalculateProjection();
+		InvalidateProjection();
 	}
 
-	void SceneCamera::RecalculateProjection()
+	SceneCamera::Settings SceneCamera::GetSettings() const
+	{
+		return { m_ProjectionType, m_PerspectiveFOV, m_PerspectiveNear, m_PerspectiveFar, m_OrthographicSize, m_OrthographicNear, m_OrthographicFar };
+	}
+
+	void SceneCamera::SetSettings(const Settings& settings)
+	{
+		m_ProjectionType = settings.Type;
+		m_PerspectiveFOV = settings.PerspectiveFOV;
+		m_PerspectiveNear = settings.PerspectiveNear;
+		m_PerspectiveFar = settings.PerspectiveFar;
+		m_OrthographicSize = settings.OrthographicSize;
+		m_OrthographicNear = settings.OrthographicNear;
+		m_OrthographicFar = settings.OrthographicFar;
+		InvalidateProjection();
+	}
+
+	glm::mat4 SceneCamera::CalculateProjection() const
 	{
 		if (m_ProjectionType == ProjectionType::Perspective)
 		{
-			m_Projection = glm::perspective(m_PerspectiveFOV, m_AspectRatio, m_PerspectiveNear, m_PerspectiveFar);
+			return glm::perspective(m_PerspectiveFOV, m_AspectRatio, m_PerspectiveNear, m_PerspectiveFar);
 		}
 		else
 		{
@@ -47,7 +64,7 @@ namespace Hazel {
 			float orthoBottom = -m_OrthographicSize * 0.5f;
 			float orthoTop = m_OrthographicSize * 0.5f;
 
-			m_Projection = glm::ortho(orthoLeft, orthoRight, orthoBottom, orthoTop, m_OrthographicNear, m_OrthographicFar);
+			return glm::ortho(orthoLeft, orthoRight, orthoBottom, orthoTop, m_OrthographicNear, m_OrthographicFar);
 		}
 	}
 
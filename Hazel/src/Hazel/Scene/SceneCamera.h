@@ -2,12 +2,26 @@
 
 #include "Hazel/Renderer/Camera.h"
 
+#include <cstring>
+
 namespace Hazel {
 
 	class SceneCamera : public Camera
 	{
 	public:
 		enum class ProjectionType { Perspective = 0, Orthographic = 1 };
+
+		// Everything but the aspect ratio, which follows the viewport. Plain data without padding,
+		// it can be compared and copied as bytes.
+		struct Settings
+		{
+			ProjectionType Type;
+			float PerspectiveFOV, PerspectiveNear, PerspectiveFar;
+			float OrthographicSize, OrthographicNear, OrthographicFar;
+
+			bool operator==(const Settings& other) const { return std::memcmp(this, &other, sizeof(Settings)) == 0; }
+			bool operator!=(const Settings& other) const { return !(*this == other); }
+		};
 	public:
 		SceneCamera();
 		virtual ~SceneCamera() = default;
@@ -17,24 +31,27 @@ namespace Hazel {
 
 		void SetViewportSize(uint32_t width, uint32_t height);
 
+		Settings GetSettings() const;
+		void SetSettings(const Settings& settings);
+
 		float GetPerspectiveVerticalFOV() const { return m_PerspectiveFOV; }
-		void SetPerspectiveVerticalFOV(float verticalFOV) { m_PerspectiveFOV = verticalFOV; RecalculateProjection(); }
+		void SetPerspectiveVerticalFOV(float verticalFOV) { m_PerspectiveFOV = verticalFOV; InvalidateProjection(); }
 		float GetPerspectiveNearClip() const { return m_PerspectiveNear; }
-		void SetPerspectiveNearClip(float nearClip) { m_PerspectiveNear = nearClip; RecalculateProjection(); }
+		void SetPerspectiveNearClip(float nearClip) { m_PerspectiveNear = nearClip; InvalidateProjection(); }
 		float GetPerspectiveFarClip() const { return m_PerspectiveFar; }
-		void SetPerspectiveFarClip(float farClip) { m_PerspectiveFar = farClip; RecalculateProjection(); }
+		void SetPerspectiveFarClip(float farClip) { m_PerspectiveFar = farClip; InvalidateProjection(); }
 
 		float GetOrthographicSize() const { return m_OrthographicSize; }
-		void SetOrthographicSize(float size) { m_OrthographicSize = size; RecalculateProjection(); }
+		void SetOrthographicSize(float size) { m_OrthographicSize = size; InvalidateProjection(); }
 		float GetOrthographicNearClip() const { return m_OrthographicNear; }
-		void SetOrthographicNearClip(float nearClip) { m_OrthographicNear = nearClip; RecalculateProjection(); }
+		void SetOrthographicNearClip(float nearClip) { m_OrthographicNear = nearClip; InvalidateProjection(); }
 		float GetOrthographicFarClip() const { return m_OrthographicFar; }
-		void SetOrthographicFarClip(float farClip) { m_OrthographicFar = farClip; RecalculateProjection(); }
+		void SetOrthographicFarClip(float farClip) { m_OrthographicFar = farClip; InvalidateProjection(); }
 
 		ProjectionType GetProjectionType() const { return m_ProjectionType; }
-		void SetProjectionType(ProjectionType type) { m_ProjectionType = type; RecalculateProjection(); }
-	private:
-		void RecalculateProjection();
+		void SetProjectionType(ProjectionType type) { m_ProjectionType = type; InvalidateProjection(); }
+	protected:
+		glm::mat4 CalculateProjection() const override;
 	private:
 		ProjectionType m_ProjectionType = ProjectionType::Orthographic;
 
@@ -0,0 +1,388 @@
+#include "hzpch.h"
+#include "SceneHistory.h"
+
+#include "Components.h"
+
+#include <cstring>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		template<typename T>
+		static void Write(std::vector<uint8_t>& bytes, const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			size_t offset = bytes.size();
+			bytes.resize(offset + sizeof(T));
+			std::memcpy(bytes.data() + offset, &value, sizeof(T));
+		}
+
+		template<typename T>
+		static T Read(const uint8_t*& data)
+		{
+			T value;
+			std::memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+			return value;
+		}
+
+		// Flags of the optional components in a state
+		enum StateFlags : uint8_t
+		{
+			HasSprite = 1 << 0,
+			HasCamera = 1 << 1,
+			HasScript = 1 << 2
+		};
+
+
+		// Only the binding, a running instance belongs to the runtime
+		struct ScriptState
+		{
+			ScriptableEntity*(*InstantiateScript)();
+			void(*DestroyScript)(NativeScriptComponent*);
+		};
+
+	}
+
+	SceneHistory::SceneHistory(size_t memoryBudget)
+		: m_MemoryBudget(memoryBudget)
+	{
+	}
+
+	void SceneHistory::SetContext(const Ref<Scene>& context)
+	{
+		m_Context = context;
+		Clear();
+	}
+
+	// Layout: parent, transform, flags, then the present optional components, the tag last
+	// since it is the only part that changes size
+	void SceneHistory::WriteState(entt::entity entity, std::vector<uint8_t>& outState) const
+	{
+		outState.clear();
+		auto& registry = m_Context->m_Registry;
+		if (!registry.valid(entity))
+			return;
+
+		Utils::Write(outState, registry.get<RelationshipComponent>(entity).Parent);
+		Utils::Write(outState, registry.get<TransformComponent>(entity));
+
+		auto [sprite, camera, script] = registry.try_get<SpriteRendererComponent, CameraComponent, NativeScriptComponent>(entity);
+		uint8_t flags = (sprite ? Utils::HasSprite : 0) | (camera ? Utils::HasCamera : 0) | (script ? Utils::HasScript : 0);
+		Utils::Write(outState, flags);
+
+		if (sprite)
+			Utils::Write(outState, sprite->Color);
+		if (camera)
+		{
+			Utils::Write(outState, camera->Camera.GetSettings());
+			Utils::Write(outState, (uint8_t)camera->Primary);
+			Utils::Write(outState, (uint8_t)camera->FixedAspectRatio);
+		}
+		if (script)
+			Utils::Write(outState, Utils::ScriptState{ script->InstantiateScript, script->DestroyScript });
+
+		const std::string& tag = registry.get<TagComponent>(entity).Tag;
+		outState.insert(outState.end(), tag.begin(), tag.end());
+	}
+
+	void SceneHistory::ReadState(entt::entity entity, const std::vector<uint8_t>& state)
+	{
+		auto& registry = m_Context->m_Registry;
+		if (state.empty())
+		{
+			if (registry.valid(entity))
+				m_Context->DestroyEntity({ entity, m_Context.get() });
+			return;
+		}
+
+		const uint8_t* data = state.data();
+		const uint8_t* end = state.data() + state.size();
+		auto parent = Utils::Read<entt::entity>(data);
+		auto transform = Utils::Read<TransformComponent>(data);
+		auto flags = Utils::Read<uint8_t>(data);
+
+		Entity handle{ entity, m_Context.get() };
+		if (!registry.valid(entity))
+		{
+			// Same handle as before, later entries refer to it
+			entt::entity created = registry.create(entity);
+			HZ_CORE_ASSERT(created == entity, "Entity handle is taken, the scene changed outside the history!");
+			handle.AddComponent<TransformComponent>();
+			handle.AddComponent<RelationshipComponent>();
+			handle.AddComponent<WorldTransformComponent>();
+			handle.AddComponent<TagComponent>();
+		}
+
+		handle.GetComponent<TransformComponent>() = transform;
+		handle.GetComponent<WorldTransformComponent>().Dirty = true;
+		m_Context->SetParent(handle, parent == entt::null ? Entity{} : Entity{ parent, m_Context.get() });
+
+		if (flags & Utils::HasSprite)
+		{
+			auto color = Utils::Read<glm::vec4>(data);
+			registry.get_or_emplace<SpriteRendererComponent>(entity).Color = color;
+		}
+		else
+		{
+			registry.remove_if_exists<SpriteRendererComponent>(entity);
+		}
+
+		if (flags & Utils::HasCamera)
+		{
+			auto settings = Utils::Read<SceneCamera::Settings>(data);
+			auto primary = Utils::Read<uint8_t>(data);
+			auto fixedAspectRatio = Utils::Read<uint8_t>(data);
+			if (!handle.HasComponent<CameraComponent>())
+				handle.AddComponent<CameraComponent>();
+
+			auto& camera = handle.GetComponent<CameraComponent>();
+			camera.Camera.SetSettings(settings);
+			camera.Primary = primary;
+			camera.FixedAspectRatio = fixedAspectRatio;
+		}
+		else
+		{
+			registry.remove_if_exists<CameraComponent>(entity);
+		}
+
+		if (flags & Utils::HasScript)
+		{
+			auto scriptState = Utils::Read<Utils::ScriptState>(data);
+			auto& script = registry.get_or_emplace<NativeScriptComponent>(entity);
+			script.InstantiateScript = scriptState.InstantiateScript;
+			script.DestroyScript = scriptState.DestroyScript;
+		}
+		else
+		{
+			registry.remove_if_exists<NativeScriptComponent>(entity);
+		}
+
+		std::string tag((const char*)data, (const char*)end);
+		if (handle.GetComponent<TagComponent>().Tag != tag)
+			m_Context->SetTag(handle, tag);
+	}
+
+	void SceneHistory::AddChange(Entry& entry, entt::entity entity, const std::vector<uint8_t>& before, const std::vector<uint8_t>& after)
+	{
+		// Everything between the first and the last differing byte
+		size_t common = std::min(before.size(), after.size());
+		size_t prefix = 0;
+		while (prefix < common && before[prefix] == after[prefix])
+			prefix++;
+		size_t suffix = 0;
+		while (suffix < common - prefix && before[before.size() - 1 - suffix] == after[after.size() - 1 - suffix])
+			suffix++;
+
+		Change change;
+		change.Entity = entity;
+		change.Offset = (uint32_t)prefix;
+		change.BeforeSize = (uint32_t)(before.size() - prefix - suffix);
+		change.AfterSize = (uint32_t)(after.size() - prefix - suffix);
+		change.BeforeStateSize = (uint32_t)before.size();
+		change.AfterStateSize = (uint32_t)after.size();
+		entry.Changes.push_back(change);
+
+		entry.Bytes.insert(entry.Bytes.end(), before.begin() + prefix, before.begin() + prefix + change.BeforeSize);
+		entry.Bytes.insert(entry.Bytes.end(), after.begin() + prefix, after.begin() + prefix + change.AfterSize);
+	}
+
+	void SceneHistory::Apply(const Entry& entry, bool undo)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Where each change's ranges start in the entry's bytes
+		std::vector<size_t> rangeOffsets(entry.Changes.size());
+		size_t offset = 0;
+		for (size_t i = 0; i < entry.Changes.size(); i++)
+		{
+			rangeOffsets[i] = offset;
+			offset += entry.Changes[i].BeforeSize + entry.Changes[i].AfterSize;
+		}
+
+		// Undo runs backwards, so parents come back before their children
+		for (size_t n = 0; n < entry.Changes.size(); n++)
+		{
+			size_t i = undo ? entry.Changes.size() - 1 - n : n;
+			const Change& change = entry.Changes[i];
+			const uint8_t* before = entry.Bytes.data() + rangeOffsets[i];
+			const uint8_t* after = before + change.BeforeSize;
+
+			std::vector<uint8_t>& current = m_ScratchState;
+			WriteState(change.Entity, current);
+			HZ_CORE_ASSERT(current.size() == (undo ? change.AfterStateSize : change.BeforeStateSize), "Scene changed outside the history!");
+
+			// Swap the range for the other side's
+			const uint8_t* range = undo ? before : after;
+			uint32_t rangeSize = undo ? change.BeforeSize : change.AfterSize;
+			uint32_t replacedSize = undo ? change.AfterSize : change.BeforeSize;
+
+			std::vector<uint8_t>& target = m_ScratchState2;
+			target.assign(current.begin(), current.begin() + change.Offset);
+			target.insert(target.end(), range, range + rangeSize);
+			target.insert(target.end(), current.begin() + change.Offset + replacedSize, current.end());
+			ReadState(change.Entity, target);
+		}
+	}
+
+	void SceneHistory::Track(Entity entity, bool continuing)
+	{
+		if (!m_Context)
+			return;
+
+		// Destroyed along with a parent, or by undo
+		entt::entity handle = entity;
+		if (handle != entt::null && !m_Context->m_Registry.valid(handle))
+			handle = entt::null;
+
+		if (handle != m_TrackedEntity)
+		{
+			// A different selection starts from its current state
+			m_TrackedEntity = handle;
+			WriteState(handle, m_TrackedState);
+			m_EntryOpen = false;
+			return;
+		}
+		if (handle == entt::null)
+			return;
+
+		std::vector<uint8_t>& state = m_ScratchState;
+		WriteState(handle, state);
+		if (state != m_TrackedState)
+		{
+			Entry entry;
+			if (m_EntryOpen)
+			{
+				// Still the same edit: one change from where it started
+				HZ_CORE_ASSERT(m_Position == m_Entries.size(), "Open entry is not the last one!");
+				AddChange(entry, handle, m_OpenEntryState, state);
+				m_MemoryUsage -= m_Entries.back().GetMemoryUsage();
+				m_Entries.pop_back();
+				m_Position--;
+			}
+			else
+			{
+				AddChange(entry, handle, m_TrackedState, state);
+				m_OpenEntryState = m_TrackedState;
+			}
+			Push(std::move(entry));
+			m_EntryOpen = true;
+			m_TrackedState.swap(state);
+		}
+
+		if (!continuing)
+			m_EntryOpen = false;
+	}
+
+	Entity SceneHistory::CreateEntity(const std::string& name)
+	{
+		Entity entity = m_Context->CreateEntity(name);
+
+		Entry entry;
+		std::vector<uint8_t>& state = m_ScratchState;
+		WriteState(entity, state);
+		AddChange(entry, entity, {}, state);
+		Push(std::move(entry));
+		return entity;
+	}
+
+	void SceneHistory::DestroyEntity(Entity entity)
+	{
+		// Children first, undo brings them back after their parent
+		Entry entry;
+		std::vector<uint8_t>& state = m_ScratchState;
+		auto& registry = m_Context->m_Registry;
+		std::function<void(entt::entity)> record = [&](entt::entity current)
+		{
+			for (entt::entity child = registry.get<RelationshipComponent>(current).FirstChild; child != entt::null; child = registry.get<RelationshipComponent>(child).NextSibling)
+				record(child);
+
+			WriteState(current, state);
+			AddChange(entry, current, state, {});
+		};
+		record(entity);
+
+		m_Context->DestroyEntity(entity);
+		Push(std::move(entry));
+	}
+
+	bool SceneHistory::Undo()
+	{
+		if (!CanUndo())
+			return false;
+
+		m_Position--;
+		Apply(m_Entries[m_Position], true);
+		ResetTracking();
+		return true;
+	}
+
+	bool SceneHistory::Redo()
+	{
+		if (!CanRedo())
+			return false;
+
+		Apply(m_Entries[m_Position], false);
+		m_Position++;
+		ResetTracking();
+		return true;
+	}
+
+	void SceneHistory::Clear()
+	{
+		m_Entries.clear();
+		m_Position = 0;
+		m_MemoryUsage = 0;
+		m_TrackedEntity = entt::null;
+		m_TrackedState.clear();
+		m_EntryOpen = false;
+	}
+
+	void SceneHistory::SetMemoryBudget(size_t bytes)
+	{
+		m_MemoryBudget = bytes;
+		TrimToBudget();
+	}
+
+	void SceneHistory::Push(Entry&& entry)
+	{
+		// A new edit drops whatever could have been redone
+		while (m_Entries.size() > m_Position)
+		{
+			m_MemoryUsage -= m_Entries.back().GetMemoryUsage();
+			m_Entries.pop_back();
+		}
+
+		entry.Changes.shrink_to_fit();
+		entry.Bytes.shrink_to_fit();
+		m_MemoryUsage += entry.GetMemoryUsage();
+		m_Entries.push_back(std::move(entry));
+		m_Position = m_Entries.size();
+
+		// Whatever happened, the tracked state is the scene's again
+		m_EntryOpen = false;
+		TrimToBudget();
+	}
+
+	void SceneHistory::TrimToBudget()
+	{
+		while (m_MemoryUsage > m_MemoryBudget && m_Entries.size() > 1)
+		{
+			m_MemoryUsage -= m_Entries.front().GetMemoryUsage();
+			m_Entries.pop_front();
+			if (m_Position > 0)
+				m_Position--;
+		}
+	}
+
+	// After undo/redo the tracked entity's state is the new starting point, not an edit
+	void SceneHistory::ResetTracking()
+	{
+		if (m_TrackedEntity != entt::null && !m_Context->m_Registry.valid(m_TrackedEntity))
+			m_TrackedEntity = entt::null;
+		WriteState(m_TrackedEntity, m_TrackedState);
+		m_EntryOpen = false;
+	}
+
+}
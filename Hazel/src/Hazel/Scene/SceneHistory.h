@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+#include "Hazel/Scene/Scene.h"
+#include "Hazel/Scene/Entity.h"
+
+#include <deque>
+#include <vector>
+
+namespace Hazel {
+
+	// Undo/redo for editor changes to a scene. An entity's editable state is written out
+	// as a small byte string (tag, transform, parent, sprite, camera, script binding);
+	// an undo entry stores only the bytes that differ between before and after, plus
+	// the whole state for created and destroyed entities. Entities come back with the
+	// same handle, so older entries stay valid.
+	class SceneHistory
+	{
+	public:
+		SceneHistory(size_t memoryBudget = 16 * 1024 * 1024);
+
+		// Clears the history
+		void SetContext(const Ref<Scene>& context);
+
+		// Call once a frame after the editor UI ran. Whatever changed on the entity since the
+		// last call becomes an undo entry. While `continuing` is set (a drag, a gizmo, a text
+		// field being typed in) further changes merge into that same entry.
+		void Track(Entity entity, bool continuing);
+
+		// Structural changes go through the history so they can be undone
+		Entity CreateEntity(const std::string& name);
+		void DestroyEntity(Entity entity);
+
+		bool Undo();
+		bool Redo();
+		bool CanUndo() const { return m_Position > 0; }
+		bool CanRedo() const { return m_Position < m_Entries.size(); }
+		void Clear();
+
+		// The oldest entries go once the history takes up more than the budget.
+		// The newest entry is always kept, however large.
+		void SetMemoryBudget(size_t bytes);
+		size_t GetMemoryBudget() const { return m_MemoryBudget; }
+		size_t GetMemoryUsage() const { return m_MemoryUsage; }
+		uint32_t GetEntryCount() const { return (uint32_t)m_Entries.size(); }
+	private:
+		// One entity's state went from Before to After, both stored as the differing byte range.
+		// An empty state means the entity does not exist.
+		struct Change
+		{
+			entt::entity Entity;
+			uint32_t Offset;     // Of the range, the bytes before it are the same on both sides
+			uint32_t BeforeSize; // Of the range
+			uint32_t AfterSize;
+			uint32_t BeforeStateSize; // Whole state, 0 when the entity did not exist
+			uint32_t AfterStateSize;
+		};
+
+		struct Entry
+		{
+			std::vector<Change> Changes;
+			std::vector<uint8_t> Bytes; // Each change's before range then its after range
+
+			size_t GetMemoryUsage() const { return sizeof(Entry) + Changes.capacity() * sizeof(Change) + Bytes.capacity(); }
+		};
+
+		void WriteState(entt::entity entity, std::vector<uint8_t>& outState) const;
+		void ReadState(entt::entity entity, const std::vector<uint8_t>& state);
+
+		static void AddChange(Entry& entry, entt::entity entity, const std::vector<uint8_t>& before, const std::vector<uint8_t>& after);
+		void Apply(const Entry& entry, bool undo);
+
+		void Push(Entry&& entry);
+		void TrimToBudget();
+		void ResetTracking();
+	private:
+		Ref<Scene> m_Context;
+
+		std::deque<Entry> m_Entries;
+		size_t m_Position = 0; // Entries before it are undoable, from it on redoable
+		size_t m_MemoryUsage = 0;
+		size_t m_MemoryBudget;
+
+		// The tracked entity's state as of the last Track call
+		entt::entity m_TrackedEntity = entt::null;
+		std::vector<uint8_t> m_TrackedState;
+		// The last entry is still being edited, and its entity's state when that began
+		bool m_EntryOpen = false;
+		std::vector<uint8_t> m_OpenEntryState;
+
+		std::vector<uint8_t> m_ScratchState, m_ScratchState2;
+	};
+
+}
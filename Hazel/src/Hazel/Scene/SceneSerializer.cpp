@@ -88,7 +88,8 @@ namespace Hazel {
 	static void SerializeEntity(YAML::Emitter& out, Entity entity)
 	{
 		out << YAML::BeginMap; // Entity
-		out << YAML::Key << "Entity" << YAML::Value << "12837192831273"; // TODO: Entity ID goes here
+		// The handle, unique within the file; parents are referred to by it
+		out << YAML::Key << "Entity" << YAML::Value << (uint32_t)entity;
 
 		if (entity.HasComponent<TagComponent>())
 		{
@@ -150,11 +151,38 @@ namespace Hazel {
 			out << YAML::EndMap; // SpriteRendererComponent
 		}
 
+		auto& relationshipComponent = entity.GetComponent<RelationshipComponent>();
+		if (relationshipComponent.Parent != entt::null)
+		{
+			out << YAML::Key << "RelationshipComponent";
+			out << YAML::BeginMap; // RelationshipComponent
+
+			out << YAML::Key << "Parent" << YAML::Value << (uint32_t)relationshipComponent.Parent;
+
+			out << YAML::EndMap; // RelationshipComponent
+		}
+
 		out << YAML::EndMap; // Entity
 	}
 
+	// Children follow their parent in sibling order, loading relies on it
+	static void SerializeEntityTree(YAML::Emitter& out, Entity entity, Scene* scene)
+	{
+		SerializeEntity(out, entity);
+
+		auto child = entity.GetComponent<RelationshipComponent>().FirstChild;
+		while (child != entt::null)
+		{
+			Entity childEntity = { child, scene };
+			SerializeEntityTree(out, childEntity, scene);
+			child = childEntity.GetComponent<RelationshipComponent>().NextSibling;
+		}
+	}
+
 	void SceneSerializer::Serialize(const std::string& filepath)
 	{
+		HZ_MEMORY_SCOPE("SceneSerializer");
+
 		YAML::Emitter out;
 		out << YAML::BeginMap;
 		out << YAML::Key << "Scene" << YAML::Value << "Untitled";
@@ -162,10 +190,10 @@ namespace Hazel {
 		m_Scene->m_Registry.each([&](auto entityID)
 			{
 				Entity entity = { entityID, m_Scene.get() };
-				if (!entity)
+				if (!entity || entity.GetComponent<RelationshipComponent>().Parent != entt::null)
 					return;
 
-				SerializeEntity(out, entity);
+				SerializeEntityTree(out, entity, m_Scene.get());
 			});
 		out << YAML::EndSeq;
 		out << YAML::EndMap;
@@ -182,6 +210,8 @@ namespace Hazel {
 
 	bool SceneSerializer::Deserialize(const std::string& filepath)
 	{
+		HZ_MEMORY_SCOPE("SceneSerializer");
+
 		YAML::Node data = YAML::LoadFile(filepath);
 		if (!data["Scene"])
 			return false;
@@ -192,9 +222,13 @@ namespace Hazel {
 		auto entities = data["Entities"];
 		if (entities)
 		{
+			// Parents are linked once every entity exists, a child may come before its parent
+			std::unordered_map<uint64_t, Entity> entityMap;
+			std::vector<std::pair<Entity, uint64_t>> parentIDs;
+
 			for (auto entity : entities)
 			{
-				uint64_t uuid = entity["Entity"].as<uint64_t>(); // TODO
+				uint64_t uuid = entity["Entity"].as<uint64_t>();
 
 				std::string name;
 				auto tagComponent = entity["TagComponent"];
@@ -204,6 +238,11 @@ namespace Hazel {
 				HZ_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
 
 				Entity deserializedEntity = m_Scene->CreateEntity(name);
+				entityMap[uuid] = deserializedEntity;
+
+				auto relationshipComponent = entity["RelationshipComponent"];
+				if (relationshipComponent)
+					parentIDs.emplace_back(deserializedEntity, relationshipComponent["Parent"].as<uint64_t>());
 
 				auto transformComponent = entity["TransformComponent"];
 				if (transformComponent)
@@ -242,6 +281,19 @@ namespace Hazel {
 					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
 				}
 			}
+
+			// SetParent links as the first child, going backwards keeps the file's sibling order
+			for (auto it = parentIDs.rbegin(); it != parentIDs.rend(); ++it)
+			{
+				auto parent = entityMap.find(it->second);
+				if (parent == entityMap.end())
+				{
+					HZ_CORE_WARN("Entity '{0}' has an unknown parent ({1}), it stays a root", it->first.GetComponent<TagComponent>().Tag, it->second);
+					continue;
+				}
+
+				m_Scene->SetParent(it->first, parent->second);
+			}
 		}
 
 		return true;
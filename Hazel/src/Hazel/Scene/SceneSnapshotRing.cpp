@@ -0,0 +1,449 @@
+#include "hzpch.h"
+#include "SceneSnapshotRing.h"
+
+#include "Entity.h"
+#include "Components.h"
+
+#include <cstring>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static void Append(std::vector<uint8_t>& bytes, const void* data, size_t size)
+		{
+			size_t offset = bytes.size();
+			bytes.resize(offset + size);
+			if (size)
+				std::memcpy(bytes.data() + offset, data, size);
+		}
+
+		template<typename T>
+		static void Append(std::vector<uint8_t>& bytes, const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			Append(bytes, &value, sizeof(T));
+		}
+
+		static uint64_t LoadWord(const uint8_t* data, size_t word)
+		{
+			uint64_t value;
+			std::memcpy(&value, data + word * sizeof(uint64_t), sizeof(uint64_t));
+			return value;
+		}
+
+		// prev against next: u32 size of prev, then prev ^ next over the words both have, as runs of
+		// unchanged and changed words { u32 unchanged, u32 changed, the changed words' XOR }...,
+		// then the rest of prev as it is
+		static void EncodeXor(const std::vector<uint8_t>& prev, const std::vector<uint8_t>& next, std::vector<uint8_t>& out)
+		{
+			out.clear();
+			Append(out, (uint32_t)prev.size());
+
+			size_t words = std::min(prev.size(), next.size()) / sizeof(uint64_t);
+			size_t word = 0;
+			while (word < words)
+			{
+				size_t unchangedStart = word;
+				while (word < words && LoadWord(prev.data(), word) == LoadWord(next.data(), word))
+					word++;
+				size_t changedStart = word;
+				while (word < words && LoadWord(prev.data(), word) != LoadWord(next.data(), word))
+					word++;
+				if (changedStart == word)
+					break; // Unchanged up to the end
+
+				Append(out, (uint32_t)(changedStart - unchangedStart));
+				Append(out, (uint32_t)(word - changedStart));
+				for (size_t i = changedStart; i < word; i++)
+					Append(out, LoadWord(prev.data(), i) ^ LoadWord(next.data(), i));
+			}
+			// A run with no changed words ends the runs
+			Append(out, (uint32_t)0);
+			Append(out, (uint32_t)0);
+
+			size_t rest = words * sizeof(uint64_t);
+			Append(out, prev.data() + rest, prev.size() - rest);
+		}
+
+		// Turns next back into prev, in place
+		static void ApplyXor(const std::vector<uint8_t>& encoded, std::vector<uint8_t>& data)
+		{
+			const uint8_t* it = encoded.data();
+			uint32_t size;
+			std::memcpy(&size, it, sizeof(uint32_t));
+			it += sizeof(uint32_t);
+
+			size_t word = 0;
+			while (true)
+			{
+				uint32_t unchanged, changed;
+				std::memcpy(&unchanged, it, sizeof(uint32_t));
+				std::memcpy(&changed, it + sizeof(uint32_t), sizeof(uint32_t));
+				it += 2 * sizeof(uint32_t);
+				if (changed == 0)
+					break;
+
+				word += unchanged;
+				for (uint32_t i = 0; i < changed; i++, word++, it += sizeof(uint64_t))
+				{
+					uint64_t value = LoadWord(data.data(), word) ^ LoadWord(it, 0);
+					std::memcpy(data.data() + word * sizeof(uint64_t), &value, sizeof(uint64_t));
+				}
+			}
+
+			size_t rest = std::min((size_t)size, data.size()) / sizeof(uint64_t) * sizeof(uint64_t);
+			data.resize(size);
+			if (size > rest)
+				std::memcpy(data.data() + rest, it, size - rest);
+		}
+
+		// Pool layout: u32 count, the packed entities, the components as they are
+		template<typename Component>
+		static void WritePool(const entt::registry& registry, std::vector<uint8_t>& out)
+		{
+			static_assert(std::is_trivially_copyable_v<Component>);
+			uint32_t count = (uint32_t)registry.size<Component>();
+			Append(out, count);
+			Append(out, registry.data<Component>(), count * sizeof(entt::entity));
+			Append(out, registry.raw<Component>(), count * sizeof(Component));
+		}
+
+		static const entt::entity* ReadPoolEntities(const std::vector<uint8_t>& section, uint32_t& outCount)
+		{
+			std::memcpy(&outCount, section.data(), sizeof(uint32_t));
+			return (const entt::entity*)(section.data() + sizeof(uint32_t));
+		}
+
+		static bool SameEntities(const entt::entity* a, const entt::entity* b, size_t count)
+		{
+			return std::memcmp(a, b, count * sizeof(entt::entity)) == 0;
+		}
+
+		// Compares registry entity lists by their live slots only. Restoring brings entities back
+		// but not the free list threaded through the dead slots, so those differ after a restore.
+		static bool SameLiveEntities(const entt::entity* a, size_t aCount, const entt::entity* b, size_t bCount)
+		{
+			if (aCount == bCount && SameEntities(a, b, aCount))
+				return true;
+
+			constexpr auto entityMask = entt::entt_traits<std::underlying_type_t<entt::entity>>::entity_mask;
+			for (size_t i = 0; i < std::max(aCount, bCount); i++)
+			{
+				bool aliveA = i < aCount && (entt::to_integral(a[i]) & entityMask) == i;
+				bool aliveB = i < bCount && (entt::to_integral(b[i]) & entityMask) == i;
+				if (aliveA != aliveB || (aliveA && a[i] != b[i]))
+					return false;
+			}
+			return true;
+		}
+
+		// Returns true when the pool's contents changed. Same entities in the same order
+		// overwrite the components in place, otherwise the pool is rebuilt in snapshot order.
+		template<typename Component>
+		static bool ReadPool(entt::registry& registry, const std::vector<uint8_t>& section)
+		{
+			uint32_t count;
+			const entt::entity* entities = ReadPoolEntities(section, count);
+			const Component* components = (const Component*)(entities + count);
+
+			if (registry.size<Component>() == count && SameEntities(registry.data<Component>(), entities, count))
+			{
+				if (std::memcmp(registry.raw<Component>(), components, count * sizeof(Component)) == 0)
+					return false;
+
+				std::memcpy(registry.raw<Component>(), components, count * sizeof(Component));
+				return true;
+			}
+
+			registry.clear<Component>();
+			registry.insert<Component>(entities, entities + count, components, components + count);
+			return true;
+		}
+
+	}
+
+	SceneSnapshotRing::SceneSnapshotRing(const Ref<Scene>& scene, uint32_t capacity)
+		: m_Scene(scene), m_Capacity(capacity)
+	{
+		HZ_CORE_ASSERT(capacity > 0, "Snapshot ring needs room for a snapshot!");
+	}
+
+	void SceneSnapshotRing::WriteState(State& outState) const
+	{
+		HZ_PROFILE_FUNCTION();
+
+		for (auto& section : outState)
+			section.clear();
+
+		const auto& registry = m_Scene->m_Registry;
+
+		// The entity slots as they are, free ones included
+		Utils::Append(outState[EntitiesSection], registry.data(), registry.size() * sizeof(entt::entity));
+
+		Utils::WritePool<TransformComponent>(registry, outState[TransformSection]);
+		Utils::WritePool<RelationshipComponent>(registry, outState[RelationshipSection]);
+		Utils::WritePool<SpriteRendererComponent>(registry, outState[SpriteSection]);
+
+		// Tags: count, entities, lengths, then the characters, so a rename that keeps the length
+		// leaves the rest of the section in place
+		{
+			std::vector<uint8_t>& out = outState[TagSection];
+			uint32_t count = (uint32_t)registry.size<TagComponent>();
+			const TagComponent* tags = registry.raw<TagComponent>();
+			Utils::Append(out, count);
+			Utils::Append(out, registry.data<TagComponent>(), count * sizeof(entt::entity));
+
+			size_t characters = 0;
+			for (uint32_t i = 0; i < count; i++)
+				characters += tags[i].Tag.size();
+
+			size_t offset = out.size();
+			out.resize(offset + count * sizeof(uint32_t) + characters);
+			uint8_t* lengths = out.data() + offset;
+			uint8_t* it = lengths + count * sizeof(uint32_t);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t length = (uint32_t)tags[i].Tag.size();
+				std::memcpy(lengths + i * sizeof(uint32_t), &length, sizeof(uint32_t));
+				std::memcpy(it, tags[i].Tag.data(), length);
+				it += length;
+			}
+		}
+
+		// Cameras: count, entities, settings, then the flags
+		{
+			std::vector<uint8_t>& out = outState[CameraSection];
+			uint32_t count = (uint32_t)registry.size<CameraComponent>();
+			const CameraComponent* cameras = registry.raw<CameraComponent>();
+			Utils::Append(out, count);
+			Utils::Append(out, registry.data<CameraComponent>(), count * sizeof(entt::entity));
+			for (uint32_t i = 0; i < count; i++)
+				Utils::Append(out, cameras[i].Camera.GetSettings());
+			for (uint32_t i = 0; i < count; i++)
+			{
+				Utils::Append(out, (uint8_t)cameras[i].Primary);
+				Utils::Append(out, (uint8_t)cameras[i].FixedAspectRatio);
+			}
+		}
+	}
+
+	void SceneSnapshotRing::ReadState(const State& state)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Scene& scene = *m_Scene;
+		auto& registry = scene.m_Registry;
+		constexpr auto entityMask = entt::entt_traits<std::underlying_type_t<entt::entity>>::entity_mask;
+
+		// Entities that came or went since, the pools below bring their components back
+		const entt::entity* entities = (const entt::entity*)state[EntitiesSection].data();
+		size_t entityCount = state[EntitiesSection].size() / sizeof(entt::entity);
+		bool entitiesChanged = !Utils::SameLiveEntities(registry.data(), registry.size(), entities, entityCount);
+		if (entitiesChanged)
+		{
+			for (size_t i = 0; i < registry.size(); i++)
+			{
+				entt::entity current = registry.data()[i];
+				bool alive = (entt::to_integral(current) & entityMask) == i;
+				if (alive && (i >= entityCount || entities[i] != current))
+				{
+					if (auto* nsc = registry.try_get<NativeScriptComponent>(current); nsc && nsc->Instance)
+						nsc->DestroyScript(nsc);
+					registry.destroy(current);
+				}
+			}
+
+			for (size_t i = 0; i < entityCount; i++)
+			{
+				entt::entity entity = entities[i];
+				if ((entt::to_integral(entity) & entityMask) == i && !registry.valid(entity))
+				{
+					registry.create(entity);
+					registry.emplace<WorldTransformComponent>(entity);
+				}
+			}
+		}
+
+		Utils::ReadPool<TransformComponent>(registry, state[TransformSection]);
+		bool relationshipsChanged = Utils::ReadPool<RelationshipComponent>(registry, state[RelationshipSection]);
+		Utils::ReadPool<SpriteRendererComponent>(registry, state[SpriteSection]);
+
+		// Tags go through the scene so the tag index follows
+		{
+			uint32_t count;
+			const entt::entity* tagEntities = Utils::ReadPoolEntities(state[TagSection], count);
+			const uint8_t* lengths = (const uint8_t*)(tagEntities + count);
+			const char* characters = (const char*)(lengths + count * sizeof(uint32_t));
+
+			// Only what differs is touched, every tag that is set or removed costs a tag index update
+			bool sameEntities = registry.size<TagComponent>() == count && Utils::SameEntities(registry.data<TagComponent>(), tagEntities, count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t length;
+				std::memcpy(&length, lengths + i * sizeof(uint32_t), sizeof(uint32_t));
+				std::string_view tag(characters, length);
+				characters += length;
+
+				const TagComponent* current = sameEntities ? &registry.raw<TagComponent>()[i] : registry.try_get<TagComponent>(tagEntities[i]);
+				if (!current)
+					registry.emplace<TagComponent>(tagEntities[i], std::string(tag));
+				else if (current->Tag != tag)
+					scene.SetTag({ tagEntities[i], &scene }, std::string(tag));
+			}
+
+			if (registry.size<TagComponent>() > count)
+			{
+				std::vector<entt::entity> tagged(tagEntities, tagEntities + count);
+				std::sort(tagged.begin(), tagged.end());
+				std::vector<entt::entity> untagged;
+				for (entt::entity entity : registry.view<TagComponent>())
+				{
+					if (!std::binary_search(tagged.begin(), tagged.end(), entity))
+						untagged.push_back(entity);
+				}
+				registry.remove<TagComponent>(untagged.begin(), untagged.end());
+			}
+		}
+
+		{
+			uint32_t count;
+			const entt::entity* cameraEntities = Utils::ReadPoolEntities(state[CameraSection], count);
+			const uint8_t* settings = (const uint8_t*)(cameraEntities + count);
+			const uint8_t* flags = settings + count * sizeof(SceneCamera::Settings);
+
+			if (registry.size<CameraComponent>() != count || !Utils::SameEntities(registry.data<CameraComponent>(), cameraEntities, count))
+			{
+				registry.clear<CameraComponent>();
+				for (uint32_t i = 0; i < count; i++)
+					Entity{ cameraEntities[i], &scene }.AddComponent<CameraComponent>(); // Picks up the viewport size
+			}
+
+			CameraComponent* cameras = registry.raw<CameraComponent>();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				SceneCamera::Settings cameraSettings;
+				std::memcpy(&cameraSettings, settings + i * sizeof(SceneCamera::Settings), sizeof(SceneCamera::Settings));
+				if (cameras[i].Camera.GetSettings() != cameraSettings)
+					cameras[i].Camera.SetSettings(cameraSettings);
+				cameras[i].Primary = flags[i * 2];
+				cameras[i].FixedAspectRatio = flags[i * 2 + 1];
+			}
+		}
+
+		// Changed local transforms are picked up by the world transform update on their own,
+		// a changed hierarchy is not
+		if (entitiesChanged || relationshipsChanged)
+		{
+			registry.view<WorldTransformComponent>().each([](auto entity, auto& worldTransform) { worldTransform.Dirty = true; });
+			scene.m_HierarchyDirty = true;
+			scene.m_HierarchyVersion++;
+		}
+	}
+
+	void SceneSnapshotRing::Decode(size_t index, State& outState) const
+	{
+		HZ_PROFILE_FUNCTION();
+
+		outState = m_Newest;
+		for (size_t i = m_Snapshots.size() - 1; i-- > index;)
+		{
+			const Snapshot& snapshot = m_Snapshots[i];
+			for (uint32_t section = 0; section < SectionCount; section++)
+				Utils::ApplyXor(snapshot.Sections[section], outState[section]);
+		}
+	}
+
+	void SceneSnapshotRing::Capture(uint64_t tick)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Re-simulating after a rollback: everything from this tick on is replaced
+		if (!m_Snapshots.empty() && tick <= m_Snapshots.back().Tick)
+		{
+			auto it = std::lower_bound(m_Snapshots.begin(), m_Snapshots.end(), tick, [](const Snapshot& snapshot, uint64_t tick) { return snapshot.Tick < tick; });
+			size_t keep = it - m_Snapshots.begin();
+			if (keep > 0)
+			{
+				// The snapshot before becomes the newest and has to be whole
+				if (m_RestoredValid && m_RestoredTick == m_Snapshots[keep - 1].Tick)
+					m_Newest.swap(m_Restored);
+				else
+					Decode(keep - 1, m_Newest);
+				m_Snapshots[keep - 1].Sections = {};
+			}
+			m_Snapshots.resize(keep);
+		}
+		m_RestoredValid = false;
+
+		WriteState(m_Scratch);
+
+		if (!m_Snapshots.empty())
+		{
+			// The newest snapshot so far is stored against this one
+			Snapshot& previous = m_Snapshots.back();
+			for (uint32_t section = 0; section < SectionCount; section++)
+			{
+				// Encoded into scratch first so the stored copy is no larger than it needs to be
+				Utils::EncodeXor(m_Newest[section], m_Scratch[section], m_Encoded);
+				previous.Sections[section].assign(m_Encoded.begin(), m_Encoded.end());
+			}
+
+			if (m_Snapshots.size() == m_Capacity)
+				m_Snapshots.pop_front();
+		}
+
+		Snapshot snapshot;
+		snapshot.Tick = tick;
+		m_Snapshots.push_back(std::move(snapshot));
+		m_Newest.swap(m_Scratch);
+	}
+
+	bool SceneSnapshotRing::Restore(uint64_t tick)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!Contains(tick))
+			return false;
+
+		auto it = std::lower_bound(m_Snapshots.begin(), m_Snapshots.end(), tick, [](const Snapshot& snapshot, uint64_t tick) { return snapshot.Tick < tick; });
+		if (it == m_Snapshots.end() || it->Tick != tick)
+			return false;
+
+		size_t index = it - m_Snapshots.begin();
+		if (index == m_Snapshots.size() - 1)
+		{
+			ReadState(m_Newest);
+			return true;
+		}
+
+		Decode(index, m_Restored);
+		m_RestoredTick = tick;
+		m_RestoredValid = true;
+		ReadState(m_Restored);
+		return true;
+	}
+
+	void SceneSnapshotRing::Clear()
+	{
+		m_Snapshots.clear();
+		for (auto& section : m_Newest)
+			section.clear();
+		m_RestoredValid = false;
+	}
+
+	size_t SceneSnapshotRing::GetMemoryUsage() const
+	{
+		size_t bytes = 0;
+		for (const Snapshot& snapshot : m_Snapshots)
+		{
+			bytes += sizeof(Snapshot);
+			for (const auto& section : snapshot.Sections)
+				bytes += section.capacity();
+		}
+		for (const auto& section : m_Newest)
+			bytes += section.capacity();
+		return bytes;
+	}
+
+}
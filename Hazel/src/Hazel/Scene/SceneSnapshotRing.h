@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Hazel/Core/Core.h"
+#include "Hazel/Scene/Scene.h"
+
+#include <deque>
+#include <vector>
+
+namespace Hazel {
+
+	// Per-tick scene state for rollback and rewind. The newest snapshot is kept whole, every older
+	// one as the XOR of itself with its successor, run-length encoded, one section per component
+	// pool. Ticks that change little cost little, dropping the oldest tick costs nothing, and
+	// restoring walks back from the newest tick touching only what changed.
+	//
+	// Captured: the entity list and the tag, transform, relationship, sprite and camera pools.
+	// World transforms are derived and recomputed by the next update; script instances are
+	// runtime objects and stay as they are.
+	class SceneSnapshotRing
+	{
+	public:
+		SceneSnapshotRing(const Ref<Scene>& scene, uint32_t capacity = 64);
+
+		// Ticks increase. Capturing a tick at or before the newest one drops the snapshots from
+		// that tick on, which is what re-simulating after a rollback does.
+		void Capture(uint64_t tick);
+		// Any tick in the window
+		bool Restore(uint64_t tick);
+		void Clear();
+
+		bool Contains(uint64_t tick) const { return !m_Snapshots.empty() && tick >= m_Snapshots.front().Tick && tick <= m_Snapshots.back().Tick; }
+		uint64_t GetOldestTick() const { return m_Snapshots.empty() ? 0 : m_Snapshots.front().Tick; }
+		uint64_t GetNewestTick() const { return m_Snapshots.empty() ? 0 : m_Snapshots.back().Tick; }
+		uint32_t GetSnapshotCount() const { return (uint32_t)m_Snapshots.size(); }
+		uint32_t GetCapacity() const { return m_Capacity; }
+		size_t GetMemoryUsage() const;
+	private:
+		enum Section : uint32_t
+		{
+			EntitiesSection = 0,
+			TagSection,
+			TransformSection,
+			RelationshipSection,
+			SpriteSection,
+			CameraSection,
+			SectionCount
+		};
+		using State = std::array<std::vector<uint8_t>, SectionCount>;
+
+		struct Snapshot
+		{
+			uint64_t Tick;
+			// Empty for the newest snapshot, which is m_Newest. Otherwise per section the encoded
+			// XOR with the next snapshot's section.
+			State Sections;
+		};
+
+		void WriteState(State& outState) const;
+		void ReadState(const State& state);
+		void Decode(size_t index, State& outState) const;
+	private:
+		Ref<Scene> m_Scene;
+		uint32_t m_Capacity;
+
+		std::deque<Snapshot> m_Snapshots;
+		State m_Newest;
+
+		// The last restored state, re-simulation usually captures right after it
+		State m_Restored;
+		uint64_t m_RestoredTick = 0;
+		bool m_RestoredValid = false;
+
+		State m_Scratch;
+		std::vector<uint8_t> m_Encoded;
+	};
+
+}
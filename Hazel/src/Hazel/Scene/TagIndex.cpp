@@ -0,0 +1,141 @@
+#include "hzpch.h"
+#include "TagIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace Hazel {
+
+	static std::string ToKey(std::string_view tag)
+	{
+		std::string key(tag);
+		for (char& c : key)
+			c = (char)std::tolower((unsigned char)c);
+		return key;
+	}
+
+	void TagIndex::Insert(entt::entity entity, std::string_view tag)
+	{
+		auto [it, inserted] = m_Keys.emplace(entity, ToKey(tag));
+		HZ_CORE_ASSERT(inserted, "Entity is already indexed!");
+
+		if (KeepSorted())
+			InsertSorted(it->second, entity);
+		m_Version++;
+	}
+
+	void TagIndex::Erase(entt::entity entity)
+	{
+		auto it = m_Keys.find(entity);
+		if (it == m_Keys.end())
+			return;
+
+		if (KeepSorted())
+			EraseSorted(it->second, entity);
+		m_Keys.erase(it);
+		m_Version++;
+	}
+
+	void TagIndex::Rename(entt::entity entity, std::string_view tag)
+	{
+		auto it = m_Keys.find(entity);
+		HZ_CORE_ASSERT(it != m_Keys.end(), "Entity is not indexed!");
+
+		std::string key = ToKey(tag);
+		if (key == it->second)
+			return;
+
+		if (KeepSorted())
+			MoveSorted(it->second, key, entity);
+		it->second = std::move(key);
+		m_Version++;
+	}
+
+	void TagIndex::Clear()
+	{
+		m_Keys.clear();
+		m_Sorted.clear();
+		m_SortedValid = false;
+		m_Version++;
+	}
+
+	void TagIndex::FindPrefix(std::string_view prefix, std::vector<entt::entity>& outEntities) const
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!m_SortedValid)
+			BuildSorted();
+
+		std::string key = ToKey(prefix);
+		auto first = std::lower_bound(m_Sorted.begin(), m_Sorted.end(), key, [](const Entry& entry, const std::string& key) { return entry.Key < key; });
+
+		outEntities.clear();
+		for (auto it = first; it != m_Sorted.end() && it->Key.compare(0, key.size(), key) == 0; ++it)
+			outEntities.push_back(it->Entity);
+	}
+
+	void TagIndex::InsertSorted(const std::string& key, entt::entity entity)
+	{
+		Entry entry{ key, entity };
+		m_Sorted.insert(std::upper_bound(m_Sorted.begin(), m_Sorted.end(), entry), std::move(entry));
+	}
+
+	void TagIndex::EraseSorted(const std::string& key, entt::entity entity)
+	{
+		Entry entry{ key, entity };
+		auto it = std::lower_bound(m_Sorted.begin(), m_Sorted.end(), entry);
+		HZ_CORE_ASSERT(it != m_Sorted.end() && it->Entity == entity, "Tag index is out of sync!");
+		m_Sorted.erase(it);
+	}
+
+	// Only the entries between the old and the new place shift
+	void TagIndex::MoveSorted(const std::string& oldKey, const std::string& newKey, entt::entity entity)
+	{
+		auto from = std::lower_bound(m_Sorted.begin(), m_Sorted.end(), Entry{ oldKey, entity });
+		HZ_CORE_ASSERT(from != m_Sorted.end() && from->Entity == entity, "Tag index is out of sync!");
+		from->Key = newKey;
+
+		Entry& moved = *from;
+		if (from + 1 != m_Sorted.end() && *(from + 1) < moved)
+		{
+			auto to = std::lower_bound(from + 1, m_Sorted.end(), moved);
+			std::rotate(from, from + 1, to);
+		}
+		else if (from != m_Sorted.begin() && moved < *(from - 1))
+		{
+			auto to = std::upper_bound(m_Sorted.begin(), from, moved);
+			std::rotate(to, from, from + 1);
+		}
+	}
+
+	// Each merge moves half the table on average, past a few of those a rebuild is cheaper
+	bool TagIndex::KeepSorted()
+	{
+		if (!m_SortedValid)
+			return false;
+
+		if (++m_ChangesSinceBuild > std::max<size_t>(64, m_Sorted.size() / 64))
+		{
+			m_Sorted.clear();
+			m_Sorted.shrink_to_fit();
+			m_SortedValid = false;
+			return false;
+		}
+		return true;
+	}
+
+	void TagIndex::BuildSorted() const
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Sorted.clear();
+		m_Sorted.reserve(m_Keys.size());
+		for (const auto& [entity, key] : m_Keys)
+			m_Sorted.push_back({ key, entity });
+		std::sort(m_Sorted.begin(), m_Sorted.end());
+
+		m_SortedValid = true;
+		m_ChangesSinceBuild = 0;
+	}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "entt.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Hazel {
+
+	// Case-insensitive index over entity tags. The sorted search table is only built once
+	// somebody searches; after that small changes are merged into it, bulk changes (loading
+	// a scene) drop it until the next search.
+	class TagIndex
+	{
+	public:
+		void Insert(entt::entity entity, std::string_view tag);
+		void Erase(entt::entity entity);
+		void Rename(entt::entity entity, std::string_view tag);
+		void Clear();
+
+		// Entities whose tag starts with the prefix, in tag order. An empty prefix matches everything.
+		void FindPrefix(std::string_view prefix, std::vector<entt::entity>& outEntities) const;
+
+		size_t GetSize() const { return m_Keys.size(); }
+
+		// Changes with every insertion, removal and rename
+		uint64_t GetVersion() const { return m_Version; }
+	private:
+		struct Entry
+		{
+			std::string Key;
+			entt::entity Entity;
+
+			bool operator<(const Entry& other) const { return Key < other.Key || (Key == other.Key && Entity < other.Entity); }
+		};
+
+		void InsertSorted(const std::string& key, entt::entity entity);
+		void EraseSorted(const std::string& key, entt::entity entity);
+		void MoveSorted(const std::string& oldKey, const std::string& newKey, entt::entity entity);
+		bool KeepSorted();
+		void BuildSorted() const;
+	private:
+		// Lowercase tags
+		std::unordered_map<entt::entity, std::string> m_Keys;
+
+		mutable std::vector<Entry> m_Sorted;
+		mutable bool m_SortedValid = false;
+		mutable uint32_t m_ChangesSinceBuild = 0;
+
+		uint64_t m_Version = 0;
+	};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <optional>
 
@@ -13,4 +14,13 @@ namespace Hazel {
 		static std::optional<std::string> SaveFile(const char* filter);
 	};
 
+	class Time
+	{
+	public:
+		// Since an arbitrary point, steady, and available without a window. Subtract two of
+		// these before narrowing to float: the difference keeps its precision, uptime doesn't.
+		static uint64_t GetTimeNanoseconds();
+		static double GetTime(); // In seconds
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Hazel/Renderer/Buffer.h"
+
+namespace Hazel {
+
+	class NullVertexBuffer : public VertexBuffer
+	{
+	public:
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void SetData(const void* data, uint32_t size) override {}
+
+		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+	private:
+		BufferLayout m_Layout;
+	};
+
+	class NullIndexBuffer : public IndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32_t count)
+			: m_Count(count)
+		{
+		}
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual uint32_t GetCount() const override { return m_Count; }
+	private:
+		uint32_t m_Count;
+	};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Hazel/Renderer/Framebuffer.h"
+
+namespace Hazel {
+
+	class NullFramebuffer : public Framebuffer
+	{
+	public:
+		NullFramebuffer(const FramebufferSpecification& spec)
+			: m_Specification(spec)
+		{
+		}
+
+		virtual void Bind() const override {}
+		virtual void Unbind() const override {}
+
+		virtual void Resize(uint32_t width, uint32_t height) override
+		{
+			m_Specification.Width = width;
+			m_Specification.Height = height;
+		}
+
+		// Nothing was drawn, so no entity under any pixel
+		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override { return -1; }
+
+		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override {}
+
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { return 0; }
+
+		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		FramebufferSpecification m_Specification;
+	};
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Hazel/Renderer/RendererAPI.h"
+
+namespace Hazel {
+
+	// RendererAPI::API::None. Records nothing and draws nothing, so everything above the
+	// graphics API (batching, culling, the scene) runs without a window or a GPU.
+	class NullRendererAPI : public RendererAPI
+	{
+	public:
+		virtual void Init() override {}
+
+		virtual void SetClearColor(const glm::vec4& color) override {}
+		virtual void Clear() override {}
+
+		virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override {}
+
+		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) override {}
+	};
+
+}
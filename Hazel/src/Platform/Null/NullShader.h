@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Hazel/Renderer/Shader.h"
+
+namespace Hazel {
+
+	// Never reads the source, a headless run doesn't need the shader files either
+	class NullShader : public Shader
+	{
+	public:
+		NullShader(const std::string& name)
+			: m_Name(name)
+		{
+		}
+
+		virtual void Bind() const override {}
+		virtual void UnBind() const override {}
+
+		virtual void SetInt(std::string_view name, int value) override {}
+		virtual void SetIntArray(std::string_view name, int* value, uint32_t count) override {}
+		virtual void SetFloat(std::string_view name, float value) override {}
+		virtual void SetFloat2(std::string_view name, const glm::vec2& value) override {}
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) override {}
+		virtual void SetFloat4(std::string_view name, const glm::vec4& value) override {}
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) override {}
+
+		virtual const std::string& GetName() const override { return m_Name; }
+
+		// Same naming as OpenGLShader, "assets/shaders/Texture.glsl" is "Texture"
+		static std::string GetNameFromFilepath(const std::string& filepath)
+		{
+			auto lastSlash = filepath.find_last_of("/\\");
+			lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+			auto lastDot = filepath.rfind('.');
+			auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+			return filepath.substr(lastSlash, count);
+		}
+	private:
+		std::string m_Name;
+	};
+
+}
@@ -0,0 +1,27 @@
+#include "hzpch.h"
+#include "NullTexture.h"
+
+#include <stb_image.h>
+
+namespace Hazel {
+
+	static std::atomic<uint32_t> s_NextRendererID = 1;
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height)
+		: m_Width(width), m_Height(height), m_RendererID(s_NextRendererID++)
+	{
+	}
+
+	NullTexture2D::NullTexture2D(const std::string& path)
+		: m_RendererID(s_NextRendererID++)
+	{
+		// Only the header, sprite sheet coordinates depend on the real size
+		int width, height, channels;
+		if (stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			m_Width = width;
+			m_Height = height;
+		}
+	}
+
+}
@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OpenGLBuffer.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -13,47 +15,52 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		RenderThread::SubmitAndWait([this, size]()
+		{
+			glCreateBuffers(1, &m_RendererID);
+			glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		});
 	}
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		RenderThread::SubmitAndWait([this, vertices, size]()
+		{
+			glCreateBuffers(1, &m_RendererID);
+			glNamedBufferData(m_RendererID, size, vertices, GL_STATIC_DRAW);
+		});
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glDeleteBuffers(1, &rendererID); });
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glBindBuffer(GL_ARRAY_BUFFER, rendererID); });
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		Renderer::Submit([]() { glBindBuffer(GL_ARRAY_BUFFER, 0); });
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		// The caller's data may be gone by the time the command runs
+		const void* copy = Renderer::CopyToCommandQueue(data, size);
+		Renderer::Submit([rendererID = m_RendererID, copy, size]() { glNamedBufferSubData(rendererID, 0, size, copy); });
 	}
 
 	// -------------------------------------------------------------
@@ -65,30 +72,33 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		RenderThread::SubmitAndWait([this, indices, count]()
+		{
+			// Named upload, binding GL_ELEMENT_ARRAY_BUFFER here would modify whatever VAO is bound
+			glCreateBuffers(1, &m_RendererID);
+			glNamedBufferData(m_RendererID, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		});
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glDeleteBuffers(1, &m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glDeleteBuffers(1, &rendererID); });
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID); });
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		Renderer::Submit([]() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); });
 	}
 
 }
\ No newline at end of file
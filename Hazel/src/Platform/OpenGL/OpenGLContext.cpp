@@ -42,4 +42,14 @@ namespace Hazel {
 		glfwSwapBuffers(m_WindowHandle);
 	}
 
-}
\ No newline at end of file
+	void OpenGLContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLContext::ReleaseCurrent()
+	{
+		glfwMakeContextCurrent(nullptr);
+	}
+
+}
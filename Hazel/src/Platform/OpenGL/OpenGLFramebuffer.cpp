@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OpenGLFramebuffer.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -105,23 +107,36 @@ namespace Hazel {
 
 	OpenGLFramebuffer::~OpenGLFramebuffer()
 	{
-		glDeleteFramebuffers(1, &m_RendererID);
-		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
-		glDeleteTextures(1, &m_DepthAttachment);
+		Release();
+	}
+
+	void OpenGLFramebuffer::Release()
+	{
+		// Commands recorded before this point may still use the old attachments
+		Renderer::Submit([rendererID = m_RendererID, colorAttachments = m_ColorAttachments, depthAttachment = m_DepthAttachment]()
+		{
+			glDeleteFramebuffers(1, &rendererID);
+			glDeleteTextures(colorAttachments.size(), colorAttachments.data());
+			glDeleteTextures(1, &depthAttachment);
+		});
 	}
 
 	void OpenGLFramebuffer::Invalidate()
 	{
 		if (m_RendererID)
 		{
-			glDeleteFramebuffers(1, &m_RendererID);
-			glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
-			glDeleteTextures(1, &m_DepthAttachment);
+			Release();
 
+			m_RendererID = 0;
 			m_ColorAttachments.clear();
 			m_DepthAttachment = 0;
 		}
 
+		RenderThread::SubmitAndWait([this]() { Create(); });
+	}
+
+	void OpenGLFramebuffer::Create()
+	{
 		glCreateFramebuffers(1, &m_RendererID);
 		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
 
@@ -179,13 +194,16 @@ namespace Hazel {
 
 	void OpenGLFramebuffer::Bind() const
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+		Renderer::Submit([rendererID = m_RendererID, width = m_Specification.Width, height = m_Specification.Height]()
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, rendererID);
+			glViewport(0, 0, width, height);
+		});
 	}
 
 	void OpenGLFramebuffer::Unbind() const
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		Renderer::Submit([]() { glBindFramebuffer(GL_FRAMEBUFFER, 0); });
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -203,9 +221,16 @@ namespace Hazel {
 	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
 	{
 		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
-		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+
+		// Reads back the last frame the render thread finished, commands recorded this frame haven't run yet
 		int pixelData;
-		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+		RenderThread::SubmitAndWait([&]()
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+			glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+			glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		});
 		return pixelData;
 	}
 
@@ -215,8 +240,10 @@ namespace Hazel {
 
 		auto& spec = m_ColorAttachmentsSpecifications[attachmentIndex];
 
-
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0, Utils::HazelTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
+		Renderer::Submit([attachment = m_ColorAttachments[attachmentIndex], format = Utils::HazelTextureFormatToGL(spec.TextureFormat), value]()
+		{
+			glClearTexImage(attachment, 0, format, GL_INT, &value);
+		});
 	}
 
 }
\ No newline at end of file
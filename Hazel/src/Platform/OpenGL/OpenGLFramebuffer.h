@@ -23,6 +23,9 @@ namespace Hazel {
 		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { HZ_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
 
 		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		void Create();
+		void Release();
 	private:
 		uint32_t m_RendererID = 0;
 		FramebufferSpecification m_Specification;
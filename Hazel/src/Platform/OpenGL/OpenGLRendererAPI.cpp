@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OpenGLRendererAPI.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -9,32 +11,35 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		Renderer::Submit([]()
+		{
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		// temp
-		glEnable(GL_DEPTH_TEST);
+			// temp
+			glEnable(GL_DEPTH_TEST);
+		});
 	}
 
 	void OpenGLRendererAPI::SetClearColor(const glm::vec4& color)
 	{
-		glClearColor(color.r, color.g, color.b, color.a);
+		Renderer::Submit([color]() { glClearColor(color.r, color.g, color.b, color.a); });
 	}
 
 	void OpenGLRendererAPI::Clear()
 	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		Renderer::Submit([]() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); });
 	}
 
 	void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 	{
-		glViewport(x, y, width, height);
+		Renderer::Submit([x, y, width, height]() { glViewport(x, y, width, height); });
 	}
 
 	void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
 	{
 		uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+		Renderer::Submit([count]() { glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr); });
 	}
 
 }
\ No newline at end of file
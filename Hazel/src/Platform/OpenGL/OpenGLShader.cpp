@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "OpenGLShader.h"
 
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Renderer/Renderer.h"
+
 #include <fstream>
 
 #include <glad/glad.h>
@@ -21,10 +24,11 @@ namespace Hazel {
 	OpenGLShader::OpenGLShader(const std::string& filepath)
 	{
 		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Shaders");
 
 		std::string source = ReadFile(filepath);
 		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
+		RenderThread::SubmitAndWait([&]() { Compile(shaderSources); });
 
 		// Extract name from filepath
 		auto lastSlash = filepath.find_last_of("/\\");
@@ -38,28 +42,30 @@ namespace Hazel {
 		: m_Name(name)
 	{
 		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Shaders");
 
 		std::string source = ReadFile(filepath);
 		auto shaderSources = PreProcess(source);
-		Compile(shaderSources);
+		RenderThread::SubmitAndWait([&]() { Compile(shaderSources); });
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSource, const std::string& fragmentSource)
 		: m_Name(name)
 	{
 		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Shaders");
 
 		std::unordered_map<GLenum, std::string> sources;
 		sources[GL_VERTEX_SHADER] = vertexSource;
 		sources[GL_FRAGMENT_SHADER] = fragmentSource;
-		Compile(sources);
+		RenderThread::SubmitAndWait([&]() { Compile(sources); });
 	}
 
 	OpenGLShader::~OpenGLShader()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glDeleteProgram(m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glDeleteProgram(rendererID); });
 	}
 
 	std::string OpenGLShader::ReadFile(const std::string& filepath)
@@ -199,114 +205,139 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glUseProgram(m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glUseProgram(rendererID); });
 	}
 
 	void OpenGLShader::UnBind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glUseProgram(0);
+		Renderer::Submit([]() { glUseProgram(0); });
 	}
 
-	void OpenGLShader::SetInt(const std::string& name, int value)
+	void OpenGLShader::SetInt(std::string_view name, int value)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformInt(name, value);
 	}
 
-	void OpenGLShader::SetIntArray(const std::string& name, int* value, uint32_t count)
+	void OpenGLShader::SetIntArray(std::string_view name, int* value, uint32_t count)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformIntArray(name, value, count);
 	}
 
-	void OpenGLShader::SetFloat(const std::string& name, float value)
+	void OpenGLShader::SetFloat(std::string_view name, float value)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformFloat(name, value);
 	}
 
-	void OpenGLShader::SetFloat2(const std::string& name, const glm::vec2& value)
+	void OpenGLShader::SetFloat2(std::string_view name, const glm::vec2& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformFloat2(name, value);
 	}
 
-	void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
+	void OpenGLShader::SetFloat3(std::string_view name, const glm::vec3& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformFloat3(name, value);
 	}
 
-	void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value)
+	void OpenGLShader::SetFloat4(std::string_view name, const glm::vec4& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformFloat4(name, value);
 	}
 
-	void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
+	void OpenGLShader::SetMat4(std::string_view name, const glm::mat4& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		UploadUniformMat4(name, value);
 	}
 
-	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
+	void OpenGLShader::UploadUniformInt(std::string_view name, int value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1i(location, value);
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), value]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniform1i(location, value);
+		});
 	}
 
-	void OpenGLShader::UploadUniformIntArray(const std::string& name, int* value, uint32_t count)
+	void OpenGLShader::UploadUniformIntArray(std::string_view name, int* value, uint32_t count)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1iv(location, count, value);
+		const int* values = (const int*)Renderer::CopyToCommandQueue(value, count * sizeof(int));
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), values, count]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniform1iv(location, count, values);
+		});
 	}
 
-	void OpenGLShader::UploadUniformFloat(const std::string& name, float value)
+	void OpenGLShader::UploadUniformFloat(std::string_view name, float value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform1f(location, value);
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), value]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniform1f(location, value);
+		});
 	}
 
-	void OpenGLShader::UploadUniformFloat2(const std::string& name, const glm::vec2& value)
+	void OpenGLShader::UploadUniformFloat2(std::string_view name, const glm::vec2& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform2fv(location, 1, glm::value_ptr(value));
-		//glUniform2f(location, value.x, value.y);
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), value]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniform2fv(location, 1, glm::value_ptr(value));
+			//glUniform2f(location, value.x, value.y);
+		});
 	}
 
-	void OpenGLShader::UploadUniformFloat3(const std::string& name, const glm::vec3& value)
+	void OpenGLShader::UploadUniformFloat3(std::string_view name, const glm::vec3& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform3fv(location, 1, glm::value_ptr(value));
-		//glUniform3f(location, value.x, value.y, value.z);
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), value]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniform3fv(location, 1, glm::value_ptr(value));
+			//glUniform3f(location, value.x, value.y, value.z);
+		});
 	}
 
-	void OpenGLShader::UploadUniformFloat4(const std::string& name, const glm::vec4& value)
+	void OpenGLShader::UploadUniformFloat4(std::string_view name, const glm::vec4& value)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniform4fv(location, 1, glm::value_ptr(value));
-		//glUniform4f(location, value.x, value.y, value.z, value.w);
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), value]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniform4fv(location, 1, glm::value_ptr(value));
+			//glUniform4f(location, value.x, value.y, value.z, value.w);
+		});
 	}
 
-	void OpenGLShader::UploadUniformMat3(const std::string& name, const glm::mat3& matrix)
+	void OpenGLShader::UploadUniformMat3(std::string_view name, const glm::mat3& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), matrix]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		});
 	}
 
-	void OpenGLShader::UploadUniformMat4(const std::string& name, const glm::mat4& matrix)
+	void OpenGLShader::UploadUniformMat4(std::string_view name, const glm::mat4& matrix)
 	{
-		GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		Renderer::Submit([rendererID = m_RendererID, name = FrameAllocator::CopyString(name), matrix]()
+		{
+			GLint location = glGetUniformLocation(rendererID, name);
+			glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+		});
 	}
 
 }
\ No newline at end of file
@@ -20,26 +20,26 @@ namespace Hazel {
 		virtual void Bind() const override;
 		virtual void UnBind() const override;
 
-		virtual void SetInt(const std::string& name, int value) override;
-		virtual void SetIntArray(const std::string& name, int* value, uint32_t count) override;
-		virtual void SetFloat(const std::string& name, float value) override;
-		virtual void SetFloat2(const std::string& name, const glm::vec2& value) override;
-		virtual void SetFloat3(const std::string& name, const glm::vec3& value) override;
-		virtual void SetFloat4(const std::string& name, const glm::vec4& value) override;
-		virtual void SetMat4(const std::string& name, const glm::mat4& value) override;
+		virtual void SetInt(std::string_view name, int value) override;
+		virtual void SetIntArray(std::string_view name, int* value, uint32_t count) override;
+		virtual void SetFloat(std::string_view name, float value) override;
+		virtual void SetFloat2(std::string_view name, const glm::vec2& value) override;
+		virtual void SetFloat3(std::string_view name, const glm::vec3& value) override;
+		virtual void SetFloat4(std::string_view name, const glm::vec4& value) override;
+		virtual void SetMat4(std::string_view name, const glm::mat4& value) override;
 
 		virtual const std::string& GetName() const override { return m_Name; }
 
-		void UploadUniformInt(const std::string& name, int value);
-		void UploadUniformIntArray(const std::string& name, int* value, uint32_t count);
+		void UploadUniformInt(std::string_view name, int value);
+		void UploadUniformIntArray(std::string_view name, int* value, uint32_t count);
 
-		void UploadUniformFloat(const std::string& name, float value);
-		void UploadUniformFloat2(const std::string& name, const glm::vec2& value);
-		void UploadUniformFloat3(const std::string& name, const glm::vec3& value);
-		void UploadUniformFloat4(const std::string& name, const glm::vec4& value);
+		void UploadUniformFloat(std::string_view name, float value);
+		void UploadUniformFloat2(std::string_view name, const glm::vec2& value);
+		void UploadUniformFloat3(std::string_view name, const glm::vec3& value);
+		void UploadUniformFloat4(std::string_view name, const glm::vec4& value);
 
-		void UploadUniformMat3(const std::string& name, const glm::mat3& matrix);
-		void UploadUniformMat4(const std::string& name, const glm::mat4& matrix);
+		void UploadUniformMat3(std::string_view name, const glm::mat3& matrix);
+		void UploadUniformMat4(std::string_view name, const glm::mat4& matrix);
 	private:
 		std::string ReadFile(const std::string& filepath);
 		std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OpenGLTexture.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <stb_image.h>
 
 namespace Hazel {
@@ -9,24 +11,29 @@ namespace Hazel {
 		: m_Width(width), m_Height(height)
 	{
 		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Textures");
 
 		m_InternalFormat = GL_RGBA8;
 		m_DataFormat = GL_RGBA;
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+		RenderThread::SubmitAndWait([this]()
+		{
+			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+			glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		});
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
 		: m_Path(path)
 	{
 		HZ_PROFILE_FUNCTION();
+		HZ_MEMORY_SCOPE("Textures");
 
 		int width, height, channels;
 		stbi_set_flip_vertically_on_load(1);
@@ -56,16 +63,19 @@ namespace Hazel {
 
 		HZ_CORE_ASSERT(internalFormat, "Format not supported!");
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+		RenderThread::SubmitAndWait([this, data]()
+		{
+			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+			glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+			glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+		});
 
 		stbi_image_free(data);
 	}
@@ -74,7 +84,7 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glDeleteTextures(1, &m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glDeleteTextures(1, &rendererID); });
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
@@ -83,14 +93,19 @@ namespace Hazel {
 
 		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
 		HZ_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+
+		const void* copy = Renderer::CopyToCommandQueue(data, size);
+		Renderer::Submit([rendererID = m_RendererID, width = m_Width, height = m_Height, dataFormat = m_DataFormat, copy]()
+		{
+			glTextureSubImage2D(rendererID, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, copy);
+		});
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindTextureUnit(slot, m_RendererID);
+		Renderer::Submit([slot, rendererID = m_RendererID]() { glBindTextureUnit(slot, rendererID); });
 	}
 
 }
\ No newline at end of file
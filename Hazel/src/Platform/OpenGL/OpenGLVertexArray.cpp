@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "OpenGLVertexArray.h"
 
+#include "Hazel/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -30,28 +32,28 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateVertexArrays(1, &m_RendererID);
+		RenderThread::SubmitAndWait([this]() { glCreateVertexArrays(1, &m_RendererID); });
 	}
 
 	OpenGLVertexArray::~OpenGLVertexArray()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glDeleteVertexArrays(1, &m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glDeleteVertexArrays(1, &rendererID); });
 	}
 
 	void OpenGLVertexArray::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		Renderer::Submit([rendererID = m_RendererID]() { glBindVertexArray(rendererID); });
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindVertexArray(0);
+		Renderer::Submit([]() { glBindVertexArray(0); });
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
@@ -60,66 +62,77 @@ namespace Hazel {
 
 		HZ_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
 
-		glBindVertexArray(m_RendererID);
+		// Binds go through the command queue as well, so they land before the attribute setup
+		Bind();
 		vertexBuffer->Bind();
 
 		const auto& layout = vertexBuffer->GetLayout();
+		uint32_t firstAttribute = m_VertexBufferIndex;
 		for (const auto& element : layout)
 		{
-			switch (element.Type)
-			{
-			case ShaderDataType::Float:
-			case ShaderDataType::Float2:
-			case ShaderDataType::Float3:
-			case ShaderDataType::Float4:
-			{
-				glEnableVertexAttribArray(m_VertexBufferIndex);
-				glVertexAttribPointer(m_VertexBufferIndex,
-					element.GetComponentCount(),
-					ShaderDataTypeToOpenGLBaseType(element.Type),
-					element.Normalized ? GL_TRUE : GL_FALSE,
-					layout.GetStride(),
-					(const void*)element.Offset);
-				m_VertexBufferIndex++;
-				break;
-			}
-			case ShaderDataType::Int:
-			case ShaderDataType::Int2:
-			case ShaderDataType::Int3:
-			case ShaderDataType::Int4:
-			case ShaderDataType::Bool:
-			{
-				glEnableVertexAttribArray(m_VertexBufferIndex);
-				glVertexAttribIPointer(m_VertexBufferIndex,
-					element.GetComponentCount(),
-					ShaderDataTypeToOpenGLBaseType(element.Type),
-					layout.GetStride(),
-					(const void*)element.Offset);
-				m_VertexBufferIndex++;
-				break;
-			}
-			case ShaderDataType::Mat3:
-			case ShaderDataType::Mat4:
+			bool isMatrix = element.Type == ShaderDataType::Mat3 || element.Type == ShaderDataType::Mat4;
+			m_VertexBufferIndex += isMatrix ? element.GetComponentCount() : 1;
+		}
+
+		Renderer::Submit([layout, attributeIndex = firstAttribute]() mutable
+		{
+			for (const auto& element : layout)
 			{
-				uint8_t count = element.GetComponentCount();
-				for (uint8_t i = 0; i < count; i++)
+				switch (element.Type)
+				{
+				case ShaderDataType::Float:
+				case ShaderDataType::Float2:
+				case ShaderDataType::Float3:
+				case ShaderDataType::Float4:
 				{
-					glEnableVertexAttribArray(m_VertexBufferIndex);
-					glVertexAttribPointer(m_VertexBufferIndex,
-						count,
+					glEnableVertexAttribArray(attributeIndex);
+					glVertexAttribPointer(attributeIndex,
+						element.GetComponentCount(),
 						ShaderDataTypeToOpenGLBaseType(element.Type),
 						element.Normalized ? GL_TRUE : GL_FALSE,
 						layout.GetStride(),
-						(const void*)(element.Offset + sizeof(float) * count * i));
-					glVertexAttribDivisor(m_VertexBufferIndex, 1);
-					m_VertexBufferIndex++;
+						(const void*)element.Offset);
+					attributeIndex++;
+					break;
+				}
+				case ShaderDataType::Int:
+				case ShaderDataType::Int2:
+				case ShaderDataType::Int3:
+				case ShaderDataType::Int4:
+				case ShaderDataType::Bool:
+				{
+					glEnableVertexAttribArray(attributeIndex);
+					glVertexAttribIPointer(attributeIndex,
+						element.GetComponentCount(),
+						ShaderDataTypeToOpenGLBaseType(element.Type),
+						layout.GetStride(),
+						(const void*)element.Offset);
+					attributeIndex++;
+					break;
+				}
+				case ShaderDataType::Mat3:
+				case ShaderDataType::Mat4:
+				{
+					uint8_t count = element.GetComponentCount();
+					for (uint8_t i = 0; i < count; i++)
+					{
+						glEnableVertexAttribArray(attributeIndex);
+						glVertexAttribPointer(attributeIndex,
+							count,
+							ShaderDataTypeToOpenGLBaseType(element.Type),
+							element.Normalized ? GL_TRUE : GL_FALSE,
+							layout.GetStride(),
+							(const void*)(element.Offset + sizeof(float) * count * i));
+						glVertexAttribDivisor(attributeIndex, 1);
+						attributeIndex++;
+					}
+					break;
+				}
+				default:
+					HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 				}
-				break;
-			}
-			default:
-				HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			}
-		}
+		});
 
 		m_VertexBuffers.push_back(vertexBuffer);
 	}
@@ -128,7 +141,7 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		Bind();
 		indexBuffer->Bind();
 
 		m_IndexBuffer = indexBuffer;
@@ -1,43 +0,0 @@
-#include "hzpch.h"
-
-#include "Hazel/Core/Input.h"
-#include "Hazel/Core/Application.h"
-#include <GLFW/glfw3.h>
-
-namespace Hazel {
-
-	bool Input::IsKeyPressed(KeyCode key)
-	{
-		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		auto state = glfwGetKey(window, static_cast<int32_t>(key));
-		return state == GLFW_PRESS || state == GLFW_REPEAT;
-	}
-
-	bool Input::IsMouseButtonPressed(MouseCode button)
-	{
-		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		auto state = glfwGetMouseButton(window, static_cast<int32_t>(button));
-		return state == GLFW_PRESS;
-	}
-
-	std::pair<float, float> Input::GetMousePosition()
-	{
-		auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-		double xPos, yPos;
-		glfwGetCursorPos(window, &xPos, &yPos);
-		return { (float)xPos, (float)yPos };
-	}
-
-	float Input::GetMouseX()
-	{
-		auto [x, y] = GetMousePosition();
-		return x;
-	}
-
-	float Input::GetMouseY()
-	{
-		auto [x, y] = GetMousePosition();
-		return y;
-	}
-
-}
\ No newline at end of file
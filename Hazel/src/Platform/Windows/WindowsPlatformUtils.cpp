@@ -58,4 +58,34 @@ namespace Hazel {
 		return std::nullopt;
 	}
 
+	uint64_t Time::GetTimeNanoseconds()
+	{
+		// The performance counter runs without GLFW being initialized, which a headless run never does
+		static LARGE_INTEGER frequency = []()
+		{
+			LARGE_INTEGER value;
+			QueryPerformanceFrequency(&value);
+			return value;
+		}();
+		static LARGE_INTEGER start = []()
+		{
+			LARGE_INTEGER value;
+			QueryPerformanceCounter(&value);
+			return value;
+		}();
+
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+
+		// Whole seconds and the rest apart, ticks * 10^9 overflows after half an hour on a 10 MHz counter
+		uint64_t ticks = (uint64_t)(now.QuadPart - start.QuadPart);
+		uint64_t ticksPerSecond = (uint64_t)frequency.QuadPart;
+		return ticks / ticksPerSecond * 1000000000ull + ticks % ticksPerSecond * 1000000000ull / ticksPerSecond;
+	}
+
+	double Time::GetTime()
+	{
+		return (double)GetTimeNanoseconds() * 1e-9;
+	}
+
 }
\ No newline at end of file
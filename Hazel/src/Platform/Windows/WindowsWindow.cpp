@@ -2,11 +2,12 @@
 #include "WindowsWindow.h"
 
 #include "Hazel/Events/ApplicationEvent.h"
+#include "Hazel/Events/EventQueue.h"
 #include "Hazel/Events/MouseEvent.h"
 #include "Hazel/Events/KeyEvent.h"
 
 #include "Platform/OpenGL/OpenGLContext.h"
-#include "Hazel/Renderer/RenderCommand.h"
+#include "Hazel/Renderer/Renderer.h"
 
 namespace Hazel {
 
@@ -75,15 +76,13 @@ namespace Hazel {
 			data.Width = width;
 			data.Height = height;
 
-			WindowResizeEvent event(width, height);
-			data.EventCallback(event);
+			data.Queue->Push<WindowResizeEvent>(width, height);
 		});
 
 		glfwSetWindowCloseCallback(m_Window, [](GLFWwindow * window)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
-			WindowCloseEvent event;
-			data.EventCallback(event);
+			data.Queue->Push<WindowCloseEvent>();
 		});
 
 		glfwSetKeyCallback(m_Window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
@@ -94,20 +93,17 @@ namespace Hazel {
 			{
 				case GLFW_PRESS:
 				{
-					KeyPressedEvent event(key, 0);
-					data.EventCallback(event);
+					data.Queue->Push<KeyPressedEvent>(key, 0);
 					break;
 				}
 				case GLFW_RELEASE:
 				{
-					KeyReleasedEvent event(key);
-					data.EventCallback(event);
+					data.Queue->Push<KeyReleasedEvent>(key);
 					break;
 				}
 				case GLFW_REPEAT:
 				{
-					KeyPressedEvent event(key, 1);
-					data.EventCallback(event);
+					data.Queue->Push<KeyPressedEvent>(key, 1);
 					break;
 				}
 			}
@@ -116,8 +112,7 @@ namespace Hazel {
 		glfwSetCharCallback(m_Window, [](GLFWwindow * window, unsigned int keycode)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
-			KeyTypedEvent event(keycode);
-			data.EventCallback(event);
+			data.Queue->Push<KeyTypedEvent>(keycode);
 		});
 
 		glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* window, int button, int action, int mods)
@@ -128,14 +123,12 @@ namespace Hazel {
 			{
 				case GLFW_PRESS:
 				{
-					MouseButtonPressedEvent event(button);
-					data.EventCallback(event);
+					data.Queue->Push<MouseButtonPressedEvent>(button);
 					break;
 				}
 				case GLFW_RELEASE:
 				{
-					MouseButtonReleasedEvent event(button);
-					data.EventCallback(event);
+					data.Queue->Push<MouseButtonReleasedEvent>(button);
 					break;
 				}
 			}
@@ -145,16 +138,14 @@ namespace Hazel {
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			MouseScrolledEvent event((float)xOffset, (float)yOffset);
-			data.EventCallback(event);
+			data.Queue->Push<MouseScrolledEvent>((float)xOffset, (float)yOffset);
 		});
 
 		glfwSetCursorPosCallback(m_Window, [](GLFWwindow * window, double xPos, double yPos)
 		{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
 
-			MouseMovedEvent event((float)xPos, (float)yPos);
-			data.EventCallback(event);
+			data.Queue->Push<MouseMovedEvent>((float)xPos, (float)yPos);
 		});
 	}
 
@@ -177,17 +168,33 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		glfwPollEvents();
-		m_Context->SwapBuffers();
+
+		// Presents once everything recorded this frame has executed
+		Renderer::Submit([context = m_Context.get()]() { context->SwapBuffers(); });
+	}
+
+	void WindowsWindow::SetEventQueue(EventQueue* queue)
+	{
+		m_Data.Queue = queue;
+
+		// GLFW only reports the cursor once it moves, Input should know where it starts
+		double xPos, yPos;
+		glfwGetCursorPos(m_Window, &xPos, &yPos);
+		m_Data.Queue->Push<MouseMovedEvent>((float)xPos, (float)yPos);
 	}
 
 	void WindowsWindow::SetVSync(bool enabled)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		if (enabled)
-			glfwSwapInterval(1);
-		else
-			glfwSwapInterval(0);
+		// Needs the context current, which may belong to the render thread
+		RenderThread::SubmitAndWait([enabled]()
+		{
+			if (enabled)
+				glfwSwapInterval(1);
+			else
+				glfwSwapInterval(0);
+		});
 
 		m_Data.VSync = enabled;
 	}
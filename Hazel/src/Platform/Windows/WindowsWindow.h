@@ -19,11 +19,12 @@ namespace Hazel {
 		inline unsigned int GetHeight() const override { return m_Data.Height; }
 
 		// Window attributes
-		inline void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
+		void SetEventQueue(EventQueue* queue) override;
 		void SetVSync(bool enabled) override;
 		bool IsVSync() const override;
 
 		inline virtual void* GetNativeWindow() const override { return m_Window; }
+		inline virtual GraphicsContext* GetGraphicsContext() const override { return m_Context.get(); }
 	private:
 		virtual void Init(const WindowProps& props);
 		virtual void Shutdown();
@@ -37,7 +38,7 @@ namespace Hazel {
 			unsigned int Width = 1280, Height = 720;
 			bool VSync = true;
 
-			EventCallbackFn EventCallback;
+			EventQueue* Queue = nullptr;
 		};
 
 		WindowData m_Data;
@@ -16,6 +16,7 @@
 #include "Hazel/Core/Log.h"
 
 #include "Hazel/Debug/Instrumentor.h"
+#include "Hazel/Debug/MemoryTracker.h"
 
 #ifdef HZ_PLATFORM_WINDOWS
 	#include <Windows.h>
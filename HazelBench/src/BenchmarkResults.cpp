@@ -0,0 +1,91 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace HazelBench {
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+		uint64_t ItemCount;
+		uint32_t Repetitions;
+		// ns per item
+		double Min, Median, Mean, P95, Max, StandardDeviation;
+	};
+
+	static std::vector<BenchmarkResult> s_Results;
+
+	BenchmarkSettings& GetBenchmarkSettings()
+	{
+		static BenchmarkSettings settings;
+		return settings;
+	}
+
+	void ReportBenchmark(const std::string& name, uint64_t itemCount, std::vector<double> repetitionNanoseconds)
+	{
+		if (repetitionNanoseconds.empty())
+			return;
+
+		for (double& nanoseconds : repetitionNanoseconds)
+			nanoseconds /= std::max<uint64_t>(itemCount, 1);
+		std::sort(repetitionNanoseconds.begin(), repetitionNanoseconds.end());
+
+		size_t count = repetitionNanoseconds.size();
+		auto percentile = [&](double p) { return repetitionNanoseconds[std::max<size_t>((size_t)std::ceil(p / 100.0 * count), 1) - 1]; };
+
+		BenchmarkResult result;
+		result.Name = name;
+		result.ItemCount = itemCount;
+		result.Repetitions = (uint32_t)count;
+		result.Min = repetitionNanoseconds.front();
+		result.Max = repetitionNanoseconds.back();
+		result.Median = count % 2 ? repetitionNanoseconds[count / 2] : (repetitionNanoseconds[count / 2 - 1] + repetitionNanoseconds[count / 2]) * 0.5;
+		result.P95 = percentile(95.0);
+
+		double sum = 0.0;
+		for (double nanoseconds : repetitionNanoseconds)
+			sum += nanoseconds;
+		result.Mean = sum / count;
+
+		double variance = 0.0;
+		for (double nanoseconds : repetitionNanoseconds)
+			variance += (nanoseconds - result.Mean) * (nanoseconds - result.Mean);
+		result.StandardDeviation = std::sqrt(variance / count);
+
+		HZ_INFO("  {0:<44} median {1:10.1f} ns/item  min {2:10.1f}  p95 {3:10.1f}  stddev {4:5.1f}%", name,
+			result.Median, result.Min, result.P95, result.Mean > 0.0 ? result.StandardDeviation / result.Mean * 100.0 : 0.0);
+
+		s_Results.push_back(result);
+	}
+
+	bool WriteBenchmarkResults(const std::string& filepath)
+	{
+		std::ofstream stream(filepath);
+		if (!stream.is_open())
+		{
+			HZ_ERROR("Could not open '{0}'", filepath);
+			return false;
+		}
+
+		const BenchmarkSettings& settings = GetBenchmarkSettings();
+		stream << std::setprecision(10);
+		stream << "{\"warmup_repetitions\":" << settings.WarmupRepetitions << ",\"repetitions\":" << settings.Repetitions << ",\"unit\":\"ns/item\",\"benchmarks\":[";
+		for (size_t i = 0; i < s_Results.size(); i++)
+		{
+			const BenchmarkResult& result = s_Results[i];
+			stream << (i ? "," : "") << "{\"name\":\"" << result.Name << "\",\"items\":" << result.ItemCount;
+			stream << ",\"min\":" << result.Min << ",\"median\":" << result.Median << ",\"mean\":" << result.Mean;
+			stream << ",\"p95\":" << result.P95 << ",\"max\":" << result.Max << ",\"stddev\":" << result.StandardDeviation << '}';
+		}
+		stream << "]}\n";
+
+		HZ_INFO("Wrote {0} results to '{1}'", s_Results.size(), filepath);
+		return true;
+	}
+
+}
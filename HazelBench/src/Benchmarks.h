@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HazelBench {
+
+	class BenchTimer
+	{
+	public:
+		BenchTimer()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			m_Start = std::chrono::steady_clock::now();
+		}
+
+		double ElapsedMilliseconds() const
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+
+		double ElapsedNanoseconds() const
+		{
+			return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+	private:
+		std::chrono::time_point<std::chrono::steady_clock> m_Start;
+	};
+
+	struct BenchmarkSettings
+	{
+		uint32_t WarmupRepetitions = 3;
+		uint32_t Repetitions = 20;
+	};
+
+	BenchmarkSettings& GetBenchmarkSettings();
+
+	// Reports the per-repetition times of a benchmark doing itemCount units of work per
+	// repetition: logs ns/item statistics and keeps them for WriteBenchmarkResults
+	void ReportBenchmark(const std::string& name, uint64_t itemCount, std::vector<double> repetitionNanoseconds);
+	bool WriteBenchmarkResults(const std::string& filepath);
+
+	// Warm-up runs, then the timed repetitions. func does itemCount units of work per call;
+	// setup is func's own business, keep it outside or it gets timed too.
+	template<typename F>
+	void RunBenchmark(const std::string& name, uint64_t itemCount, const F& func)
+	{
+		const BenchmarkSettings& settings = GetBenchmarkSettings();
+		for (uint32_t i = 0; i < settings.WarmupRepetitions; i++)
+			func();
+
+		std::vector<double> repetitionNanoseconds(settings.Repetitions);
+		for (double& nanoseconds : repetitionNanoseconds)
+		{
+			BenchTimer timer;
+			func();
+			nanoseconds = timer.ElapsedNanoseconds();
+		}
+
+		ReportBenchmark(name, itemCount, std::move(repetitionNanoseconds));
+	}
+
+	// Suites with their own output, comparing variants side by side
+	void RunJobSystemBenchmarks();
+	void RunFrameAllocatorBenchmarks();
+	void RunRenderer2DBenchmarks();
+	void RunInstrumentorBenchmarks();
+
+	// Suites on the statistics harness, their results go into the JSON report
+	void RunSceneBenchmarks();
+	void RunSerializerBenchmarks();
+	void RunMathBenchmarks();
+	void RunEventBenchmarks();
+	void RunInputBenchmarks();
+
+}
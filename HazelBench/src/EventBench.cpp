@@ -0,0 +1,171 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include "Hazel/Core/LayerStack.h"
+#include "Hazel/Events/EventQueue.h"
+#include "Hazel/Events/KeyEvent.h"
+#include "Hazel/Events/MouseEvent.h"
+
+namespace HazelBench {
+
+	// Handles keys and scrolling like a typical editor or camera layer, ignores mouse moves
+	class BenchLayer : public Hazel::Layer
+	{
+	public:
+		BenchLayer()
+			: Layer("BenchLayer")
+		{
+		}
+
+		virtual void OnEvent(Hazel::Event& e) override
+		{
+			Hazel::EventDispatcher dispatcher(e);
+			dispatcher.Dispatch<Hazel::KeyPressedEvent>([this](Hazel::KeyPressedEvent& event) { KeyCount++; return false; });
+			dispatcher.Dispatch<Hazel::MouseScrolledEvent>([this](Hazel::MouseScrolledEvent& event) { ScrollCount++; return false; });
+		}
+
+		uint32_t KeyCount = 0;
+		uint32_t ScrollCount = 0;
+	};
+
+	// The same as a layer that subscribes, mouse moves never reach it
+	class SubscribedBenchLayer : public Hazel::Layer
+	{
+	public:
+		SubscribedBenchLayer()
+			: Layer("SubscribedBenchLayer")
+		{
+			Subscribe<Hazel::KeyPressedEvent>([this](Hazel::KeyPressedEvent& event) { KeyCount++; return false; });
+			Subscribe<Hazel::MouseScrolledEvent>([this](Hazel::MouseScrolledEvent& event) { ScrollCount++; return false; });
+		}
+
+		uint32_t KeyCount = 0;
+		uint32_t ScrollCount = 0;
+	};
+
+	// The layer loop Application::OnEvent used before the layer stack dispatched: top to
+	// bottom until handled, every layer gets every event
+	static void DispatchToLayers(Hazel::LayerStack& layerStack, Hazel::Event& e)
+	{
+		for (auto it = layerStack.end(); it != layerStack.begin(); )
+		{
+			if (e.Handled)
+				break;
+			(*--it)->OnEvent(e);
+		}
+	}
+
+	void RunEventBenchmarks()
+	{
+		const uint32_t eventCount = 100000;
+
+		HZ_INFO("Event dispatch");
+		for (uint32_t layerCount : { 1, 10 })
+		{
+			// Owns and deletes the layers
+			Hazel::LayerStack layerStack;
+			for (uint32_t i = 0; i < layerCount; i++)
+				layerStack.PushLayer(new BenchLayer());
+
+			RunBenchmark("MouseMovedEvent, " + std::to_string(layerCount) + " layers", eventCount, [&]()
+			{
+				for (uint32_t i = 0; i < eventCount; i++)
+				{
+					Hazel::MouseMovedEvent event((float)i, (float)i);
+					DispatchToLayers(layerStack, event);
+				}
+			});
+
+			RunBenchmark("KeyPressedEvent, " + std::to_string(layerCount) + " layers", eventCount, [&]()
+			{
+				for (uint32_t i = 0; i < eventCount; i++)
+				{
+					Hazel::KeyPressedEvent event(Hazel::Key::W, 0);
+					DispatchToLayers(layerStack, event);
+				}
+			});
+		}
+
+		// The layer stack's per-type tables: a mouse move no layer subscribed to costs a
+		// lookup, a key press only calls the handlers for it
+		HZ_INFO("Event dispatch, subscribed layers");
+		for (uint32_t layerCount : { 1, 10 })
+		{
+			Hazel::LayerStack layerStack;
+			for (uint32_t i = 0; i < layerCount; i++)
+				layerStack.PushLayer(new SubscribedBenchLayer());
+
+			RunBenchmark("MouseMovedEvent, " + std::to_string(layerCount) + " layers", eventCount, [&]()
+			{
+				for (uint32_t i = 0; i < eventCount; i++)
+				{
+					Hazel::MouseMovedEvent event((float)i, (float)i);
+					layerStack.Dispatch(event);
+				}
+			});
+
+			RunBenchmark("KeyPressedEvent, " + std::to_string(layerCount) + " layers", eventCount, [&]()
+			{
+				for (uint32_t i = 0; i < eventCount; i++)
+				{
+					Hazel::KeyPressedEvent event(Hazel::Key::W, 0);
+					layerStack.Dispatch(event);
+				}
+			});
+		}
+
+		// A high-rate mouse: 8000 reports a second at 125 frames a second is 64 moves a frame,
+		// with a scroll and a key press now and then. Immediately dispatched, every report walks
+		// the layers; queued, the frame's moves between other events collapse into one.
+		HZ_INFO("High-rate mouse input, 64 reports per frame");
+		const uint32_t framesPerRun = eventCount / 64;
+		for (uint32_t layerCount : { 1, 10 })
+		{
+			Hazel::LayerStack layerStack;
+			for (uint32_t i = 0; i < layerCount; i++)
+				layerStack.PushLayer(new BenchLayer());
+
+			auto produce = [](uint32_t frame, auto&& emit)
+			{
+				for (uint32_t i = 0; i < 64; i++)
+				{
+					if (i == 32 && frame % 4 == 0)
+						emit(Hazel::MouseScrolledEvent(0.0f, 1.0f));
+					if (i == 48 && frame % 16 == 0)
+						emit(Hazel::KeyPressedEvent(Hazel::Key::W, 0));
+					emit(Hazel::MouseMovedEvent((float)(frame + i), (float)i));
+				}
+			};
+
+			RunBenchmark("Immediate dispatch, " + std::to_string(layerCount) + " layers", framesPerRun * 64, [&]()
+			{
+				for (uint32_t frame = 0; frame < framesPerRun; frame++)
+				{
+					produce(frame, [&](auto&& event)
+					{
+						DispatchToLayers(layerStack, event);
+					});
+				}
+			});
+
+			Hazel::EventQueue queue;
+			RunBenchmark("EventQueue, " + std::to_string(layerCount) + " layers", framesPerRun * 64, [&]()
+			{
+				for (uint32_t frame = 0; frame < framesPerRun; frame++)
+				{
+					produce(frame, [&](auto&& event)
+					{
+						using T = std::decay_t<decltype(event)>;
+						queue.Push<T>(event);
+					});
+					queue.Dispatch([&](Hazel::Event& event) { DispatchToLayers(layerStack, event); });
+				}
+			});
+
+			auto stats = queue.GetStats();
+			HZ_INFO("  {0} layers: {1} of {2} events coalesced", layerCount, stats.Coalesced, stats.Pushed);
+		}
+	}
+
+}
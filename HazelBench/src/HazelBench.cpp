@@ -0,0 +1,68 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+struct BenchmarkSuite
+{
+	const char* Name;
+	void(*Run)();
+};
+
+static const BenchmarkSuite s_Suites[] =
+{
+	{ "JobSystem", HazelBench::RunJobSystemBenchmarks },
+	{ "FrameAllocator", HazelBench::RunFrameAllocatorBenchmarks },
+	{ "Instrumentor", HazelBench::RunInstrumentorBenchmarks },
+	{ "Renderer2D", HazelBench::RunRenderer2DBenchmarks },
+	{ "Scene", HazelBench::RunSceneBenchmarks },
+	{ "SceneSerializer", HazelBench::RunSerializerBenchmarks },
+	{ "Math", HazelBench::RunMathBenchmarks },
+	{ "Event", HazelBench::RunEventBenchmarks },
+	{ "Input", HazelBench::RunInputBenchmarks }
+};
+
+// HazelBench [--suite <name>] [--repetitions <n>] [--warmup <n>] [--json <file>]
+int main(int argc, char** argv)
+{
+	Hazel::Log::Init();
+
+	const char* suiteFilter = nullptr;
+	const char* jsonPath = nullptr;
+	HazelBench::BenchmarkSettings& settings = HazelBench::GetBenchmarkSettings();
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--suite") == 0)
+			suiteFilter = argv[i + 1];
+		else if (strcmp(argv[i], "--repetitions") == 0)
+			settings.Repetitions = std::max(atoi(argv[i + 1]), 1);
+		else if (strcmp(argv[i], "--warmup") == 0)
+			settings.WarmupRepetitions = std::max(atoi(argv[i + 1]), 0);
+		else if (strcmp(argv[i], "--json") == 0)
+			jsonPath = argv[i + 1];
+		else
+			HZ_WARN("Unknown argument '{0}'", argv[i]);
+	}
+
+	// No window, no GPU: the renderer runs everything down to the graphics API and stops there
+	Hazel::RendererAPI::SetAPI(Hazel::RendererAPI::API::None);
+	Hazel::JobSystem::Init();
+	Hazel::Renderer::Init();
+
+	for (const BenchmarkSuite& suite : s_Suites)
+	{
+		if (!suiteFilter || strcmp(suite.Name, suiteFilter) == 0)
+			suite.Run();
+	}
+
+	if (jsonPath)
+		HazelBench::WriteBenchmarkResults(jsonPath);
+
+	Hazel::Renderer::Shutdown();
+	Hazel::JobSystem::Shutdown();
+	Hazel::Log::Shutdown();
+	return 0;
+}
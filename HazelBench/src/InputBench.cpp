@@ -0,0 +1,136 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include "Hazel/Events/KeyEvent.h"
+#include "Hazel/Events/MouseEvent.h"
+
+#include <atomic>
+
+namespace HazelBench {
+
+	static uint32_t s_InputQueries = 0;
+
+	// Moves its entity like the camera controller in Hazelnut, and follows the mouse while a button is down
+	class MoverScript : public Hazel::ScriptableEntity
+	{
+	public:
+		void OnUpdate(Hazel::Timestep ts)
+		{
+			auto& translation = GetComponent<Hazel::TransformComponent>().Translation;
+			if (Hazel::Input::IsKeyPressed(Hazel::Key::W))
+				translation.y += ts;
+			if (Hazel::Input::IsKeyPressed(Hazel::Key::S))
+				translation.y -= ts;
+			if (Hazel::Input::IsKeyPressed(Hazel::Key::D))
+				translation.x += ts;
+			if (Hazel::Input::IsKeyPressed(Hazel::Key::A))
+				translation.x -= ts;
+			if (Hazel::Input::IsMouseButtonPressed(Hazel::Mouse::ButtonLeft))
+			{
+				auto [x, y] = Hazel::Input::GetMousePosition();
+				translation.x += x * 0.001f;
+				s_InputQueries++;
+			}
+			s_InputQueries += 5;
+		}
+	};
+
+	// What the window would have delivered over a frame: the mouse moving with its left button
+	// held and W going down and up every other second
+	static void FeedFrameInput(uint32_t frame)
+	{
+		if (frame == 0)
+		{
+			Hazel::MouseButtonPressedEvent event(Hazel::Mouse::ButtonLeft);
+			Hazel::Input::OnEvent(event);
+		}
+		if (frame % 60 == 0)
+		{
+			if ((frame / 60) % 2 == 0)
+			{
+				Hazel::KeyPressedEvent event(Hazel::Key::W, 0);
+				Hazel::Input::OnEvent(event);
+			}
+			else
+			{
+				Hazel::KeyReleasedEvent event(Hazel::Key::W);
+				Hazel::Input::OnEvent(event);
+			}
+		}
+		Hazel::MouseMovedEvent event((float)(frame % 1280), 360.0f);
+		Hazel::Input::OnEvent(event);
+	}
+
+	// Without the snapshot every query asked GLFW, on Windows a mouse position query is a
+	// round trip to the OS. Now they are all answered from the frame's copy.
+	static void BenchScriptedScene(uint32_t scriptCount)
+	{
+		Hazel::Ref<Hazel::Scene> scene = Hazel::CreateRef<Hazel::Scene>();
+		for (uint32_t i = 0; i < scriptCount; i++)
+		{
+			Hazel::Entity entity = scene->CreateEntity("Mover " + std::to_string(i));
+			entity.AddComponent<Hazel::NativeScriptComponent>().Bind<MoverScript>();
+		}
+		scene->OnViewportResize(1280, 720);
+
+		const uint32_t frameCount = 120;
+		uint32_t frame = 0;
+		RunBenchmark("Scripted scene frame, " + std::to_string(scriptCount) + " scripts", scriptCount * frameCount, [&]()
+		{
+			s_InputQueries = 0;
+			for (uint32_t i = 0; i < frameCount; i++)
+			{
+				FeedFrameInput(frame++);
+				Hazel::Input::NextFrame();
+				scene->OnUpdateRuntime(1.0f / 60.0f);
+			}
+		});
+
+		HZ_INFO("  {0} scripts: {1} input queries a frame, each used to be a platform call; now none, and one snapshot publish",
+			scriptCount, s_InputQueries / frameCount);
+	}
+
+	static void BenchQueries()
+	{
+		const uint32_t queryCount = 1000000;
+
+		Hazel::KeyPressedEvent event(Hazel::Key::W, 0);
+		Hazel::Input::OnEvent(event);
+		Hazel::Input::NextFrame();
+
+		uint32_t pressed = 0;
+		RunBenchmark("Input::IsKeyPressed, main thread", queryCount, [&]()
+		{
+			for (uint32_t i = 0; i < queryCount; i++)
+				pressed += Hazel::Input::IsKeyPressed((Hazel::KeyCode)(Hazel::Key::A + i % 26));
+		});
+
+		// Workers read the published frame, no locks involved
+		std::atomic<uint32_t> workerPressed{ 0 };
+		RunBenchmark("Input::IsKeyPressed, job workers", queryCount, [&]()
+		{
+			Hazel::JobSystem::ParallelFor(queryCount / 1000, 16, [&](uint32_t batch)
+			{
+				uint32_t batchPressed = 0;
+				for (uint32_t i = batch * 1000; i < (batch + 1) * 1000; i++)
+					batchPressed += Hazel::Input::IsKeyPressed((Hazel::KeyCode)(Hazel::Key::A + i % 26));
+				workerPressed.fetch_add(batchPressed, std::memory_order_relaxed);
+			});
+		});
+		HZ_INFO("  {0} and {1} presses seen", pressed, workerPressed.load());
+
+		Hazel::KeyReleasedEvent release(Hazel::Key::W);
+		Hazel::Input::OnEvent(release);
+		Hazel::Input::NextFrame();
+	}
+
+	void RunInputBenchmarks()
+	{
+		HZ_INFO("Input snapshot");
+		for (uint32_t scriptCount : { 10, 1000 })
+			BenchScriptedScene(scriptCount);
+		BenchQueries();
+	}
+
+}
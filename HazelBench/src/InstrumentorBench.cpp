@@ -0,0 +1,103 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include "Hazel/Debug/Instrumentor.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace HazelBench {
+
+	// Small enough that the writer keeps up, the pause between batches is not timed
+	static const uint32_t s_ScopesPerBatch = 16384;
+	static const uint32_t s_Batches = 64;
+	static const char* s_TraceFile = "HazelBench-Instrumentor.json";
+
+	// The Instrumentor before per-thread buffers: format, lock, write and flush in every scope
+	class LegacyInstrumentor
+	{
+	public:
+		LegacyInstrumentor(const char* filepath)
+			: m_OutputStream(filepath)
+		{
+		}
+
+		void WriteProfile(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+		{
+			auto highResStart = std::chrono::duration<double, std::micro>{ start.time_since_epoch() };
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+			std::stringstream json;
+			json << std::setprecision(3) << std::fixed;
+			json << ",{";
+			json << "\"cat\":\"function\",";
+			json << "\"dur\":" << elapsed.count() << ',';
+			json << "\"name\":\"" << name << "\",";
+			json << "\"ph\":\"X\",";
+			json << "\"pid\":0,";
+			json << "\"tid\":" << std::this_thread::get_id() << ",";
+			json << "\"ts\":" << highResStart.count();
+			json << "}";
+
+			std::lock_guard lock(m_Mutex);
+			m_OutputStream << json.str();
+			m_OutputStream.flush();
+		}
+	private:
+		std::mutex m_Mutex;
+		std::ofstream m_OutputStream;
+	};
+
+	template<typename F>
+	static void BenchScopes(const char* name, const F& scope)
+	{
+		uint64_t droppedBefore = Hazel::Instrumentor::Get().GetDroppedRecordCount();
+
+		double ns = 0.0;
+		for (uint32_t batch = 0; batch < s_Batches; batch++)
+		{
+			BenchTimer timer;
+			for (uint32_t i = 0; i < s_ScopesPerBatch; i++)
+				scope();
+			ns += timer.ElapsedNanoseconds();
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		uint64_t dropped = Hazel::Instrumentor::Get().GetDroppedRecordCount() - droppedBefore;
+		HZ_INFO("  {0:<36} {1:7.1f} ns/scope ({2} dropped)", name, ns / (s_ScopesPerBatch * s_Batches), dropped);
+	}
+
+	void RunInstrumentorBenchmarks()
+	{
+		HZ_INFO("Instrumentor ({0} scopes)", s_ScopesPerBatch * s_Batches);
+
+		BenchScopes("No session", []()
+		{
+			Hazel::InstrumentationTimer timer("HazelBench::EmptyScope");
+		});
+
+		{
+			LegacyInstrumentor legacy(s_TraceFile);
+			BenchScopes("Legacy (stringstream, lock, flush)", [&legacy]()
+			{
+				auto start = std::chrono::steady_clock::now();
+				legacy.WriteProfile("HazelBench::EmptyScope", start, std::chrono::steady_clock::now());
+			});
+		}
+
+		Hazel::Instrumentor::Get().BeginSession("HazelBench", s_TraceFile);
+		BenchScopes("Thread buffer + writer thread", []()
+		{
+			Hazel::InstrumentationTimer timer("HazelBench::EmptyScope");
+		});
+		Hazel::Instrumentor::Get().EndSession();
+
+		std::remove(s_TraceFile);
+	}
+
+}
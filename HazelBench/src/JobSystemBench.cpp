@@ -0,0 +1,89 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+namespace HazelBench {
+
+	static const uint32_t JobBatchSize = 1000;
+	static const uint32_t JobBatchCount = 1000;
+
+	static void BenchSpawnAndWait()
+	{
+		// Main thread helps while waiting, so most jobs are popped by their owner
+		Hazel::JobCounter counter;
+		BenchTimer timer;
+		for (uint32_t batch = 0; batch < JobBatchCount; batch++)
+		{
+			for (uint32_t i = 0; i < JobBatchSize; i++)
+				Hazel::JobSystem::Execute([]() {}, &counter);
+			Hazel::JobSystem::Wait(counter);
+		}
+		double ns = timer.ElapsedNanoseconds();
+
+		HZ_INFO("  Spawn + wait (owner pops):  {0:.1f} ns/job", ns / (JobBatchSize * JobBatchCount));
+	}
+
+	static void BenchSpawnAndSteal()
+	{
+		// Main thread only spins, so every job has to be stolen by a worker
+		Hazel::JobCounter counter;
+		double spawnNs = 0.0;
+		BenchTimer timer;
+		for (uint32_t batch = 0; batch < JobBatchCount; batch++)
+		{
+			BenchTimer spawnTimer;
+			for (uint32_t i = 0; i < JobBatchSize; i++)
+				Hazel::JobSystem::Execute([]() {}, &counter);
+			spawnNs += spawnTimer.ElapsedNanoseconds();
+
+			while (!counter.IsDone())
+				std::this_thread::yield();
+		}
+		double ns = timer.ElapsedNanoseconds();
+
+		HZ_INFO("  Spawn only:                 {0:.1f} ns/job", spawnNs / (JobBatchSize * JobBatchCount));
+		HZ_INFO("  Spawn + steal (workers):    {0:.1f} ns/job", ns / (JobBatchSize * JobBatchCount));
+	}
+
+	static void BenchParallelForView(uint32_t entityCount)
+	{
+		entt::registry registry;
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			auto& tc = registry.emplace<Hazel::TransformComponent>(registry.create());
+			tc.Translation = { (float)i, (float)(i % 100), 0.0f };
+			tc.Rotation = { 0.0f, 0.0f, (float)i * 0.01f };
+		}
+
+		auto view = registry.view<Hazel::TransformComponent>();
+		const entt::entity* entities = view.data();
+		uint32_t count = (uint32_t)view.size();
+
+		std::vector<glm::mat4> results(count);
+
+		BenchTimer timer;
+		for (uint32_t i = 0; i < count; i++)
+			results[i] = view.get(entities[i]).GetTransform();
+		double serialMs = timer.ElapsedMilliseconds();
+
+		timer.Reset();
+		Hazel::JobSystem::ParallelFor(count, 1024, [&](uint32_t i)
+		{
+			results[i] = view.get(entities[i]).GetTransform();
+		});
+		double parallelMs = timer.ElapsedMilliseconds();
+
+		HZ_INFO("  GetTransform over {0} entities: serial {1:.3f} ms, ParallelFor {2:.3f} ms ({3:.2f}x)",
+			count, serialMs, parallelMs, serialMs / parallelMs);
+	}
+
+	void RunJobSystemBenchmarks()
+	{
+		HZ_INFO("JobSystem ({0} workers)", Hazel::JobSystem::GetWorkerCount());
+
+		BenchSpawnAndWait();
+		BenchSpawnAndSteal();
+		BenchParallelForView(100000);
+	}
+
+}
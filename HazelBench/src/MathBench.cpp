@@ -0,0 +1,147 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include "Hazel/Math/Math.h"
+#include "Hazel/Math/TransformBatch.h"
+
+#include <algorithm>
+#include <random>
+
+namespace HazelBench {
+
+	// Relative error, absolute below 1
+	static float MaxError(const glm::mat4& a, const glm::mat4& b)
+	{
+		float error = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			for (int r = 0; r < 4; r++)
+				error = std::max(error, std::abs(a[c][r] - b[c][r]) / std::max(1.0f, std::abs(b[c][r])));
+		}
+		return error;
+	}
+
+	// Checks the batch functions at the current SIMD level against the scalar ones. Decomposed
+	// rotations are compared as rotation matrices: the Euler angles themselves are badly
+	// conditioned near +-90 degrees of pitch, in DecomposeTransform just as much.
+	static void VerifyTransformBatch(const Hazel::Math::TRSArrays& trs, const std::vector<glm::mat4>& transforms)
+	{
+		const float tolerance = 1e-5f;
+
+		std::vector<glm::mat4> composed(trs.Size());
+		Hazel::Math::ComposeTRS(trs, composed.data());
+
+		Hazel::Math::TRSArrays decomposed;
+		Hazel::Math::DecomposeTRS(transforms.data(), transforms.size(), decomposed);
+
+		float composeError = 0.0f, translationError = 0.0f, rotationError = 0.0f, scaleError = 0.0f;
+		for (size_t i = 0; i < trs.Size(); i++)
+		{
+			glm::vec3 translation, rotation, scale;
+			trs.Get(i, translation, rotation, scale);
+			composeError = std::max(composeError, MaxError(composed[i], Hazel::Math::ComposeTransform(translation, rotation, scale)));
+
+			glm::vec3 expectedTranslation, expectedRotation, expectedScale;
+			Hazel::Math::DecomposeTransform(transforms[i], expectedTranslation, expectedRotation, expectedScale);
+			decomposed.Get(i, translation, rotation, scale);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				translationError = std::max(translationError, std::abs(translation[axis] - expectedTranslation[axis]) / std::max(1.0f, std::abs(expectedTranslation[axis])));
+				scaleError = std::max(scaleError, std::abs(scale[axis] - expectedScale[axis]) / expectedScale[axis]);
+			}
+			glm::mat4 rotationMatrix = Hazel::Math::ComposeTransform(glm::vec3(0.0f), rotation, glm::vec3(1.0f));
+			glm::mat4 expectedRotationMatrix = Hazel::Math::ComposeTransform(glm::vec3(0.0f), expectedRotation, glm::vec3(1.0f));
+			rotationError = std::max(rotationError, MaxError(rotationMatrix, expectedRotationMatrix));
+		}
+
+		const char* level = Hazel::Math::GetSIMDLevelName(Hazel::Math::GetSIMDLevel());
+		float maxError = std::max({ composeError, translationError, rotationError, scaleError });
+		if (maxError > tolerance)
+			HZ_ERROR("  {0}: batch transforms differ from the scalar ones by up to {1} (compose {2}, translation {3}, rotation {4}, scale {5})", level, maxError, composeError, translationError, rotationError, scaleError);
+		else
+			HZ_INFO("  {0}: batch transforms match the scalar ones, max error {1}", level, maxError);
+	}
+
+	void RunMathBenchmarks()
+	{
+		// A million, so ns/item reads as ms per million transforms
+		const uint32_t transformCount = 1000000;
+
+		// What the gizmo feeds it: arbitrary rotation, positive non-uniform scale
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> translation(-100.0f, 100.0f), angle(-3.14f, 3.14f), scale(0.1f, 10.0f);
+
+		Hazel::Math::TRSArrays trs;
+		trs.Resize(transformCount);
+		std::vector<Hazel::TransformComponent> components(transformCount);
+		std::vector<glm::mat4> transforms(transformCount);
+		for (uint32_t i = 0; i < transformCount; i++)
+		{
+			Hazel::TransformComponent& component = components[i];
+			component.Translation = { translation(random), translation(random), translation(random) };
+			component.Rotation = { angle(random), angle(random), angle(random) };
+			component.Scale = { scale(random), scale(random), scale(random) };
+			trs.Set(i, component.Translation, component.Rotation, component.Scale);
+			transforms[i] = component.GetTransform();
+		}
+
+		HZ_INFO("Math ({0} transforms, up to {1})", transformCount, Hazel::Math::GetSIMDLevelName(Hazel::Math::GetSupportedSIMDLevel()));
+		glm::vec3 outTranslation, outRotation, outScale, sink(0.0f);
+		std::vector<glm::mat4> composed(transformCount);
+
+		// What TransformComponent::GetTransform did before it went through ComposeTransform
+		RunBenchmark("glm translate * toMat4(quat) * scale", transformCount, [&]()
+		{
+			for (uint32_t i = 0; i < transformCount; i++)
+			{
+				const Hazel::TransformComponent& component = components[i];
+				composed[i] = glm::translate(glm::mat4(1.0f), component.Translation) * glm::toMat4(glm::quat(component.Rotation)) * glm::scale(glm::mat4(1.0f), component.Scale);
+			}
+		});
+
+		RunBenchmark("Math::ComposeTransform", transformCount, [&]()
+		{
+			for (uint32_t i = 0; i < transformCount; i++)
+			{
+				const Hazel::TransformComponent& component = components[i];
+				composed[i] = Hazel::Math::ComposeTransform(component.Translation, component.Rotation, component.Scale);
+			}
+		});
+
+		RunBenchmark("Math::DecomposeTransform", transformCount, [&]()
+		{
+			for (const glm::mat4& transform : transforms)
+			{
+				Hazel::Math::DecomposeTransform(transform, outTranslation, outRotation, outScale);
+				sink += outTranslation + outRotation + outScale;
+			}
+		});
+
+		Hazel::Math::TRSArrays decomposed;
+		Hazel::Math::SIMDLevel supportedLevel = Hazel::Math::GetSupportedSIMDLevel();
+		for (int level = 0; level <= (int)supportedLevel; level++)
+		{
+			Hazel::Math::SetSIMDLevel((Hazel::Math::SIMDLevel)level);
+			std::string levelName = Hazel::Math::GetSIMDLevelName((Hazel::Math::SIMDLevel)level);
+			VerifyTransformBatch(trs, transforms);
+
+			RunBenchmark("Math::ComposeTRS " + levelName, transformCount, [&]()
+			{
+				Hazel::Math::ComposeTRS(trs, composed.data());
+			});
+
+			RunBenchmark("Math::DecomposeTRS " + levelName, transformCount, [&]()
+			{
+				Hazel::Math::DecomposeTRS(transforms.data(), transforms.size(), decomposed);
+			});
+		}
+		Hazel::Math::SetSIMDLevel(supportedLevel);
+
+		// Keeps the loops from being optimized away
+		sink += glm::vec3(composed.back()[3]) + glm::vec3(decomposed.RotationX.back());
+		if (sink.x == 1234.5f)
+			HZ_INFO("{0}", sink.y);
+	}
+
+}
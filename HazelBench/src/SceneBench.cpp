@@ -0,0 +1,425 @@
+#include <Hazel.h>
+
+#include "Benchmarks.h"
+
+#include "Hazel/Math/Math.h"
+#include "Hazel/Scene/SceneHistory.h"
+#include "Hazel/Scene/SceneSerializer.h"
+#include "Hazel/Scene/SceneSnapshotRing.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+namespace HazelBench {
+
+	static const char* s_ScenePath = "HazelBench-Scene.hazel";
+
+	// Sprites on a square grid, with a camera that sees about half of them
+	static Hazel::Ref<Hazel::Scene> CreateSpriteScene(uint32_t spriteCount, std::vector<Hazel::Entity>* outSprites = nullptr)
+	{
+		Hazel::Ref<Hazel::Scene> scene = Hazel::CreateRef<Hazel::Scene>();
+
+		uint32_t side = (uint32_t)std::ceil(std::sqrt((float)spriteCount));
+		for (uint32_t i = 0; i < spriteCount; i++)
+		{
+			Hazel::Entity sprite = scene->CreateEntity("Sprite " + std::to_string(i));
+			sprite.GetComponent<Hazel::TransformComponent>().Translation = { (float)(i % side), (float)(i / side), 0.0f };
+			sprite.AddComponent<Hazel::SpriteRendererComponent>(glm::vec4{ (i % 7) / 7.0f, 0.5f, 0.8f, 1.0f });
+			if (outSprites)
+				outSprites->push_back(sprite);
+		}
+
+		Hazel::Entity camera = scene->CreateEntity("Camera");
+		camera.GetComponent<Hazel::TransformComponent>().Translation = { side * 0.5f, side * 0.5f, 0.0f };
+		camera.AddComponent<Hazel::CameraComponent>().Camera.SetOrthographicSize(side * 0.5f);
+
+		scene->OnViewportResize(1280, 720);
+		return scene;
+	}
+
+	static void BenchSceneUpdate(uint32_t spriteCount)
+	{
+		std::vector<Hazel::Entity> sprites;
+		Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(spriteCount, &sprites);
+
+		RunBenchmark("Scene::OnUpdateRuntime static, " + std::to_string(spriteCount) + " sprites", spriteCount, [&]()
+		{
+			scene->OnUpdateRuntime(1.0f / 60.0f);
+		});
+
+		// Every transform changes, so nothing comes from the world transform cache
+		float angle = 0.0f;
+		RunBenchmark("Scene::OnUpdateRuntime moving, " + std::to_string(spriteCount) + " sprites", spriteCount, [&]()
+		{
+			angle += 0.01f;
+			for (Hazel::Entity sprite : sprites)
+				sprite.GetComponent<Hazel::TransformComponent>().Rotation.z = angle;
+			scene->OnUpdateRuntime(1.0f / 60.0f);
+		});
+
+		// A 60 Hz simulation on a 144 Hz display: a fixed update every frame or two moves
+		// everything, and every frame renders blended between the last two
+		const float fixedStep = 1.0f / 60.0f;
+		double accumulator = 0.0;
+		RunBenchmark("Scene::OnRenderRuntime interpolated, " + std::to_string(spriteCount) + " sprites", spriteCount, [&]()
+		{
+			accumulator += 1.0 / 144.0;
+			while (accumulator >= fixedStep)
+			{
+				scene->OnFixedUpdateRuntime(fixedStep);
+				angle += 0.01f;
+				for (Hazel::Entity sprite : sprites)
+					sprite.GetComponent<Hazel::TransformComponent>().Rotation.z = angle;
+				accumulator -= fixedStep;
+			}
+			scene->OnRenderRuntime((float)(accumulator / fixedStep));
+		});
+	}
+
+	// Split-screen or render-to-texture: every camera's view-projection, every frame
+	static void BenchCameras(uint32_t cameraCount)
+	{
+		std::vector<Hazel::SceneCamera> cameras(cameraCount);
+		std::vector<glm::mat4> transforms(cameraCount), viewProjections(cameraCount);
+		for (uint32_t i = 0; i < cameraCount; i++)
+		{
+			cameras[i].SetViewportSize(1280 / 4, 720 / 4);
+			transforms[i] = Hazel::Math::ComposeTransform({ (float)i, 0.0f, 10.0f }, { 0.0f, 0.0f, 0.01f * i }, glm::vec3(1.0f));
+		}
+
+		std::string suffix = ", " + std::to_string(cameraCount) + " cameras";
+		RunBenchmark("Camera view-projection glm::inverse" + suffix, cameraCount, [&]()
+		{
+			for (uint32_t i = 0; i < cameraCount; i++)
+				viewProjections[i] = cameras[i].GetProjection() * glm::inverse(transforms[i]);
+		});
+
+		RunBenchmark("Camera view-projection Math::InverseAffine" + suffix, cameraCount, [&]()
+		{
+			for (uint32_t i = 0; i < cameraCount; i++)
+				viewProjections[i] = cameras[i].GetProjection() * Hazel::Math::InverseAffine(transforms[i]);
+		});
+
+		// What Scene does for its primary camera: nothing moved, so only the version check
+		std::vector<uint32_t> projectionVersions(cameraCount, UINT32_MAX);
+		bool transformsChanged = false;
+		RunBenchmark("Camera view-projection cached" + suffix, cameraCount, [&]()
+		{
+			for (uint32_t i = 0; i < cameraCount; i++)
+			{
+				uint32_t version = cameras[i].GetProjectionVersion();
+				if (version != projectionVersions[i] || transformsChanged)
+				{
+					viewProjections[i] = cameras[i].GetProjection() * Hazel::Math::InverseAffine(transforms[i]);
+					projectionVersions[i] = version;
+				}
+			}
+		});
+
+		// The editor camera asked every frame, idle and after being moved
+		Hazel::EditorCamera editorCamera(30.0f, 1.778f, 0.1f, 1000.0f);
+		glm::mat4 sink(0.0f);
+		RunBenchmark("EditorCamera::GetViewProjection idle" + suffix, cameraCount, [&]()
+		{
+			for (uint32_t i = 0; i < cameraCount; i++)
+				sink += editorCamera.GetViewProjection();
+		});
+
+		RunBenchmark("EditorCamera::GetViewProjection moved" + suffix, cameraCount, [&]()
+		{
+			for (uint32_t i = 0; i < cameraCount; i++)
+			{
+				editorCamera.SetDistance(10.0f + (i & 1));
+				sink += editorCamera.GetViewProjection();
+			}
+		});
+
+		if (sink[0][0] + viewProjections.back()[0][0] == 1234.5f)
+			HZ_INFO("{0}", sink[1][1]);
+	}
+
+	// What the hierarchy search costs per keystroke: a scan over every tag, the way a text
+	// filter over the registry would do it, against the scene's tag index
+	static void BenchTagSearch(uint32_t entityCount)
+	{
+		std::vector<Hazel::Entity> sprites;
+		Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(entityCount, &sprites);
+		std::vector<entt::entity> matches;
+		std::string suffix = ", " + std::to_string(entityCount) + " entities";
+
+		RunBenchmark("Tag search scan" + suffix, entityCount, [&]()
+		{
+			matches.clear();
+			for (Hazel::Entity sprite : sprites)
+			{
+				const std::string& tag = sprite.GetComponent<Hazel::TagComponent>().Tag;
+				if (tag.size() >= 8 && std::equal(tag.begin(), tag.begin() + 8, "sprite 4", [](char a, char b) { return std::tolower((unsigned char)a) == b; }))
+					matches.push_back(sprite);
+			}
+		});
+
+		RunBenchmark("TagIndex::FindPrefix" + suffix, entityCount, [&]()
+		{
+			scene->GetTagIndex().FindPrefix("sprite 4", matches);
+		});
+
+		// Every keystroke in the tag field is a rename, merged into the search table
+		uint32_t renames = 0;
+		RunBenchmark("Scene::SetTag indexed" + suffix, 1, [&]()
+		{
+			Hazel::Entity sprite = sprites[(renames++ * 7919) % sprites.size()];
+			scene->SetTag(sprite, "Renamed " + std::to_string(renames));
+			scene->GetTagIndex().FindPrefix("renamed", matches);
+		});
+	}
+
+	// Gizmo drags on a large scene: what the undo history keeps per drag, against the
+	// size of the scene itself, and what recording and undoing costs
+	static void BenchSceneHistory(uint32_t entityCount)
+	{
+		const uint32_t dragCount = 1000, dragFrames = 30;
+
+		std::vector<Hazel::Entity> sprites;
+		Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(entityCount, &sprites);
+		Hazel::SceneHistory history;
+		history.SetContext(scene);
+
+		BenchTimer timer;
+		for (uint32_t drag = 0; drag < dragCount; drag++)
+		{
+			// Selected first, the way the editor does
+			Hazel::Entity sprite = sprites[(drag * 7919) % sprites.size()];
+			history.Track(sprite, false);
+			for (uint32_t frame = 0; frame <= dragFrames; frame++)
+			{
+				sprite.GetComponent<Hazel::TransformComponent>().Translation.x += 0.1f;
+				history.Track(sprite, frame < dragFrames);
+			}
+		}
+		ReportBenchmark("SceneHistory::Track, " + std::to_string(dragFrames) + "-frame drags", dragCount * (dragFrames + 1), { timer.ElapsedNanoseconds() });
+
+		size_t sceneBytes = entityCount * (sizeof(Hazel::TagComponent) + sizeof(Hazel::TransformComponent) + sizeof(Hazel::RelationshipComponent) + sizeof(Hazel::WorldTransformComponent) + sizeof(Hazel::SpriteRendererComponent));
+		HZ_INFO("  {0} entries for {1} drags, {2:.1f} bytes each; a copy of the scene's components is {3:.1f} KB",
+			history.GetEntryCount(), dragCount, (double)history.GetMemoryUsage() / history.GetEntryCount(), sceneBytes / 1024.0);
+
+		timer.Reset();
+		while (history.Undo());
+		ReportBenchmark("SceneHistory::Undo", dragCount, { timer.ElapsedNanoseconds() });
+
+		timer.Reset();
+		while (history.Redo());
+		ReportBenchmark("SceneHistory::Redo", dragCount, { timer.ElapsedNanoseconds() });
+
+		// Destroying is the expensive kind of entry, it keeps the whole entity
+		timer.Reset();
+		for (uint32_t i = 0; i < dragCount; i++)
+			history.DestroyEntity(sprites[i]);
+		ReportBenchmark("SceneHistory::DestroyEntity", dragCount, { timer.ElapsedNanoseconds() });
+
+		timer.Reset();
+		for (uint32_t i = 0; i < dragCount; i++)
+			history.Undo();
+		ReportBenchmark("SceneHistory::Undo destroy", dragCount, { timer.ElapsedNanoseconds() });
+	}
+
+	// Entering play mode. The copy is checked against the source first: same handles,
+	// same components.
+	static void BenchSceneCopy(uint32_t entityCount)
+	{
+		std::vector<Hazel::Entity> sprites;
+		Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(entityCount, &sprites);
+		for (uint32_t i = 0; i < entityCount; i += 3)
+			scene->DestroyEntity(sprites[i]);
+
+		{
+			Hazel::Ref<Hazel::Scene> copy = Hazel::Scene::Copy(scene);
+			uint32_t mismatches = 0;
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				Hazel::Entity copied{ sprites[i], copy.get() };
+				if (scene->IsValid(sprites[i]) != copy->IsValid(copied))
+					mismatches++;
+				else if (copy->IsValid(copied) && (copied.GetComponent<Hazel::TransformComponent>().Translation != sprites[i].GetComponent<Hazel::TransformComponent>().Translation
+					|| copied.GetComponent<Hazel::TagComponent>().Tag != sprites[i].GetComponent<Hazel::TagComponent>().Tag))
+					mismatches++;
+			}
+			if (mismatches)
+				HZ_ERROR("  Scene::Copy: {0} entities differ from the source", mismatches);
+		}
+
+		std::string suffix = ", " + std::to_string(entityCount) + " entities";
+		RunBenchmark("Scene::Copy" + suffix, entityCount, [&]()
+		{
+			Hazel::Ref<Hazel::Scene> copy = Hazel::Scene::Copy(scene);
+		});
+
+		// What entering play mode would cost going through the serializer instead, once, it is slow
+		auto coreLevel = Hazel::Log::GetCoreLogger()->level();
+		Hazel::Log::GetCoreLogger()->set_level(spdlog::level::info);
+		Hazel::SceneSerializer(scene).Serialize(s_ScenePath);
+		{
+			Hazel::Ref<Hazel::Scene> loaded = Hazel::CreateRef<Hazel::Scene>();
+			BenchTimer timer;
+			Hazel::SceneSerializer(loaded).Deserialize(s_ScenePath);
+			ReportBenchmark("SceneSerializer::Deserialize" + suffix, entityCount, { timer.ElapsedNanoseconds() });
+		}
+		std::remove(s_ScenePath);
+		Hazel::Log::GetCoreLogger()->set_level(coreLevel);
+	}
+
+	// A rollback window: a tenth of the sprites move every tick, then the scene goes back
+	// to the newest and to the oldest tick in the window
+	static void BenchSceneSnapshots(uint32_t entityCount)
+	{
+		std::vector<Hazel::Entity> sprites;
+		Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(entityCount, &sprites);
+		Hazel::SceneSnapshotRing ring(scene, 64);
+
+		auto simulate = [&](uint64_t tick)
+		{
+			for (uint32_t i = (uint32_t)(tick % 10); i < entityCount; i += 10)
+				sprites[i].GetComponent<Hazel::TransformComponent>().Translation.x += 0.01f;
+		};
+
+		std::vector<glm::vec3> oldest;
+		for (uint64_t tick = 0; tick < ring.GetCapacity(); tick++)
+		{
+			simulate(tick);
+			ring.Capture(tick);
+			if (tick == 0)
+			{
+				for (Hazel::Entity sprite : sprites)
+					oldest.push_back(sprite.GetComponent<Hazel::TransformComponent>().Translation);
+			}
+		}
+
+		ring.Restore(ring.GetOldestTick());
+		uint32_t mismatches = 0;
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			if (sprites[i].GetComponent<Hazel::TransformComponent>().Translation != oldest[i])
+				mismatches++;
+		}
+		if (mismatches)
+			HZ_ERROR("  SceneSnapshotRing::Restore: {0} entities differ from the snapshot", mismatches);
+
+		std::string suffix = ", " + std::to_string(entityCount) + " entities";
+		uint64_t tick = ring.GetNewestTick();
+		ring.Restore(tick);
+		RunBenchmark("SceneSnapshotRing::Capture" + suffix, entityCount, [&]()
+		{
+			simulate(++tick);
+			ring.Capture(tick);
+		});
+		RunBenchmark("SceneSnapshotRing::Restore newest" + suffix, entityCount, [&]()
+		{
+			ring.Restore(ring.GetNewestTick());
+		});
+		RunBenchmark("SceneSnapshotRing::Restore oldest and back" + suffix, entityCount, [&]()
+		{
+			ring.Restore(ring.GetOldestTick());
+			ring.Restore(ring.GetNewestTick());
+		});
+		HZ_INFO("  {0} snapshots take {1} KB", ring.GetSnapshotCount(), ring.GetMemoryUsage() / 1024);
+	}
+
+	void RunSceneBenchmarks()
+	{
+		HZ_INFO("Scene update");
+		BenchSceneUpdate(1000);
+		BenchSceneUpdate(10000);
+		BenchSceneUpdate(100000);
+
+		HZ_INFO("Cameras");
+		BenchCameras(256);
+
+		HZ_INFO("Tag search");
+		BenchTagSearch(100000);
+
+		HZ_INFO("Undo history");
+		BenchSceneHistory(100000);
+
+		HZ_INFO("Play mode");
+		BenchSceneCopy(100000);
+
+		HZ_INFO("Snapshots");
+		BenchSceneSnapshots(10000);
+	}
+
+	// The per-entity trace in Deserialize going to the console: written synchronously, queued
+	// for the sink thread, and filtered out by level, which is as close as a running build gets
+	// to compiling it out with HZ_LOG_LEVEL. One repetition each, the console is slow.
+	static void BenchDeserializeLogging(uint32_t entityCount)
+	{
+		HZ_INFO("SceneSerializer::Deserialize logging ({0} entities)", entityCount);
+		{
+			Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(entityCount);
+			Hazel::SceneSerializer(scene).Serialize(s_ScenePath);
+		}
+
+		auto deserialize = [entityCount](const char* variant)
+		{
+			Hazel::Log::Flush();
+			uint64_t dropped = Hazel::Log::GetDroppedMessageCount();
+
+			Hazel::Ref<Hazel::Scene> loaded = Hazel::CreateRef<Hazel::Scene>();
+			BenchTimer timer;
+			Hazel::SceneSerializer(loaded).Deserialize(s_ScenePath);
+			double nanoseconds = timer.ElapsedNanoseconds();
+
+			// Draining the queue is the sink thread's time, not the caller's
+			BenchTimer drainTimer;
+			Hazel::Log::Flush();
+			double drainMilliseconds = drainTimer.ElapsedMilliseconds();
+
+			ReportBenchmark(std::string("SceneSerializer::Deserialize ") + variant + ", " + std::to_string(entityCount) + " entities", entityCount, { nanoseconds });
+			HZ_INFO("  {0:.2f} ms until the log caught up, {1} messages dropped", drainMilliseconds, Hazel::Log::GetDroppedMessageCount() - dropped);
+		};
+
+		Hazel::LogMode mode = Hazel::Log::GetMode();
+		auto coreLevel = Hazel::Log::GetCoreLogger()->level();
+		Hazel::Log::GetCoreLogger()->set_level(spdlog::level::trace);
+
+		Hazel::Log::SetMode(Hazel::LogMode::Synchronous);
+		deserialize("trace, synchronous");
+		Hazel::Log::SetMode(Hazel::LogMode::Asynchronous);
+		deserialize("trace, asynchronous");
+
+		Hazel::Log::GetCoreLogger()->set_level(spdlog::level::info);
+		deserialize("trace filtered out");
+
+		Hazel::Log::SetMode(mode);
+		Hazel::Log::GetCoreLogger()->set_level(coreLevel);
+		std::remove(s_ScenePath);
+	}
+
+	void RunSerializerBenchmarks()
+	{
+		const uint32_t entityCount = 10000;
+
+		// The per-entity trace logging is measured separately, here it would only flood the console
+		auto coreLevel = Hazel::Log::GetCoreLogger()->level();
+		Hazel::Log::GetCoreLogger()->set_level(spdlog::level::info);
+
+		HZ_INFO("SceneSerializer ({0} entities)", entityCount);
+		Hazel::Ref<Hazel::Scene> scene = CreateSpriteScene(entityCount);
+		RunBenchmark("SceneSerializer::Serialize", entityCount, [&]()
+		{
+			Hazel::SceneSerializer(scene).Serialize(s_ScenePath);
+		});
+
+		RunBenchmark("SceneSerializer::Deserialize", entityCount, [&]()
+		{
+			Hazel::Ref<Hazel::Scene> loaded = Hazel::CreateRef<Hazel::Scene>();
+			Hazel::SceneSerializer(loaded).Deserialize(s_ScenePath);
+		});
+
+		std::remove(s_ScenePath);
+		Hazel::Log::GetCoreLogger()->set_level(coreLevel);
+
+		BenchDeserializeLogging(50000);
+	}
+
+}
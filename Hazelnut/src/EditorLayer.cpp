@@ -8,14 +8,26 @@
 #include "Hazel/Scene/SceneSerializer.h"
 #include "Hazel/Utils/PlatformUtils.h"
 #include "Hazel/Math/Math.h"
+#include "Hazel/Core/FrameAllocator.h"
+#include "Hazel/Debug/AllocationCounter.h"
+#include "Hazel/Debug/Instrumentor.h"
 
 #include "ImGuizmo.h"
 
+#include <chrono>
+
 namespace Hazel {
 
 	EditorLayer::EditorLayer()
 		: Layer("Sandbox2D")//, m_CameraController(1280.0f / 720.0f, true)
 	{
+		Subscribe<KeyPressedEvent>(HZ_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
+		Subscribe<MouseButtonPressedEvent>(HZ_BIND_EVENT_FN(EditorLayer::OnMouseButtonPressed));
+		Subscribe<MouseScrolledEvent>([this](MouseScrolledEvent& e)
+		{
+			m_EditorCamera.OnEvent(e);
+			return false;
+		});
 	}
 
 	void EditorLayer::OnAttach()
@@ -32,6 +44,7 @@ namespace Hazel {
 		m_Framebuffer = Framebuffer::Create(fbSpec);
 
 		m_ActiveScene = CreateRef<Scene>();
+		m_EditorScene = m_ActiveScene;
 
 		m_EditorCamera = EditorCamera(30.0f, 1.778f, 0.1f, 1000.0f);
 
@@ -84,9 +97,11 @@ namespace Hazel {
 #endif
 
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SceneHierarchyPanel.SetHistory(&m_SceneHistory);
 
 		SceneSerializer serializer(m_ActiveScene);
 		serializer.Deserialize("assets/scenes/Example.hazel");
+		m_SceneHistory.SetContext(m_ActiveScene);
 	}
 
 	void EditorLayer::OnDetach()
@@ -94,15 +109,25 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 	}
 
+	void EditorLayer::OnFixedUpdate(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_SceneState == SceneState::Play)
+			m_ActiveScene->OnFixedUpdateRuntime(ts);
+	}
+
 	void EditorLayer::OnUpdate(Timestep ts)
 	{
 		HZ_PROFILE_FUNCTION();
 
 		// Resize
+		bool framebufferResized = false;
 		if (Hazel::FramebufferSpecification spec = m_Framebuffer->GetSpecification();
 			m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f && // zero sized framebuffer is invalid
 			(spec.Width != m_ViewportSize.x || spec.Height != m_ViewportSize.y))
 		{
+			framebufferResized = true;
 			m_Framebuffer->Resize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 			// m_CameraController.OnResize(m_ViewportSize.x, m_ViewportSize.y);
 			m_EditorCamera.SetViewportSize(m_ViewportSize.x, m_ViewportSize.y);
@@ -125,7 +150,24 @@ namespace Hazel {
 		m_Framebuffer->ClearAttachment(1, -1);
 
 		// Update scene
-		m_ActiveScene->OnUpdateEditor(ts, m_EditorCamera);
+		switch (m_SceneState)
+		{
+			case SceneState::Edit:
+			{
+				m_ActiveScene->OnUpdateEditor(ts, m_EditorCamera);
+				break;
+			}
+			case SceneState::Play:
+			{
+				// With fixed updates the scripts already ran in OnFixedUpdate
+				Application& app = Application::Get();
+				if (app.GetSpecification().FixedUpdateStep > 0.0f)
+					m_ActiveScene->OnRenderRuntime(app.GetFixedUpdateAlpha());
+				else
+					m_ActiveScene->OnUpdateRuntime(ts);
+				break;
+			}
+		}
 
 		auto [mx, my] = ImGui::GetMousePos();
 		mx -= m_ViewportBounds[0].x;
@@ -135,7 +177,8 @@ namespace Hazel {
 		int mouseX = (int)mx;
 		int mouseY = (int)my;
 
-		if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
+		// ReadPixel sees the last frame the render thread finished, a freshly resized framebuffer holds nothing yet
+		if (!framebufferResized && mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
 		{
 			int pixelData = m_Framebuffer->ReadPixel(1, mouseX, mouseY);
 			m_HoveredEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
@@ -213,17 +256,29 @@ namespace Hazel {
 					ImGui::EndMenu();
 				}
 
+				if (ImGui::BeginMenu("Edit"))
+				{
+					if (ImGui::MenuItem("Undo", "Ctrl+Z", false, m_SceneHistory.CanUndo()))
+						Undo();
+					if (ImGui::MenuItem("Redo", "Ctrl+Y", false, m_SceneHistory.CanRedo()))
+						Redo();
+					ImGui::EndMenu();
+				}
+
 				ImGui::EndMenuBar();
 			}
 		}
 		m_SceneHierarchyPanel.OnImGuiRender();
+		m_MemoryPanel.OnImGuiRender();
+		m_ProfilerPanel.OnImGuiRender();
+		m_ConsolePanel.OnImGuiRender();
 
 		ImGui::Begin("Stats");
 
-		std::string name = "None";
+		const char* name = "None";
 		if (m_HoveredEntity)
-			name = m_HoveredEntity.GetComponent<TagComponent>().Tag;
-		ImGui::Text("Hovered Entity: %s", name.c_str());
+			name = m_HoveredEntity.GetComponent<TagComponent>().Tag.c_str();
+		ImGui::Text("Hovered Entity: %s", name);
 
 		auto stats = Renderer2D::GetStats();
 		ImGui::Text("Renderer2D stats:");
@@ -231,6 +286,31 @@ namespace Hazel {
 		ImGui::Text("Quads: %d", stats.QuadCount);
 		ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
+		ImGui::Text("Uploaded: %.1f KB", stats.UploadedBytes / 1024.0f);
+		ImGui::Separator();
+
+		auto& sceneStats = m_ActiveScene->GetStats();
+		auto& updateGraph = m_ActiveScene->GetUpdateGraph(false);
+		ImGui::Text("Scene stats:");
+		ImGui::Text("Visible sprites: %d / %d", sceneStats.VisibleSpriteCount, sceneStats.SpriteCount);
+		ImGui::TextWrapped("Critical path (%.3f ms): %s", updateGraph.GetCriticalPathMilliseconds(), updateGraph.GetCriticalPath().c_str());
+		ImGui::Separator();
+
+		auto renderThreadStats = RenderThread::GetStats();
+		ImGui::Text("Render thread (%s):", RenderThread::GetPolicy() == RenderThreadPolicy::MultiThreaded ? "multi-threaded" : "single-threaded");
+		ImGui::Text("Commands: %d (%.1f KB)", renderThreadStats.CommandCount, renderThreadStats.CommandBytes / 1024.0f);
+		ImGui::Text("Execute: %.3f ms", renderThreadStats.RenderThreadBusyTime);
+		ImGui::Text("Main thread wait: %.3f ms", renderThreadStats.MainThreadWaitTime);
+		ImGui::Text("Overlap: %.3f ms", renderThreadStats.OverlapTime);
+		ImGui::Separator();
+
+		auto frameAllocatorStats = FrameAllocator::GetStats();
+		ImGui::Text("Memory:");
+		ImGui::Text("Heap allocations: %d (%.1f KB)", AllocationCounter::GetFrameAllocations(), AllocationCounter::GetFrameAllocatedBytes() / 1024.0f);
+		ImGui::Text("Frame allocations: %d (%.1f KB)", frameAllocatorStats.AllocationCount, frameAllocatorStats.UsedBytes / 1024.0f);
+		if (frameAllocatorStats.OverflowBytes)
+			ImGui::Text("Frame allocator overflow: %.1f KB", frameAllocatorStats.OverflowBytes / 1024.0f);
+		ImGui::Text("Undo history: %d entries (%.1f / %.0f KB)", m_SceneHistory.GetEntryCount(), m_SceneHistory.GetMemoryUsage() / 1024.0f, m_SceneHistory.GetMemoryBudget() / 1024.0f);
 		ImGui::Separator();
 
 		uint32_t textureId = m_HmmTexture->GetRendererID();
@@ -277,9 +357,11 @@ namespace Hazel {
 			const glm::mat4& cameraProjection = m_EditorCamera.GetProjection();
 			glm::mat4 cameraView = m_EditorCamera.GetViewMatrix();
 
-			// Entity transform
+			// Entity transform (manipulated in world space)
 			auto& tc = selectedEntity.GetComponent<TransformComponent>();
-			glm::mat4 transform = tc.GetTransform();
+			Entity parent = m_ActiveScene->GetParent(selectedEntity);
+			glm::mat4 parentTransform = parent ? parent.GetComponent<WorldTransformComponent>().Transform : glm::mat4(1.0f);
+			glm::mat4 transform = parentTransform * tc.GetTransform();
 
 			// Snapping
 			bool snap = Input::IsKeyPressed(Key::LeftControl);
@@ -296,6 +378,9 @@ namespace Hazel {
 
 			if (ImGuizmo::IsUsing())
 			{
+				if (parent)
+					transform = glm::inverse(parentTransform) * transform;
+
 				glm::vec3 translation, rotation, scale;
 				Math::DecomposeTransform(transform, translation, rotation, scale);
 
@@ -309,17 +394,14 @@ namespace Hazel {
 		ImGui::End();
 		ImGui::PopStyleVar();
 
-		ImGui::End();
-	}
+		UI_Toolbar();
 
-	void EditorLayer::OnEvent(Event& e)
-	{
-		// m_CameraController.OnEvent(e);
-		m_EditorCamera.OnEvent(e);
+		// Everything that edits the scene has run. A gizmo drag or a widget being dragged or
+		// typed in stays a single undo entry until it is let go. Play mode changes a copy.
+		if (m_SceneState == SceneState::Edit)
+			m_SceneHistory.Track(m_SceneHierarchyPanel.GetSelectedEntity(), ImGui::IsAnyItemActive() || ImGuizmo::IsUsing());
 
-		EventDispatcher dispatcher(e);
-		dispatcher.Dispatch<KeyPressedEvent>(HZ_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
-		dispatcher.Dispatch<MouseButtonPressedEvent>(HZ_BIND_EVENT_FN(EditorLayer::OnMouseButtonPressed));
+		ImGui::End();
 	}
 
 	bool EditorLayer::OnKeyPressed(KeyPressedEvent& e)
@@ -349,6 +431,20 @@ namespace Hazel {
 					SaveSceneAs();
 				break;
 			}
+			case Key::Z:
+			{
+				if (control && shift)
+					Redo();
+				else if (control)
+					Undo();
+				break;
+			}
+			case Key::Y:
+			{
+				if (control)
+					Redo();
+				break;
+			}
 
 			// Gizmos
 			case Key::Q:
@@ -375,7 +471,16 @@ namespace Hazel {
 					m_GizmoType = ImGuizmo::OPERATION::SCALE;
 				break;
 			}
+
+			// Profiling
+			case Key::F8:
+			{
+				Instrumentor::Get().RequestFlightRecorderDump();
+				break;
+			}
 		}
+
+		return false;
 	}
 
 	bool EditorLayer::OnMouseButtonPressed(MouseButtonPressedEvent& e)
@@ -390,9 +495,14 @@ namespace Hazel {
 
 	void EditorLayer::NewScene()
 	{
+		if (m_SceneState == SceneState::Play)
+			OnSceneStop();
+
 		m_ActiveScene = CreateRef<Scene>();
+		m_EditorScene = m_ActiveScene;
 		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SceneHistory.SetContext(m_ActiveScene);
 	}
 
 	void EditorLayer::OpenScene()
@@ -403,6 +513,7 @@ namespace Hazel {
 			NewScene();
 			SceneSerializer serializer(m_ActiveScene);
 			serializer.Deserialize(*filepath);
+			m_SceneHistory.Clear();
 		}
 	}
 
@@ -411,9 +522,88 @@ namespace Hazel {
 		std::optional<std::string> filepath = FileDialogs::SaveFile("Hazel Scene (*.hazel)\0*.hazel\0");
 		if (filepath)
 		{
-			SceneSerializer serializer(m_ActiveScene);
+			SceneSerializer serializer(m_EditorScene);
 			serializer.Serialize(*filepath);
 		}
 	}
 
+	void EditorLayer::Undo()
+	{
+		// Not halfway through a drag, and not on the play mode copy
+		if (m_SceneState != SceneState::Edit || ImGuizmo::IsUsing() || !m_SceneHistory.Undo())
+			return;
+
+		if (!m_ActiveScene->IsValid(m_SceneHierarchyPanel.GetSelectedEntity()))
+			m_SceneHierarchyPanel.SetSelectedEntity({});
+	}
+
+	void EditorLayer::Redo()
+	{
+		if (m_SceneState != SceneState::Edit || ImGuizmo::IsUsing() || !m_SceneHistory.Redo())
+			return;
+
+		if (!m_ActiveScene->IsValid(m_SceneHierarchyPanel.GetSelectedEntity()))
+			m_SceneHierarchyPanel.SetSelectedEntity({});
+	}
+
+	void EditorLayer::OnScenePlay()
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		m_SceneState = SceneState::Play;
+		m_ActiveScene = Scene::Copy(m_EditorScene);
+		m_HoveredEntity = {};
+		m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+
+		// Handles are the same in the copy, the selection carries over
+		Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity();
+		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SceneHierarchyPanel.SetHistory(nullptr);
+		if (selectedEntity)
+			m_SceneHierarchyPanel.SetSelectedEntity({ selectedEntity, m_ActiveScene.get() });
+
+		m_ScenePlayTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		HZ_CORE_INFO("Entered play mode in {0:.2f} ms", m_ScenePlayTime);
+	}
+
+	void EditorLayer::OnSceneStop()
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		m_SceneState = SceneState::Edit;
+		m_ActiveScene = m_EditorScene;
+		m_HoveredEntity = {};
+
+		// Entities created while playing do not exist here
+		Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity();
+		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SceneHierarchyPanel.SetHistory(&m_SceneHistory);
+		if (selectedEntity && m_ActiveScene->IsValid({ selectedEntity, m_ActiveScene.get() }))
+			m_SceneHierarchyPanel.SetSelectedEntity({ selectedEntity, m_ActiveScene.get() });
+
+		m_SceneStopTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		HZ_CORE_INFO("Left play mode in {0:.2f} ms", m_SceneStopTime);
+	}
+
+	void EditorLayer::UI_Toolbar()
+	{
+		ImGui::Begin("##toolbar", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
+
+		if (m_SceneState == SceneState::Edit)
+		{
+			if (ImGui::Button("Play"))
+				OnScenePlay();
+		}
+		else
+		{
+			if (ImGui::Button("Stop"))
+				OnSceneStop();
+		}
+
+		ImGui::SameLine();
+		ImGui::TextDisabled("Play %.2f ms, stop %.2f ms", m_ScenePlayTime, m_SceneStopTime);
+
+		ImGui::End();
+	}
+
 }
\ No newline at end of file
@@ -2,7 +2,12 @@
 
 #include <Hazel.h>
 
+#include "Hazel/Scene/SceneHistory.h"
+
 #include "Panels/SceneHierarchyPanel.h"
+#include "Panels/MemoryPanel.h"
+#include "Panels/ProfilerPanel.h"
+#include "Panels/ConsolePanel.h"
 
 namespace Hazel {
 
@@ -15,9 +20,9 @@ namespace Hazel {
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
 
+		virtual void OnFixedUpdate(Timestep ts) override;
 		virtual void OnUpdate(Timestep ts) override;
 		virtual void OnImGuiRender() override;
-		virtual void OnEvent(Event& e) override;
 	private:
 		bool OnKeyPressed(KeyPressedEvent& e);
 		bool OnMouseButtonPressed(MouseButtonPressedEvent& e);
@@ -25,6 +30,14 @@ namespace Hazel {
 		void NewScene();
 		void OpenScene();
 		void SaveSceneAs();
+
+		void Undo();
+		void Redo();
+
+		void OnScenePlay();
+		void OnSceneStop();
+
+		void UI_Toolbar();
 	private:
 		// OrthographicCameraController m_CameraController;
 		EditorCamera m_EditorCamera;
@@ -37,7 +50,17 @@ namespace Hazel {
 		Ref<Texture2D> m_SpriteSheet;
 		Ref<SubTexture2D> m_RoofTexture, m_EntranceTexture;
 
+		// The active scene is the editor scene, or a copy of it while playing
 		Ref<Scene> m_ActiveScene;
+		Ref<Scene> m_EditorScene;
+		SceneHistory m_SceneHistory;
+
+		enum class SceneState
+		{
+			Edit = 0, Play = 1
+		};
+		SceneState m_SceneState = SceneState::Edit;
+		float m_ScenePlayTime = 0.0f, m_SceneStopTime = 0.0f; // Milliseconds
 
 		bool m_ViewportFocused = false, m_ViewportHovered = false;
 		glm::vec2 m_ViewportSize{ 0, 0 };
@@ -47,6 +70,9 @@ namespace Hazel {
 
 		// Panels
 		SceneHierarchyPanel m_SceneHierarchyPanel;
+		MemoryPanel m_MemoryPanel;
+		ProfilerPanel m_ProfilerPanel;
+		ConsolePanel m_ConsolePanel;
 	};
 
 }
\ No newline at end of file
@@ -12,8 +12,8 @@ namespace Hazel {
 	class Hazelnut : public Application
 	{
 	public:
-		Hazelnut()
-			: Application("Hazel Editor")
+		Hazelnut(const ApplicationSpecification& specification)
+			: Application(specification)
 		{
 			PushLayer(new EditorLayer());
 		}
@@ -25,9 +25,12 @@ namespace Hazel {
 
 	};
 
-	Application* CreateApplication()
+	Application* CreateApplication(ApplicationCommandLineArgs args)
 	{
-		return new Hazelnut();
+		ApplicationSpecification specification;
+		specification.Name = "Hazel Editor";
+		specification.CommandLineArgs = args;
+		return new Hazelnut(specification);
 	}
 
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "ConsolePanel.h"
+
+namespace Hazel {
+
+	static ImVec4 LevelColor(spdlog::level::level_enum level)
+	{
+		switch (level)
+		{
+			case spdlog::level::trace:
+			case spdlog::level::debug:    return { 0.6f, 0.6f, 0.6f, 1.0f };
+			case spdlog::level::info:     return { 0.4f, 0.9f, 0.4f, 1.0f };
+			case spdlog::level::warn:     return { 1.0f, 0.85f, 0.3f, 1.0f };
+			case spdlog::level::err:      return { 1.0f, 0.4f, 0.4f, 1.0f };
+			case spdlog::level::critical: return { 1.0f, 0.2f, 0.6f, 1.0f };
+		}
+		return { 1.0f, 1.0f, 1.0f, 1.0f };
+	}
+
+	void ConsolePanel::OnImGuiRender()
+	{
+		ImGui::Begin("Console");
+
+		if (ImGui::Button("Clear"))
+			Log::ClearRecentMessages();
+		ImGui::SameLine();
+		ImGui::Checkbox("Auto-scroll", &m_AutoScroll);
+		ImGui::SameLine();
+
+		const char* levels[] = { "Trace", "Debug", "Info", "Warn", "Error", "Critical" };
+		ImGui::SetNextItemWidth(100.0f);
+		m_FilterChanged |= ImGui::Combo("##Level", &m_MinimumLevel, levels, IM_ARRAYSIZE(levels));
+		ImGui::SameLine();
+		m_FilterChanged |= m_Filter.Draw("Filter", -100.0f);
+
+		uint64_t dropped = Log::GetDroppedMessageCount();
+		if (dropped)
+		{
+			ImGui::SameLine();
+			ImGui::TextDisabled("%llu dropped", (unsigned long long)dropped);
+		}
+		ImGui::Separator();
+
+		// Only copied out of the log when something was logged
+		uint64_t version = Log::GetRecentMessagesVersion();
+		if (version != m_MessagesVersion)
+		{
+			Log::GetRecentMessages(m_Messages);
+			m_MessagesVersion = version;
+			m_FilterChanged = true;
+		}
+		if (m_FilterChanged)
+		{
+			UpdateVisibleMessages();
+			m_FilterChanged = false;
+		}
+
+		ImGui::BeginChild("ConsoleMessages", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+		ImGuiListClipper clipper;
+		clipper.Begin((int)m_VisibleMessages.size());
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				const LogMessage& message = m_Messages[m_VisibleMessages[i]];
+				ImGui::PushStyleColor(ImGuiCol_Text, LevelColor(message.Level));
+				ImGui::TextUnformatted(message.Text.data(), message.Text.data() + message.Text.size());
+				ImGui::PopStyleColor();
+			}
+		}
+		clipper.End();
+
+		if (m_AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+			ImGui::SetScrollHereY(1.0f);
+
+		ImGui::EndChild();
+		ImGui::End();
+	}
+
+	void ConsolePanel::UpdateVisibleMessages()
+	{
+		m_VisibleMessages.clear();
+		for (uint32_t i = 0; i < (uint32_t)m_Messages.size(); i++)
+		{
+			const LogMessage& message = m_Messages[i];
+			if (message.Level < m_MinimumLevel)
+				continue;
+			if (!m_Filter.PassFilter(message.Text.data(), message.Text.data() + message.Text.size()))
+				continue;
+
+			m_VisibleMessages.push_back(i);
+		}
+	}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Hazel/Core/Log.h"
+
+#include <imgui/imgui.h>
+
+#include <vector>
+
+namespace Hazel {
+
+	class ConsolePanel
+	{
+	public:
+		ConsolePanel() = default;
+
+		void OnImGuiRender();
+	private:
+		void UpdateVisibleMessages();
+	private:
+		std::vector<LogMessage> m_Messages;
+		std::vector<uint32_t> m_VisibleMessages;
+		uint64_t m_MessagesVersion = 0;
+
+		int m_MinimumLevel = spdlog::level::trace;
+		ImGuiTextFilter m_Filter;
+		bool m_FilterChanged = true;
+		bool m_AutoScroll = true;
+	};
+
+}
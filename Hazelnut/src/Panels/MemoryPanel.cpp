@@ -0,0 +1,68 @@
+#include "MemoryPanel.h"
+
+#include <imgui/imgui.h>
+
+#include "Hazel/Debug/AllocationCounter.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Hazel {
+
+	static void DrawBytes(uint64_t bytes)
+	{
+		if (bytes >= 1024 * 1024)
+			ImGui::Text("%.2f MB", bytes / (1024.0f * 1024.0f));
+		else if (bytes >= 1024)
+			ImGui::Text("%.1f KB", bytes / 1024.0f);
+		else
+			ImGui::Text("%d B", (int)bytes);
+	}
+
+	void MemoryPanel::OnImGuiRender()
+	{
+		ImGui::Begin("Memory");
+
+		ImGui::Text("Heap allocations this frame: %d (%.1f KB)", AllocationCounter::GetFrameAllocations(), AllocationCounter::GetFrameAllocatedBytes() / 1024.0f);
+		ImGui::Text("Heap allocations total: %llu", (unsigned long long)AllocationCounter::GetTotalAllocations());
+		ImGui::Separator();
+
+		if (!MemoryTracker::IsEnabled())
+		{
+			ImGui::TextWrapped("Tagged tracking is off. Define HZ_TRACK_MEMORY=1 for the workspace to see live and peak memory per tag.");
+			ImGui::End();
+			return;
+		}
+
+		// Biggest consumers first
+		std::array<MemoryTracker::TagStats, MemoryTracker::MaxTags> tags;
+		uint32_t tagCount = MemoryTracker::GetTagCount();
+		for (uint32_t i = 0; i < tagCount; i++)
+			tags[i] = MemoryTracker::GetTagStats((MemoryTag)i);
+		std::sort(tags.begin(), tags.begin() + tagCount, [](const auto& a, const auto& b) { return a.LiveBytes > b.LiveBytes; });
+
+		ImGui::Columns(6, "MemoryTags");
+		ImGui::Text("Tag"); ImGui::NextColumn();
+		ImGui::Text("Live"); ImGui::NextColumn();
+		ImGui::Text("Peak"); ImGui::NextColumn();
+		ImGui::Text("Blocks"); ImGui::NextColumn();
+		ImGui::Text("Allocs/frame"); ImGui::NextColumn();
+		ImGui::Text("Bytes/frame"); ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (uint32_t i = 0; i < tagCount; i++)
+		{
+			const auto& tag = tags[i];
+			ImGui::Text("%s", tag.Name); ImGui::NextColumn();
+			DrawBytes(tag.LiveBytes); ImGui::NextColumn();
+			DrawBytes(tag.PeakBytes); ImGui::NextColumn();
+			ImGui::Text("%llu", (unsigned long long)tag.LiveAllocations); ImGui::NextColumn();
+			ImGui::Text("%d", tag.FrameAllocations); ImGui::NextColumn();
+			DrawBytes(tag.FrameAllocatedBytes); ImGui::NextColumn();
+		}
+
+		ImGui::Columns(1);
+		ImGui::End();
+	}
+
+}
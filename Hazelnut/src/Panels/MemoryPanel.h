@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Hazel/Debug/MemoryTracker.h"
+
+namespace Hazel {
+
+	class MemoryPanel
+	{
+	public:
+		MemoryPanel() = default;
+
+		void OnImGuiRender();
+	};
+
+}
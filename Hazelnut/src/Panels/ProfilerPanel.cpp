@@ -0,0 +1,268 @@
+#include "ProfilerPanel.h"
+
+#include <imgui/imgui.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+namespace Hazel {
+
+	static constexpr float BarHeight = 18.0f;
+	static constexpr float StatsInterval = 0.5f;
+
+	static float ToMilliseconds(int64_t nanoseconds)
+	{
+		return nanoseconds * 0.000001f;
+	}
+
+	// Same scope, same color, every frame
+	static ImU32 ScopeColor(std::string_view name)
+	{
+		float hue = (std::hash<std::string_view>()(name) % 360) / 360.0f;
+		float r, g, b;
+		ImGui::ColorConvertHSVtoRGB(hue, 0.45f, 0.75f, r, g, b);
+		return ImGui::ColorConvertFloat4ToU32({ r, g, b, 1.0f });
+	}
+
+	ProfilerPanel::ProfilerPanel()
+	{
+		Instrumentor::Get().SetLiveCaptureEnabled(true);
+	}
+
+	ProfilerPanel::~ProfilerPanel()
+	{
+		Instrumentor::Get().SetLiveCaptureEnabled(false);
+	}
+
+	void ProfilerPanel::OnImGuiRender()
+	{
+		ImGui::Begin("Profiler");
+
+		if (!Instrumentor::Get().IsSessionActive())
+		{
+			ImGui::TextWrapped("No profiling session is running. Build with HZ_PROFILE=1 to see live frames.");
+			ImGui::End();
+			return;
+		}
+
+		// Always drained, a paused panel just throws the new frames away
+		m_IncomingFrames.clear();
+		Instrumentor::Get().ConsumeLiveFrames(m_IncomingFrames);
+		if (!m_Paused)
+		{
+			for (ProfileFrame& frame : m_IncomingFrames)
+				m_Frames.push_back(std::move(frame));
+			while (m_Frames.size() > MaxHistoryFrames)
+				m_Frames.pop_front();
+
+			m_StatsAge += ImGui::GetIO().DeltaTime;
+			if (m_StatsAge >= StatsInterval)
+			{
+				UpdateScopeStats();
+				m_StatsAge = 0.0f;
+			}
+		}
+
+		if (ImGui::Checkbox("Pause", &m_Paused) && !m_Paused)
+			m_SelectedFrame = -1;
+		ImGui::SameLine();
+		ImGui::TextDisabled("Click the history to freeze a frame");
+
+		if (m_Frames.empty())
+		{
+			ImGui::End();
+			return;
+		}
+
+		DrawFrameHistory();
+
+		int selected = m_SelectedFrame < 0 ? (int)m_Frames.size() - 1 : std::min(m_SelectedFrame, (int)m_Frames.size() - 1);
+		const ProfileFrame& frame = m_Frames[selected];
+		ImGui::Text("Frame %llu: %.2f ms, %d scopes", (unsigned long long)frame.Index, ToMilliseconds(frame.Duration), (int)frame.Events.size());
+
+		if (ImGui::CollapsingHeader("Flame Graph", ImGuiTreeNodeFlags_DefaultOpen))
+			DrawFlameGraph(frame);
+		if (ImGui::CollapsingHeader("Scopes", ImGuiTreeNodeFlags_DefaultOpen))
+			DrawScopeTable();
+
+		ImGui::End();
+	}
+
+	void ProfilerPanel::DrawFrameHistory()
+	{
+		float maxMilliseconds = 0.0f;
+		for (const ProfileFrame& frame : m_Frames)
+			maxMilliseconds = std::max(maxMilliseconds, ToMilliseconds(frame.Duration));
+
+		auto getter = [](void* data, int index)
+		{
+			return ToMilliseconds((*(std::deque<ProfileFrame>*)data)[index].Duration);
+		};
+
+		char overlay[32];
+		std::snprintf(overlay, sizeof(overlay), "max %.2f ms", maxMilliseconds);
+		ImGui::PlotHistogram("##FrameHistory", getter, &m_Frames, (int)m_Frames.size(), 0, overlay, 0.0f, maxMilliseconds, ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+		// Clicking a bar freezes that frame
+		if (ImGui::IsItemClicked())
+		{
+			float x = ImGui::GetMousePos().x - ImGui::GetItemRectMin().x;
+			float width = ImGui::GetItemRectSize().x;
+			m_SelectedFrame = std::clamp((int)(x / width * m_Frames.size()), 0, (int)m_Frames.size() - 1);
+			m_Paused = true;
+		}
+	}
+
+	void ProfilerPanel::DrawFlameGraph(const ProfileFrame& frame)
+	{
+		// Nesting depth per event, events come sorted by thread, start, longest first
+		m_Depths.resize(frame.Events.size());
+
+		std::vector<std::pair<uint32_t, uint32_t>> threadDepths; // Thread index, max depth
+		for (size_t i = 0; i < frame.Events.size(); i++)
+		{
+			const ProfileEvent& event = frame.Events[i];
+			if (threadDepths.empty() || threadDepths.back().first != event.ThreadIndex)
+			{
+				threadDepths.push_back({ event.ThreadIndex, 0 });
+				m_OpenEnds.clear();
+			}
+
+			while (!m_OpenEnds.empty() && event.Start >= m_OpenEnds.back())
+				m_OpenEnds.pop_back();
+			m_Depths[i] = (uint32_t)m_OpenEnds.size();
+			m_OpenEnds.push_back(event.Start + event.Duration);
+			threadDepths.back().second = std::max(threadDepths.back().second, m_Depths[i]);
+		}
+
+		float height = 0.0f;
+		for (const auto& [threadIndex, maxDepth] : threadDepths)
+			height += ImGui::GetTextLineHeightWithSpacing() + (maxDepth + 1) * BarHeight;
+
+		ImGui::SliderFloat("Zoom", &m_Zoom, 1.0f, 50.0f, "%.1fx");
+
+		ImGui::BeginChild("FlameGraph", ImVec2(0.0f, std::min(height + 20.0f, 400.0f)), true, ImGuiWindowFlags_HorizontalScrollbar);
+
+		float width = ImGui::GetContentRegionAvail().x * m_Zoom;
+		ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImGui::Dummy(ImVec2(width, height));
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		ImVec2 mouse = ImGui::GetMousePos();
+		bool hovered = ImGui::IsWindowHovered();
+		float scale = width / std::max<int64_t>(frame.Duration, 1);
+
+		float laneY = origin.y;
+		size_t eventIndex = 0;
+		for (const auto& [threadIndex, maxDepth] : threadDepths)
+		{
+			char label[32];
+			std::snprintf(label, sizeof(label), "Thread %u", threadIndex);
+			drawList->AddText(ImVec2(ImGui::GetWindowPos().x + 4.0f, laneY), ImGui::GetColorU32(ImGuiCol_TextDisabled), label);
+			laneY += ImGui::GetTextLineHeightWithSpacing();
+
+			for (; eventIndex < frame.Events.size() && frame.Events[eventIndex].ThreadIndex == threadIndex; eventIndex++)
+			{
+				const ProfileEvent& event = frame.Events[eventIndex];
+				float x0 = origin.x + (event.Start - frame.Start) * scale;
+				float x1 = std::min(x0 + event.Duration * scale, origin.x + width);
+				// Sub-pixel scopes would be noise, and there can be a lot of them
+				if (x1 - x0 < 1.0f)
+					continue;
+
+				float y0 = laneY + m_Depths[eventIndex] * BarHeight;
+				ImVec2 min(x0, y0), max(x1, y0 + BarHeight - 1.0f);
+				drawList->AddRectFilled(min, max, ScopeColor(event.Name));
+
+				ImVec4 clip(x0 + 2.0f, y0, x1 - 2.0f, y0 + BarHeight);
+				drawList->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImVec2(x0 + 3.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), event.Name, nullptr, 0.0f, &clip);
+
+				if (hovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y0 + BarHeight)
+					ImGui::SetTooltip("%s\n%.3f ms", event.Name, ToMilliseconds(event.Duration));
+			}
+
+			laneY += (maxDepth + 1) * BarHeight;
+		}
+
+		ImGui::EndChild();
+	}
+
+	void ProfilerPanel::DrawScopeTable()
+	{
+		ImGui::Text("Over the last %d frames", (int)m_Frames.size());
+
+		ImGui::Columns(7, "ProfilerScopes");
+		ImGui::SetColumnWidth(0, 360.0f);
+		ImGui::Text("Scope"); ImGui::NextColumn();
+		ImGui::Text("ms/frame"); ImGui::NextColumn();
+		ImGui::Text("Calls/frame"); ImGui::NextColumn();
+		ImGui::Text("Min"); ImGui::NextColumn();
+		ImGui::Text("Avg"); ImGui::NextColumn();
+		ImGui::Text("Max"); ImGui::NextColumn();
+		ImGui::Text("p99"); ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (const ScopeStats& stats : m_ScopeStats)
+		{
+			ImGui::TextUnformatted(stats.Name.data(), stats.Name.data() + stats.Name.size());
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("%.*s", (int)stats.Name.size(), stats.Name.data());
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.MillisecondsPerFrame); ImGui::NextColumn();
+			ImGui::Text("%.1f", stats.CallsPerFrame); ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.MinMilliseconds); ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.AvgMilliseconds); ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.MaxMilliseconds); ImGui::NextColumn();
+			ImGui::Text("%.3f", stats.P99Milliseconds); ImGui::NextColumn();
+		}
+
+		ImGui::Columns(1);
+	}
+
+	// Recomputed twice a second over the whole history rather than every frame
+	void ProfilerPanel::UpdateScopeStats()
+	{
+		for (auto& [name, samples] : m_ScopeSamples)
+			samples.clear();
+
+		for (const ProfileFrame& frame : m_Frames)
+		{
+			for (const ProfileEvent& event : frame.Events)
+				m_ScopeSamples[event.Name].push_back(ToMilliseconds(event.Duration));
+		}
+
+		m_ScopeStats.clear();
+		float frameCount = (float)std::max<size_t>(m_Frames.size(), 1);
+		for (auto& [name, samples] : m_ScopeSamples)
+		{
+			if (samples.empty())
+				continue;
+
+			ScopeStats stats;
+			stats.Name = name;
+
+			float total = 0.0f;
+			for (float sample : samples)
+				total += sample;
+			stats.CallsPerFrame = samples.size() / frameCount;
+			stats.MillisecondsPerFrame = total / frameCount;
+			stats.AvgMilliseconds = total / samples.size();
+
+			auto p99 = samples.begin() + (size_t)std::ceil(samples.size() * 0.99) - 1;
+			std::nth_element(samples.begin(), p99, samples.end());
+			stats.P99Milliseconds = *p99;
+			stats.MinMilliseconds = *std::min_element(samples.begin(), samples.end());
+			stats.MaxMilliseconds = *std::max_element(samples.begin(), samples.end());
+
+			m_ScopeStats.push_back(stats);
+		}
+
+		std::sort(m_ScopeStats.begin(), m_ScopeStats.end(), [](const ScopeStats& a, const ScopeStats& b)
+		{
+			return a.MillisecondsPerFrame > b.MillisecondsPerFrame;
+		});
+	}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Hazel/Debug/Instrumentor.h"
+
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Hazel {
+
+	class ProfilerPanel
+	{
+	public:
+		ProfilerPanel();
+		~ProfilerPanel();
+
+		void OnImGuiRender();
+	private:
+		// Scope names are literals or interned by the Instrumentor, so the history can hold on to
+		// them after the scene whose task graph named them is gone
+		struct ScopeStats
+		{
+			std::string_view Name;
+			float CallsPerFrame;
+			float MinMilliseconds, AvgMilliseconds, MaxMilliseconds, P99Milliseconds;
+			float MillisecondsPerFrame;
+		};
+
+		void DrawFrameHistory();
+		void DrawFlameGraph(const ProfileFrame& frame);
+		void DrawScopeTable();
+
+		void UpdateScopeStats();
+	private:
+		static constexpr uint32_t MaxHistoryFrames = 300;
+
+		std::deque<ProfileFrame> m_Frames;
+		std::vector<ProfileFrame> m_IncomingFrames;
+		// Index into m_Frames, -1 follows the newest frame
+		int m_SelectedFrame = -1;
+		bool m_Paused = false;
+		float m_Zoom = 1.0f;
+		std::vector<uint32_t> m_Depths;
+		std::vector<int64_t> m_OpenEnds;
+
+		std::vector<ScopeStats> m_ScopeStats;
+		std::unordered_map<std::string_view, std::vector<float>> m_ScopeSamples;
+		float m_StatsAge = 0.0f;
+	};
+
+}
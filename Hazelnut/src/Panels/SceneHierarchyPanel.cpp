@@ -26,17 +26,45 @@ namespace Hazel {
 	{
 		m_Context = context;
 		m_SelectionContext = {};
+		m_ExpandedEntities.clear();
+		m_RowsDirty = true;
 	}
 
 	void SceneHierarchyPanel::OnImGuiRender()
 	{
 		ImGui::Begin("SceneHierarchy");
 
-		m_Context->m_Registry.each([&](auto entityID)
+		ImGui::SetNextItemWidth(-1.0f);
+		if (ImGui::InputTextWithHint("##Search", "Search", m_SearchBuffer, sizeof(m_SearchBuffer)))
+			m_RowsDirty = true;
+
+		UpdateRows();
+
+		ImGui::BeginChild("Entities");
+
+		Entity deletedEntity;
+		ImGuiListClipper clipper;
+		clipper.Begin((int)m_Rows.size());
+		while (clipper.Step())
 		{
-			Entity entity{ entityID, m_Context.get() };
-			DrawEntityNode(entity);
-		});
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				if (DrawEntityNode(m_Rows[i]))
+					deletedEntity = { m_Rows[i].Entity, m_Context.get() };
+			}
+		}
+		clipper.End();
+
+		// After the loop, destroying rebuilds the rows
+		if (deletedEntity)
+		{
+			if (m_SelectionContext == deletedEntity)
+				m_SelectionContext = {};
+			if (m_History)
+				m_History->DestroyEntity(deletedEntity);
+			else
+				m_Context->DestroyEntity(deletedEntity);
+		}
 
 		if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
 			m_SelectionContext = {};
@@ -45,11 +73,26 @@ namespace Hazel {
 		if (ImGui::BeginPopupContextWindow(0, 1, false))
 		{
 			if (ImGui::MenuItem("Create Empty Entity"))
-				m_Context->CreateEntity("Empty Entity");
+			{
+				if (m_History)
+					m_History->CreateEntity("Empty Entity");
+				else
+					m_Context->CreateEntity("Empty Entity");
+			}
 
 			ImGui::EndPopup();
 		}
 
+		ImGui::EndChild();
+
+		// Dropping a node on blank space makes it a root again
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+				Reparent(*(const entt::entity*)payload->Data, {});
+			ImGui::EndDragDropTarget();
+		}
+
 		ImGui::End();
 
 		ImGui::Begin("Propeties");
@@ -67,17 +110,124 @@ namespace Hazel {
 		m_SelectionContext = entity;
 	}
 
-	void SceneHierarchyPanel::DrawEntityNode(Entity entity)
+	void SceneHierarchyPanel::UpdateRows()
+	{
+		bool searching = m_SearchBuffer[0] != '\0';
+		const TagIndex& tagIndex = m_Context->GetTagIndex();
+		if (m_RowsHierarchyVersion != m_Context->GetHierarchyVersion())
+			m_RowsDirty = true;
+		// Renames only move rows around in search results
+		if (searching && m_RowsTagIndexVersion != tagIndex.GetVersion())
+			m_RowsDirty = true;
+		if (!m_RowsDirty)
+			return;
+
+		HZ_PROFILE_FUNCTION();
+
+		m_Rows.clear();
+		if (searching)
+		{
+			// Matches are listed flat, in tag order
+			tagIndex.FindPrefix(m_SearchBuffer, m_SearchResults);
+			m_Rows.reserve(m_SearchResults.size());
+			for (entt::entity entity : m_SearchResults)
+				m_Rows.push_back({ entity, 0, false });
+		}
+		else
+		{
+			// Roots in registry order, children under their expanded parents
+			auto& registry = m_Context->m_Registry;
+			registry.each([&](auto entity)
+			{
+				if (registry.get<RelationshipComponent>(entity).Parent == entt::null)
+					AddRows(entity, 0);
+			});
+		}
+
+		m_RowsHierarchyVersion = m_Context->GetHierarchyVersion();
+		m_RowsTagIndexVersion = tagIndex.GetVersion();
+		m_RowsDirty = false;
+	}
+
+	void SceneHierarchyPanel::AddRows(entt::entity entity, uint32_t depth)
 	{
+		auto& registry = m_Context->m_Registry;
+		const auto& relationship = registry.get<RelationshipComponent>(entity);
+		m_Rows.push_back({ entity, depth, relationship.FirstChild != entt::null });
+
+		if (m_ExpandedEntities.find(entity) == m_ExpandedEntities.end())
+			return;
+
+		for (entt::entity child = relationship.FirstChild; child != entt::null; child = registry.get<RelationshipComponent>(child).NextSibling)
+			AddRows(child, depth + 1);
+	}
+
+	void SceneHierarchyPanel::Reparent(entt::entity child, Entity parent)
+	{
+		// The dragged node may have been deleted meanwhile
+		auto& registry = m_Context->m_Registry;
+		if (!registry.valid(child))
+			return;
+
+		// Nodes can't go under themselves or their own descendants
+		for (entt::entity it = parent; it != entt::null; it = registry.get<RelationshipComponent>(it).Parent)
+		{
+			if (it == child)
+				return;
+		}
+
+		// The dragged node is the selection, the history picks the change up from there
+		m_Context->SetParent({ child, m_Context.get() }, parent);
+		if (parent)
+			m_ExpandedEntities.insert(parent);
+		m_RowsDirty = true;
+	}
+
+	bool SceneHierarchyPanel::DrawEntityNode(const Row& row)
+	{
+		Entity entity{ row.Entity, m_Context.get() };
 		auto& tag = entity.GetComponent<TagComponent>().Tag;
 
 		ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
-		flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+		flags |= ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+		if (!row.HasChildren)
+			flags |= ImGuiTreeNodeFlags_Leaf;
+
+		// Rows are flat, the tree is only indentation
+		float indent = row.Depth * ImGui::GetStyle().IndentSpacing;
+		if (indent > 0.0f)
+			ImGui::Indent(indent);
+
+		bool expanded = m_ExpandedEntities.find(row.Entity) != m_ExpandedEntities.end();
+		ImGui::SetNextItemOpen(expanded);
 		bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
+		if (opened != expanded && row.HasChildren)
+		{
+			if (opened)
+				m_ExpandedEntities.insert(row.Entity);
+			else
+				m_ExpandedEntities.erase(row.Entity);
+			m_RowsDirty = true;
+		}
 
 		if (ImGui::IsItemClicked())
 			m_SelectionContext = entity;
 
+		// Dragging a node onto another makes it that node's child
+		if (ImGui::BeginDragDropSource())
+		{
+			entt::entity handle = entity;
+			ImGui::SetDragDropPayload("SCENE_HIERARCHY_ENTITY", &handle, sizeof(entt::entity));
+			ImGui::Text("%s", tag.c_str());
+			ImGui::EndDragDropSource();
+		}
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+				Reparent(*(const entt::entity*)payload->Data, entity);
+			ImGui::EndDragDropTarget();
+		}
+
 		bool entityDeleted = false;
 		if (ImGui::BeginPopupContextItem())
 		{
@@ -87,21 +237,10 @@ namespace Hazel {
 			ImGui::EndPopup();
 		}
 
-		if (opened)
-		{
-			ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-			bool opened = ImGui::TreeNodeEx((void*)9817239, flags, tag.c_str());
-			if (opened)
-				ImGui::TreePop();
-			ImGui::TreePop();
-		}
+		if (indent > 0.0f)
+			ImGui::Unindent(indent);
 
-		if (entityDeleted)
-		{
-			m_Context->DestroyEntity(entity);
-			if (m_SelectionContext == entity)
-				m_SelectionContext = {};
-		}
+		return entityDeleted;
 	}
 
 	static void DrawVec3Control(const std::string& label, glm::vec3& values, float resetValue = 0.0f, float columnWidth = 100.0f)
@@ -226,7 +365,7 @@ namespace Hazel {
 			memset(buffer, 0, sizeof(buffer));
 			std::strncpy(buffer, tag.c_str(), sizeof(buffer));
 			if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
-				tag = std::string(buffer);
+				m_Context->SetTag(entity, buffer);
 		}
 
 		ImGui::SameLine();
@@ -4,6 +4,10 @@
 #include "Hazel/Core/Log.h"
 #include "Hazel/Scene/Scene.h"
 #include "Hazel/Scene/Entity.h"
+#include "Hazel/Scene/SceneHistory.h"
+
+#include <unordered_set>
+#include <vector>
 
 namespace Hazel {
 
@@ -14,17 +18,47 @@ namespace Hazel {
 		SceneHierarchyPanel(const Ref<Scene>& context);
 
 		void SetContext(const Ref<Scene>& context);
+		// Entities created and deleted from the panel go through the history when there is one
+		void SetHistory(SceneHistory* history) { m_History = history; }
 
 		void OnImGuiRender();
 
 		Entity GetSelectedEntity() const { return m_SelectionContext; }
 		void SetSelectedEntity(Entity entity);
 	private:
-		void DrawEntityNode(Entity entity);
+		// One line of the hierarchy, in display order
+		struct Row
+		{
+			entt::entity Entity;
+			uint32_t Depth;
+			bool HasChildren;
+		};
+
+		void UpdateRows();
+		void AddRows(entt::entity entity, uint32_t depth);
+
+		// A null parent makes the child a root. Drops that would make a cycle are ignored.
+		void Reparent(entt::entity child, Entity parent);
+
+		// Returns true when the entity was deleted
+		bool DrawEntityNode(const Row& row);
 		void DrawComponents(Entity entity);
 	private:
 		Ref<Scene> m_Context;
 		Entity m_SelectionContext;
+		SceneHistory* m_History = nullptr;
+
+		// Only the rows in view are drawn; the list itself is rebuilt when the scene's
+		// hierarchy, the expanded nodes or the search change
+		std::vector<Row> m_Rows;
+		std::unordered_set<entt::entity> m_ExpandedEntities;
+		uint64_t m_RowsHierarchyVersion = 0;
+		uint64_t m_RowsTagIndexVersion = 0;
+		bool m_RowsDirty = true;
+
+		// Searches go through the scene's tag index
+		char m_SearchBuffer[256] = {};
+		std::vector<entt::entity> m_SearchResults;
 	};
 
 }
\ No newline at end of file
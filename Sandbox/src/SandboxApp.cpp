@@ -155,7 +155,8 @@ private:
 class Sandbox : public Hazel::Application
 {
 public:
-	Sandbox()
+	Sandbox(const Hazel::ApplicationSpecification& specification)
+		: Hazel::Application(specification)
 	{
 		//PushLayer(new ExampleLayer());
 		PushLayer(new Sandbox2D());
@@ -168,7 +169,9 @@ public:
 
 };
 
-Hazel::Application* Hazel::CreateApplication()
+Hazel::Application* Hazel::CreateApplication(Hazel::ApplicationCommandLineArgs args)
 {
-	return new Sandbox();
+	Hazel::ApplicationSpecification specification;
+	specification.CommandLineArgs = args;
+	return new Sandbox(specification);
 }
\ No newline at end of file
@@ -44,4 +44,5 @@ group ""
 
 include "Hazel"
 include "Sandbox"
-include "Hazelnut"
\ No newline at end of file
+include "Hazelnut"
+include "HazelBench"
\ No newline at end of file